@@ -29,9 +29,7 @@
 
 #include "qknx2bytefloat.h"
 #include "qknxdatapointtype_p.h"
-
-#include "qknxutils.h"
-#include "qmath.h"
+#include "qknxdatapointtypecodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -183,16 +181,9 @@ QKnx2ByteFloat::QKnx2ByteFloat(int subType, float value)
 */
 float QKnx2ByteFloat::value() const
 {
-    quint16 temp = QKnxUtils::QUint16::fromBytes(bytes());
-    quint16 encodedM = (temp & 0x87ff);
-    // Turning on bits reserved for E.
-    // Only needed for reinterpretation of negative values
-    if (encodedM > 2047)
-        encodedM += 0x7800;
-
-    qint16 M = qint16(encodedM);
-    quint8 E = (temp & 0x7800) >> 11;
-    return float(0.01 * (M) * qPow(2, qreal(E)));
+    float value;
+    QKnxDatapointTypeCodec::Dpt9::decode(constData(), 1, &value);
+    return value;
 }
 
 /*!
@@ -206,18 +197,10 @@ bool QKnx2ByteFloat::setValue(float value)
     if (value < minimum().toFloat() || value > maximum().toFloat())
         return false;
 
-    quint8 E = 0;
-    if (qAbs(qreal(value)) > 20.48)
-        E = quint8(qFloor(qLn(qAbs(qreal(value) * 100 / 2048.)) / qLn(2) + 1));
-    qint32 M = qint32(qRound((value*float(qPow(2, -E)) * 100)));
-    if (E > 15 || M > 2047 || M < -2048)
+    quint8 raw[TypeSize];
+    if (!QKnxDatapointTypeCodec::Dpt9::encode(&value, 1, raw))
         return false; // Should never happen considering the ranges of value.
-
-    quint16 encodedM = quint16(M);
-    if (value < 0)
-        encodedM &= 0x87ff;
-    encodedM |= E << 11;
-    setBytes(QKnxUtils::QUint16::bytes(encodedM), 0, 2);
+    std::copy_n(raw, TypeSize, data());
     return true;
 }
 
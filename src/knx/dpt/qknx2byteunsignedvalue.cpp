@@ -29,7 +29,7 @@
 
 #include "qknx2byteunsignedvalue.h"
 #include "qknxdatapointtype_p.h"
-#include "qknxutils.h"
+#include "qknxdatapointtypecodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -100,7 +100,9 @@ QKnx2ByteUnsignedValue::QKnx2ByteUnsignedValue(int subType, quint32 value)
 */
 quint32 QKnx2ByteUnsignedValue::value() const
 {
-    return quint32(QKnxUtils::QUint16::fromBytes(bytes()) * coefficient());
+    quint16 value;
+    QKnxDatapointTypeCodec::Dpt7::decode(constData(), 1, &value);
+    return quint32(value * coefficient());
 }
 
 /*!
@@ -108,8 +110,11 @@ quint32 QKnx2ByteUnsignedValue::value() const
 */
 bool QKnx2ByteUnsignedValue::setValue(quint32 value)
 {
-    if (value <= maximum().toUInt() && value >= minimum().toUInt())
-        return setBytes(QKnxUtils::QUint16::bytes(quint16(qRound(value / coefficient()))), 0, 2);
+    if (value <= maximum().toUInt() && value >= minimum().toUInt()) {
+        const auto raw = quint16(qRound(value / coefficient()));
+        QKnxDatapointTypeCodec::Dpt7::encode(&raw, 1, data());
+        return true;
+    }
     return false;
 }
 
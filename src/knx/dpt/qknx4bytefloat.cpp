@@ -29,8 +29,7 @@
 
 #include "qknx4bytefloat.h"
 #include "qknxdatapointtype_p.h"
-
-#include "qknxutils.h"
+#include "qknxdatapointtypecodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -170,9 +169,8 @@ QKnx4ByteFloat::QKnx4ByteFloat(int subType, float value)
 */
 float QKnx4ByteFloat::value() const
 {
-    quint32 temp = QKnxUtils::QUint32::fromBytes(bytes());
-    float value = 0;
-    memcpy(&value, &temp, sizeof(value));
+    float value;
+    QKnxDatapointTypeCodec::Dpt14::decode(constData(), 1, &value);
     return value;
 }
 
@@ -184,9 +182,7 @@ float QKnx4ByteFloat::value() const
 */
 void QKnx4ByteFloat::setValue(float value)
 {
-    quint32 tmp;
-    memcpy(&tmp, &value, sizeof(value));
-    setBytes(QKnxUtils::QUint32::bytes(tmp),0,4);
+    QKnxDatapointTypeCodec::Dpt14::encode(&value, 1, data());
 }
 
 /*!
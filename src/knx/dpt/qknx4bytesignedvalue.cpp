@@ -29,8 +29,7 @@
 
 #include "qknx4bytesignedvalue.h"
 #include "qknxdatapointtype_p.h"
-
-#include "qknxutils.h"
+#include "qknxdatapointtypecodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -98,7 +97,9 @@ QKnx4ByteSignedValue::QKnx4ByteSignedValue(int subType, qint32 value)
 */
 qint32 QKnx4ByteSignedValue::value() const
 {
-    return qint32(QKnxUtils::QUint32::fromBytes(bytes()));
+    qint32 value;
+    QKnxDatapointTypeCodec::Dpt13::decode(constData(), 1, &value);
+    return value;
 }
 
 /*!
@@ -109,8 +110,10 @@ qint32 QKnx4ByteSignedValue::value() const
 */
 bool QKnx4ByteSignedValue::setValue(qint32 value)
 {
-    if (value <= maximum().toInt() && value >= minimum().toInt())
-        return setBytes(QKnxUtils::QUint32::bytes(quint32(value)), 0, 4);
+    if (value <= maximum().toInt() && value >= minimum().toInt()) {
+        QKnxDatapointTypeCodec::Dpt13::encode(&value, 1, data());
+        return true;
+    }
     return false;
 }
 
@@ -29,8 +29,7 @@
 
 #include "qknx4byteunsignedvalue.h"
 #include "qknxdatapointtype_p.h"
-
-#include "qknxutils.h"
+#include "qknxdatapointtypecodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -111,7 +110,9 @@ QKnxValue4UCount::QKnxValue4UCount(quint32 value)
 */
 quint32 QKnx4ByteUnsignedValue::value() const
 {
-    return QKnxUtils::QUint32::fromBytes(bytes());
+    quint32 value;
+    QKnxDatapointTypeCodec::Dpt12::decode(constData(), 1, &value);
+    return value;
 }
 
 /*!
@@ -122,8 +123,10 @@ quint32 QKnx4ByteUnsignedValue::value() const
 */
 bool QKnx4ByteUnsignedValue::setValue(quint32 value)
 {
-    if (value <= maximum().toUInt() && value >= minimum().toUInt())
-        return setBytes(QKnxUtils::QUint32::bytes(value), 0, 4);
+    if (value <= maximum().toUInt() && value >= minimum().toUInt()) {
+        QKnxDatapointTypeCodec::Dpt12::encode(&value, 1, data());
+        return true;
+    }
     return false;
 }
 
@@ -29,6 +29,7 @@
 
 #include "qknx8bitunsignedvalue.h"
 #include "qknxdatapointtype_p.h"
+#include "qknxdatapointtypecodec.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -94,7 +95,10 @@ double QKnx8BitUnsignedValue::value() const
 {
     if (!isValid())
         return -1;
-    return byte(0) * coefficient();
+
+    double value;
+    QKnxDatapointTypeCodec::Dpt5::decode(constData(), 1, &value, coefficient());
+    return value;
 }
 
 /*!
@@ -105,8 +109,10 @@ double QKnx8BitUnsignedValue::value() const
 */
 bool QKnx8BitUnsignedValue::setValue(double value)
 {
-    if (value <= maximum().toDouble() && value >= minimum().toDouble())
-        return setByte(0, quint8(qRound(value / coefficient())));
+    if (value <= maximum().toDouble() && value >= minimum().toDouble()) {
+        QKnxDatapointTypeCodec::Dpt5::encode(&value, 1, data(), coefficient());
+        return true;
+    }
     return false;
 }
 
@@ -455,20 +455,13 @@ QKnxDatapointType::~QKnxDatapointType()
 QKnxDatapointType::QKnxDatapointType(Type type, int size)
     : d_ptr(new QKnxDatapointTypePrivate)
 {
-    auto number = QString::number(int(type));
-    if (number.size() < 6)
-        return;
-
-    bool okMain = false, okSub = false;
-
     // Datapoint Type shall be identified by a 16 bit main number separated
     // by a dot from a 16 bit sub number. The assumption being made is that
     // QKnxDatapointType::Type is encoded in that way while omitting the dot.
-    int mainType = number.left(number.size() - 5).toInt(&okMain);
-    int subType = number.right(5).toInt(&okSub);
-
-    if (okMain && okSub)
-        d_ptr->setup(mainType, subType, quint32(type), size);
+    const int number = int(type);
+    if (number < 100000)
+        return;
+    d_ptr->setup(quint16(number / 100000), quint16(number % 100000), quint32(type), size);
 }
 
 /*!
@@ -477,20 +470,11 @@ QKnxDatapointType::QKnxDatapointType(Type type, int size)
 QKnxDatapointType::QKnxDatapointType(const QString &dptId, int size)
     : d_ptr(new QKnxDatapointTypePrivate)
 {
-    auto match = d_ptr->m_dpt.match(dptId);
-    if (!match.hasMatch())
-        return;
-
-    QString subType = QStringLiteral("0");
-    auto mainType = match.captured(QStringLiteral("MainOnly"));
-    if (mainType.isEmpty()) {
-        subType = match.captured(QStringLiteral("SubType"));
-        mainType = match.captured(QStringLiteral("MainType"));
+    quint32 mainType, subType, tmp;
+    if (QKnxDatapointTypePrivate::parse(dptId, &mainType, &subType)
+        && QKnxDatapointTypePrivate::toType(mainType, subType, &tmp)) {
+        d_ptr->setup(quint16(mainType), quint16(subType), tmp, size);
     }
-
-    quint32 tmp;
-    if (QKnxDatapointTypePrivate::toType(mainType, subType, &tmp))
-        d_ptr->setup(mainType.toUInt(), subType.toUInt(), tmp, size);
 }
 
 /*!
@@ -816,27 +800,58 @@ bool QKnxDatapointType::operator!=(const QKnxDatapointType &other) const
 */
 QKnxDatapointType::Type QKnxDatapointType::toType(const QString & dpt)
 {
-    QKnxDatapointTypePrivate dtp;
-    auto match = dtp.m_dpt.match(dpt);
-    if (!match.hasMatch())
-        return QKnxDatapointType::Type::Unknown;
-
-    QString subType = QStringLiteral("0");
-    auto mainType = match.captured(QStringLiteral("MainOnly"));
-    if (mainType.isEmpty()) {
-        subType = match.captured(QStringLiteral("SubType"));
-        mainType = match.captured(QStringLiteral("MainType"));
-    }
-
-    quint32 type;
-    if (dtp.toType(mainType, subType, &type))
+    quint32 mainType, subType, type;
+    if (QKnxDatapointTypePrivate::parse(dpt, &mainType, &subType)
+        && QKnxDatapointTypePrivate::toType(mainType, subType, &type)) {
         return static_cast<Type> (type);
+    }
     return QKnxDatapointType::Type::Unknown;
 }
 
 
 // -- private
 
+/*!
+    \internal
+
+    Parses a datapoint type identifier of the form \c DPT-main, \c DPST-main-sub
+    or \c main.sub (also \c main-sub) into \a main and \a sub. Main and sub
+    number consist of one to five digits, the prefixes are case insensitive.
+    Returns \c false if \a dpt does not match any of the forms.
+*/
+bool QKnxDatapointTypePrivate::parse(QStringView dpt, quint32 *main, quint32 *sub)
+{
+    int pos = 0;
+    const auto number = [&dpt, &pos](quint32 *value) {
+        const int start = pos;
+        *value = 0;
+        for (; pos < dpt.size() && pos - start < 5; ++pos) {
+            const ushort c = dpt.at(pos).unicode();
+            if (c < '0' || c > '9')
+                break;
+            *value = *value * 10 + (c - '0');
+        }
+        // at least one digit, and no sixth one
+        return pos > start && (pos == dpt.size() || !dpt.at(pos).isDigit());
+    };
+
+    if (dpt.startsWith(QLatin1String("DPT-"), Qt::CaseInsensitive)) {
+        pos = 4;
+        *sub = 0;
+        return number(main) && pos == dpt.size();
+    }
+
+    if (dpt.startsWith(QLatin1String("DPST-"), Qt::CaseInsensitive))
+        pos = 5;
+    if (!number(main) || pos == dpt.size())
+        return false;
+
+    const QChar separator = dpt.at(pos++);
+    if (separator != QLatin1Char('.') && separator != QLatin1Char('-'))
+        return false;
+    return number(sub) && pos == dpt.size();
+}
+
 /*!
     \internal
 */
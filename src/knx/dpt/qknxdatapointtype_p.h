@@ -41,12 +41,14 @@
 // We mean it.
 //
 
-#include <QtCore/qregularexpression.h>
 #include <QtCore/qshareddata.h>
+#include <QtCore/qstringview.h>
 #include <QtCore/qvariant.h>
 #include <QtCore/qvector.h>
 #include <QtKnx/qknxglobal.h>
 
+#include <limits>
+
 QT_BEGIN_NAMESPACE
 
 struct Q_KNX_EXPORT QKnxDatapointTypePrivate : public QSharedData
@@ -62,22 +64,16 @@ struct Q_KNX_EXPORT QKnxDatapointTypePrivate : public QSharedData
     QVariant m_minimum, m_maximum;
     double m_coefficient { 1 };
     QString m_minimumText, m_maximumText;
-    const QRegularExpression m_dpt { QStringLiteral("^DPT-(?<MainOnly>\\d{1,5})$"
-        "|^(DPST-)?(?<MainType>\\d{1,5})(\\.|-)(?<SubType>\\d{1,5})$"),
-            QRegularExpression::CaseInsensitiveOption };
-
-    static bool toType(quint16 main, quint16 sub, quint32 *type) {
-        return toType(QString::number(main), QString::number(sub), type);
-    }
-    static bool toType(const QString &main, const QString &sub, quint32 *type) {
-        bool ok = true;
-        if (main.isEmpty() || sub.isEmpty())
-            return !ok;
 
-        *type = QString(main.rightJustified(5, QLatin1Char('0')) + sub
-            .rightJustified(5, QLatin1Char('0'))).toUInt(&ok);
-        return ok;
+    // QKnxDatapointType::Type is encoded as the main number followed by the five digit sub number.
+    static bool toType(quint32 main, quint32 sub, quint32 *type) {
+        const quint64 tmp = quint64(main) * 100000 + sub;
+        if (sub > 99999 || tmp > std::numeric_limits<quint32>::max())
+            return false;
+        *type = quint32(tmp);
+        return true;
     }
+    static bool parse(QStringView dpt, quint32 *main, quint32 *sub);
     void setup(quint16 mainType, quint16 subType, quint32 type, int size)
     {
         m_subType = subType;
@@ -0,0 +1,355 @@
+/******************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxdatapointtypecodec.h"
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qendian.h>
+#include <QtCore/private/qsimd_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QKnxDatapointTypeCodec
+
+    \inmodule QtKnx
+    \brief The QKnxDatapointTypeCodec class decodes and encodes arrays of
+    datapoint type values.
+
+    The datapoint type classes, such as \l QKnx2ByteFloat, hold a single value
+    each. QKnxDatapointTypeCodec converts between the KNX wire format and plain
+    values for whole contiguous buffers instead, for example to decode archived
+    telegrams in bulk. It holds no state and does not allocate. The scalar
+    datapoint type classes use it to encode and decode their own value.
+
+    For every supported main type, a nested class provides a \c decode and an
+    \c encode function. \c decode reads \c count values from the wire format
+    bytes \c raw, laid out back to back, and writes them to \c values; \c encode
+    does the reverse. The buffers must not overlap. Unlike the datapoint type
+    classes, the codec does not check the values against the range of a specific
+    sub type.
+
+    \list
+        \li \c Dpt5 handles 8-bit unsigned values, scaled by a coefficient.
+        \li \c Dpt7 handles 2-byte unsigned values.
+        \li \c Dpt9 handles 2-byte float values.
+        \li \c Dpt12 handles 4-byte unsigned values.
+        \li \c Dpt13 handles 4-byte signed values.
+        \li \c Dpt14 handles 4-byte float values.
+    \endlist
+
+    \code
+        QVector<float> temperatures(telegrams.size() / 2);
+        QKnxDatapointTypeCodec::Dpt9::decode(telegrams.constData(), temperatures.size(),
+            temperatures.data());
+    \endcode
+
+    On x86, the codec uses SSE2 to process several values at once.
+*/
+
+// Both the wire format and the host values are stored back to back, so converting between them
+// is a byte swap of each value on little endian hosts and a copy on big endian hosts.
+static void swap16(const void *source, int count, void *destination)
+{
+    auto src = static_cast<const quint8 *>(source);
+    auto dst = static_cast<quint8 *>(destination);
+
+    int i = 0;
+#if defined(__SSE2__) && Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    for (; i + 8 <= count; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 2));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 2),
+            _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+    }
+#endif
+    for (; i < count; ++i)
+        qToUnaligned(qFromBigEndian<quint16>(src + i * 2), dst + i * 2);
+}
+
+static void swap32(const void *source, int count, void *destination)
+{
+    auto src = static_cast<const quint8 *>(source);
+    auto dst = static_cast<quint8 *>(destination);
+
+    int i = 0;
+#if defined(__SSE2__) && Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 4));
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4), v);
+    }
+#endif
+    for (; i < count; ++i)
+        qToUnaligned(qFromBigEndian<quint32>(src + i * 4), dst + i * 4);
+}
+
+// DPT 9: FloatValue = 0.01 * M * 2^E, with M a 12 bit two's complement mantissa split into the
+// sign bit 15 and bits 0 to 10, and E a 4 bit exponent in bits 11 to 14. See 03_07_02 Datapoint
+// Types Paragraph 3.10. M * 2^E is an integer that fits into a float exactly, so the only rounding
+// happens when dividing by 100.
+static float decodeDpt9(quint16 raw)
+{
+    const qint32 mantissa = qint32(raw & 0x07ff) - ((raw & 0x8000) ? 2048 : 0);
+    const int exponent = (raw >> 11) & 0x0f;
+    return float(double(mantissa * (1 << exponent)) / 100.);
+}
+
+// 2^-E, scaling a double by them is exact
+static const constexpr double Dpt9Scale[16] = {
+    1., 1. / 2, 1. / 4, 1. / 8, 1. / 16, 1. / 32, 1. / 64, 1. / 128, 1. / 256, 1. / 512,
+    1. / 1024, 1. / 2048, 1. / 4096, 1. / 8192, 1. / 16384, 1. / 32768
+};
+
+// Picks the smallest exponent, i.e. the most precise encoding, for which the mantissa rounded to
+// nearest, ties away from zero, fits. Positive and negative values encode symmetrically, except
+// that the most negative mantissa is -2048.
+static bool encodeDpt9(float value, quint16 *raw)
+{
+    const double magnitude = qAbs(double(value) * 100.);
+    if (!(magnitude <= 2048. * 32768.)) // out of range, infinite or not a number
+        return false;
+
+    const quint32 limit = (value < 0) ? 2048 : 2047;
+    const auto rounded = quint32(magnitude + .5);
+
+    // the mantissa needs at least bit length - 12 bits of exponent, no fewer
+    int E = (rounded > limit) ? qMax(0, 20 - int(qCountLeadingZeroBits(rounded))) : 0;
+    for (; E < 16; ++E) {
+        const auto M = quint32(magnitude * Dpt9Scale[E] + .5);
+        if (M > limit)
+            continue;
+
+        quint16 encoded = quint16(E << 11);
+        if (value < 0 && M > 0)
+            encoded |= 0x8000 | quint16((0x0800 - M) & 0x07ff);
+        else
+            encoded |= quint16(M);
+        *raw = encoded;
+        return true;
+    }
+    return false;
+}
+
+/*!
+    \class QKnxDatapointTypeCodec::Dpt5
+    \inmodule QtKnx
+    \brief Decodes and encodes arrays of 8-bit unsigned values.
+*/
+
+/*!
+    Decodes \a count bytes from \a raw into \a values, multiplying each of them
+    by \a coefficient.
+*/
+void QKnxDatapointTypeCodec::Dpt5::decode(const quint8 *raw, int count, double *values,
+    double coefficient)
+{
+    int i = 0;
+#ifdef __SSE2__
+    const __m128i zero = _mm_setzero_si128();
+    const __m128d factor = _mm_set1_pd(coefficient);
+    for (; i + 4 <= count; i += 4) {
+        const __m128i v = _mm_unpacklo_epi16(_mm_unpacklo_epi8(
+            _mm_cvtsi32_si128(qFromUnaligned<int>(raw + i)), zero), zero);
+        _mm_storeu_pd(values + i, _mm_mul_pd(_mm_cvtepi32_pd(v), factor));
+        _mm_storeu_pd(values + i + 2, _mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(v, 8)), factor));
+    }
+#endif
+    for (; i < count; ++i)
+        values[i] = raw[i] * coefficient;
+}
+
+/*!
+    Encodes \a count \a values divided by \a coefficient into \a raw. Results
+    outside the range \c 0 to \c 255 are clamped to the nearest bound.
+*/
+void QKnxDatapointTypeCodec::Dpt5::encode(const double *values, int count, quint8 *raw,
+    double coefficient)
+{
+    for (int i = 0; i < count; ++i)
+        raw[i] = quint8(qRound(qBound(0., values[i] / coefficient, 255.)));
+}
+
+/*!
+    \class QKnxDatapointTypeCodec::Dpt7
+    \inmodule QtKnx
+    \brief Decodes and encodes arrays of 2-byte unsigned values.
+*/
+
+/*!
+    Decodes \a count values from \a raw into \a values.
+*/
+void QKnxDatapointTypeCodec::Dpt7::decode(const quint8 *raw, int count, quint16 *values)
+{
+    swap16(raw, count, values);
+}
+
+/*!
+    Encodes \a count \a values into \a raw.
+*/
+void QKnxDatapointTypeCodec::Dpt7::encode(const quint16 *values, int count, quint8 *raw)
+{
+    swap16(values, count, raw);
+}
+
+/*!
+    \class QKnxDatapointTypeCodec::Dpt9
+    \inmodule QtKnx
+    \brief Decodes and encodes arrays of 2-byte float values.
+*/
+
+/*!
+    \variable QKnxDatapointTypeCodec::Dpt9::InvalidData
+
+    The encoded value 0x7fff that is written for values that cannot be
+    represented.
+*/
+
+/*!
+    Decodes \a count values from \a raw into \a values.
+*/
+void QKnxDatapointTypeCodec::Dpt9::decode(const quint8 *raw, int count, float *values)
+{
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mantissaMask = _mm_set1_epi32(0x07ff);
+    const __m128i exponentMask = _mm_set1_epi32(0x0f);
+    const __m128i bias = _mm_set1_epi32(127);
+    const __m128d hundred = _mm_set1_pd(100.);
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(raw + i * 2));
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        v = _mm_unpacklo_epi16(v, zero);
+
+        const __m128i mantissa = _mm_sub_epi32(_mm_and_si128(v, mantissaMask),
+            _mm_slli_epi32(_mm_srli_epi32(v, 15), 11));
+        // 2^E built directly from the float exponent bits
+        const __m128 power = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(
+            _mm_and_si128(_mm_srli_epi32(v, 11), exponentMask), bias), 23));
+        const __m128 product = _mm_mul_ps(_mm_cvtepi32_ps(mantissa), power);
+
+        const __m128 low = _mm_cvtpd_ps(_mm_div_pd(_mm_cvtps_pd(product), hundred));
+        const __m128 high = _mm_cvtpd_ps(_mm_div_pd(_mm_cvtps_pd(_mm_movehl_ps(product,
+            product)), hundred));
+        _mm_storeu_ps(values + i, _mm_movelh_ps(low, high));
+    }
+#endif
+    for (; i < count; ++i)
+        values[i] = decodeDpt9(qFromBigEndian<quint16>(raw + i * 2));
+}
+
+/*!
+    Encodes \a count \a values into \a raw. Returns \c true if all values could
+    be encoded; otherwise returns \c false. Values that cannot be represented,
+    either because they are out of range or not a number, are encoded as
+    \l InvalidData.
+*/
+bool QKnxDatapointTypeCodec::Dpt9::encode(const float *values, int count, quint8 *raw)
+{
+    bool ok = true;
+    for (int i = 0; i < count; ++i) {
+        quint16 encoded;
+        if (!encodeDpt9(values[i], &encoded)) {
+            encoded = InvalidData;
+            ok = false;
+        }
+        qToBigEndian(encoded, raw + i * 2);
+    }
+    return ok;
+}
+
+/*!
+    \class QKnxDatapointTypeCodec::Dpt12
+    \inmodule QtKnx
+    \brief Decodes and encodes arrays of 4-byte unsigned values.
+*/
+
+/*!
+    Decodes \a count values from \a raw into \a values.
+*/
+void QKnxDatapointTypeCodec::Dpt12::decode(const quint8 *raw, int count, quint32 *values)
+{
+    swap32(raw, count, values);
+}
+
+/*!
+    Encodes \a count \a values into \a raw.
+*/
+void QKnxDatapointTypeCodec::Dpt12::encode(const quint32 *values, int count, quint8 *raw)
+{
+    swap32(values, count, raw);
+}
+
+/*!
+    \class QKnxDatapointTypeCodec::Dpt13
+    \inmodule QtKnx
+    \brief Decodes and encodes arrays of 4-byte signed values.
+*/
+
+/*!
+    Decodes \a count values from \a raw into \a values.
+*/
+void QKnxDatapointTypeCodec::Dpt13::decode(const quint8 *raw, int count, qint32 *values)
+{
+    swap32(raw, count, values);
+}
+
+/*!
+    Encodes \a count \a values into \a raw.
+*/
+void QKnxDatapointTypeCodec::Dpt13::encode(const qint32 *values, int count, quint8 *raw)
+{
+    swap32(values, count, raw);
+}
+
+/*!
+    \class QKnxDatapointTypeCodec::Dpt14
+    \inmodule QtKnx
+    \brief Decodes and encodes arrays of 4-byte float values.
+*/
+
+/*!
+    Decodes \a count values from \a raw into \a values.
+*/
+void QKnxDatapointTypeCodec::Dpt14::decode(const quint8 *raw, int count, float *values)
+{
+    swap32(raw, count, values);
+}
+
+/*!
+    Encodes \a count \a values into \a raw.
+*/
+void QKnxDatapointTypeCodec::Dpt14::encode(const float *values, int count, quint8 *raw)
+{
+    swap32(values, count, raw);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,80 @@
+/******************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXDATAPOINTTYPECODEC_H
+#define QKNXDATAPOINTTYPECODEC_H
+
+#include <QtKnx/qknxglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+struct Q_KNX_EXPORT QKnxDatapointTypeCodec final
+{
+    struct Q_KNX_EXPORT Dpt5 final
+    {
+        static void decode(const quint8 *raw, int count, double *values, double coefficient = 1.);
+        static void encode(const double *values, int count, quint8 *raw, double coefficient = 1.);
+    };
+
+    struct Q_KNX_EXPORT Dpt7 final
+    {
+        static void decode(const quint8 *raw, int count, quint16 *values);
+        static void encode(const quint16 *values, int count, quint8 *raw);
+    };
+
+    struct Q_KNX_EXPORT Dpt9 final
+    {
+        static const constexpr int InvalidData = 0x7fff;
+
+        static void decode(const quint8 *raw, int count, float *values);
+        static bool encode(const float *values, int count, quint8 *raw);
+    };
+
+    struct Q_KNX_EXPORT Dpt12 final
+    {
+        static void decode(const quint8 *raw, int count, quint32 *values);
+        static void encode(const quint32 *values, int count, quint8 *raw);
+    };
+
+    struct Q_KNX_EXPORT Dpt13 final
+    {
+        static void decode(const quint8 *raw, int count, qint32 *values);
+        static void encode(const qint32 *values, int count, quint8 *raw);
+    };
+
+    struct Q_KNX_EXPORT Dpt14 final
+    {
+        static void decode(const quint8 *raw, int count, float *values);
+        static void encode(const float *values, int count, quint8 *raw);
+    };
+};
+
+QT_END_NAMESPACE
+
+#endif
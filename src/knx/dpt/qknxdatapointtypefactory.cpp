@@ -97,18 +97,8 @@ QT_BEGIN_NAMESPACE
 */
 QKnxDatapointType *QKnxDatapointTypeFactory::createType(int mainType, int subType) const
 {
-    const auto main = factoryTable().constFind(mainType);
-    if (main == factoryTable().constEnd())
-        return nullptr;
-
-    auto sub = (*main).constFind(subType);
-    if (sub == (*main).constEnd())
-        sub = (*main).constFind(0); // try base, e.g. 1.00[0]
-
-    if (sub == (*main).constEnd())
-        return nullptr;
-
-    return (*sub)();
+    const auto e = entry(mainType, subType);
+    return e ? e->create() : nullptr;
 }
 
 /*!
@@ -120,21 +110,38 @@ QKnxDatapointType *QKnxDatapointTypeFactory::createType(int mainType, int subTyp
 */
 QKnxDatapointType *QKnxDatapointTypeFactory::createType(QKnxDatapointType::Type type) const
 {
-    auto number = QString::number(int(type));
-    if (number.size() < 6)
+    // Datapoint Type shall be identified by a 16 bit main number separated by a dot from a 16 bit
+    // sub number. QKnxDatapointType::Type is encoded as main number * 100000 + sub number.
+    const int number = int(type);
+    if (number < 100000)
         return nullptr;
+    return createType(number / 100000, number % 100000);
+}
 
-    bool okMain = false, okSub = false;
+/*!
+    Constructs an instance of a \l QKnxDatapointType subclass depending on
+    the \a type given as an argument to this function in the \a size bytes of
+    memory pointed to by \a storage. Returns the constructed object, or
+    \c nullptr if the type is not registered or \a storage is too small or not
+    suitably aligned for the type. No memory is allocated for the object itself.
 
-    // Datapoint Type shall be identified by a 16 bit main number separated by a dot from a 16 bit
-    // sub number. The assumption being made is that QKnxDatapointType::Type is encoded in that way
-    // while omitting the dot.
-    int mainType = number.left(number.size() - 5).toInt(&okMain);
-    int subType = number.right(5).toInt(&okSub);
-
-    if (okMain && okSub)
-        return createType(mainType, subType);
-    return nullptr;
+    The built-in datapoint types fit into \c sizeof(QKnxDatapointType) bytes
+    aligned for \l QKnxDatapointType.
+
+    \note The object must be destroyed by calling its destructor explicitly
+    before \a storage is released or reused.
+*/
+QKnxDatapointType *QKnxDatapointTypeFactory::createType(QKnxDatapointType::Type type,
+    void *storage, std::size_t size) const
+{
+    const int number = int(type);
+    if (!storage || number < 100000)
+        return nullptr;
+
+    const auto e = entry(number / 100000, number % 100000);
+    if (!e || e->size > size || (quintptr(storage) % e->alignment) != 0)
+        return nullptr;
+    return e->construct(storage);
 }
 
 /*!
@@ -150,7 +157,7 @@ int QKnxDatapointTypeFactory::typeSize(int mainType)
 */
 QList<int> QKnxDatapointTypeFactory::mainTypes() const
 {
-    return factoryTable().keys();
+    return sizeTable().keys();
 }
 
 /*!
@@ -159,7 +166,7 @@ QList<int> QKnxDatapointTypeFactory::mainTypes() const
 */
 bool QKnxDatapointTypeFactory::containsMainType(int mainType) const
 {
-    return factoryTable().contains(mainType);
+    return sizeTable().contains(mainType);
 }
 
 /*!
@@ -167,10 +174,13 @@ bool QKnxDatapointTypeFactory::containsMainType(int mainType) const
 */
 QList<int> QKnxDatapointTypeFactory::subTypes(int mainType) const
 {
-    const auto main = factoryTable().constFind(mainType);
-    if (main != factoryTable().constEnd())
-        return (*main).keys();
-    return {};
+    QList<int> subTypes;
+    const auto &table = factoryTable();
+    for (auto it = table.constBegin(); it != table.constEnd(); ++it) {
+        if (int(it.key() >> 32) == mainType)
+            subTypes.append(int(it.key() & 0xffffffff));
+    }
+    return subTypes;
 }
 
 /*!
@@ -179,10 +189,24 @@ QList<int> QKnxDatapointTypeFactory::subTypes(int mainType) const
 */
 bool QKnxDatapointTypeFactory::containsSubType(int mainType, int subType) const
 {
-    const auto main = factoryTable().constFind(mainType);
-    if (main != factoryTable().constEnd())
-        return (*main).constFind(subType) != (*main).constEnd();
-    return false;
+    return factoryTable().contains(key(mainType, subType));
+}
+
+/*!
+    \internal
+
+    Returns the registered entry for \a mainType and \a subType, or the base
+    entry of \a mainType, e.g. 1.000, if there is no such sub type. Returns
+    \c nullptr if neither is registered.
+*/
+const QKnxDatapointTypeFactory::Entry *QKnxDatapointTypeFactory::entry(int mainType,
+    int subType) const
+{
+    const auto &table = factoryTable();
+    auto it = table.constFind(key(mainType, subType));
+    if (it == table.constEnd() && subType != 0)
+        it = table.constFind(key(mainType, 0)); // try base, e.g. 1.00[0]
+    return it != table.constEnd() ? &it.value() : nullptr;
 }
 
 /*!
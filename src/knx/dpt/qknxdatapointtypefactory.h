@@ -33,6 +33,8 @@
 #include <QtKnx/qknxdatapointtype.h>
 #include <QtKnx/qknxglobal.h>
 
+#include <new>
+
 QT_BEGIN_NAMESPACE
 
 class Q_KNX_EXPORT QKnxDatapointTypeFactory
@@ -53,11 +55,14 @@ public:
             "class because it is not derived from QKnxDatapointType.");
 
         QKnxDatapointTypeFactory::setTypeSize(mainType, size);
-        factoryTable()[mainType].insert(subType, &QKnxDatapointTypeFactory::create<Class>);
+        factoryTable().insert(key(mainType, subType), { &QKnxDatapointTypeFactory::create<Class>,
+            &QKnxDatapointTypeFactory::construct<Class>, sizeof(Class), alignof(Class) });
     }
 
     QKnxDatapointType *createType(int mainType, int subType) const;
     QKnxDatapointType *createType(QKnxDatapointType::Type type) const;
+    QKnxDatapointType *createType(QKnxDatapointType::Type type, void *storage,
+        std::size_t size) const;
 
     static int typeSize(int mainType);
 
@@ -70,16 +75,38 @@ public:
 private:
     QKnxDatapointTypeFactory();
 
+    using PlacementFunction = QKnxDatapointType *(*)(void *);
+    struct Entry
+    {
+        FactoryFunction create;
+        PlacementFunction construct;
+        std::size_t size;
+        std::size_t alignment;
+    };
+
     template <typename Class> static QKnxDatapointType *create()
     {
         return new Class();
     }
 
-    static QHash<int, QHash<int, FactoryFunction>> &factoryTable()
+    template <typename Class> static QKnxDatapointType *construct(void *storage)
+    {
+        return new (storage) Class();
+    }
+
+    // main and sub number are 16 bit each, see 03_07_02 Datapoint Types Paragraph 1.1, but
+    // the whole int is kept so that out of range numbers cannot alias a registered type
+    static constexpr quint64 key(int mainType, int subType)
+    {
+        return (quint64(quint32(mainType)) << 32) | quint32(subType);
+    }
+
+    static QHash<quint64, Entry> &factoryTable()
     {
-        static QHash<int, QHash<int, FactoryFunction>> _instance;
+        static QHash<quint64, Entry> _instance;
         return _instance;
     }
+    const Entry *entry(int mainType, int subType) const;
 
     template <typename Class> void registerType()
     {
@@ -17,6 +17,7 @@ DEFINES += QT_NO_CAST_FROM_ASCII
 PUBLIC_HEADERS += \
     qknxadditionalinfo.h \
     qknxaddress.h \
+    qknxaddressmap.h \
     qknxbytestore.h \
     qknxbytestoreref.h \
     qknxcemi.h \
@@ -27,6 +28,7 @@ PUBLIC_HEADERS += \
     qknxglobal.h \
     qknxgroupaddressinfo.h \
     qknxgroupaddressinfos.h \
+    qknxgroupaddressset.h \
     qknxinterfaceobjectproperty.h \
     qknxinterfaceobjectpropertydatatype.h \
     qknxinterfaceobjecttype.h \
@@ -44,6 +46,9 @@ PUBLIC_HEADERS += \
 
 PRIVATE_HEADERS += \
     qknxlinklayerdevice_p.h \
+    qknxlinklayerframeview_p.h \
+    qknxspscringbuffer_p.h \
+    qknxtimerwheel_p.h \
     qknxtransportlayer_p.h
 
 SOURCES += \
@@ -57,6 +62,7 @@ SOURCES += \
     qknxextendedcontrolfield.cpp \
     qknxgroupaddressinfo.cpp \
     qknxgroupaddressinfos.cpp \
+    qknxgroupaddressset.cpp \
     qknxinterfaceobjectproperty.cpp \
     qknxinterfaceobjectpropertydatatype.cpp \
     qknxinterfaceobjecttype.cpp \
@@ -65,6 +71,7 @@ SOURCES += \
     qknxlinklayerframefactory.cpp \
     qknxlocaldevicemanagementframe.cpp \
     qknxlocaldevicemanagementframefactory.cpp \
+    qknxtimerwheel.cpp \
     qknxtpdu.cpp \
     qknxtpdufactory_broadcast.cpp \
     qknxtpdufactory_multicast.cpp \
@@ -10,6 +10,7 @@ SOURCES += \
     $$PWD/qknxbuildings.cpp \
     $$PWD/qknxdeviceinstance.cpp \
     $$PWD/qknxgroupaddresses.cpp \
+    $$PWD/qknxgroupaddressreader.cpp \
     $$PWD/qknxinstallation.cpp \
     $$PWD/qknxprojectinformation.cpp \
     $$PWD/qknxprojectroot.cpp \
@@ -17,13 +18,14 @@ SOURCES += \
     $$PWD/qknxtopology.cpp \
     $$PWD/qzip.cpp
 
-PRIVATE_HEADERS += $$PWD/qzipreader_p.h
+PRIVATE_HEADERS += $$PWD/qzipreader_p.h \
     $$PWD/qzipwriter_p.h
 
 HEADERS += \
     $$PWD/qknxbuildings.h \
     $$PWD/qknxdeviceinstance.h \
     $$PWD/qknxgroupaddresses.h \
+    $$PWD/qknxgroupaddressreader.h \
     $$PWD/qknxinstallation.h \
     $$PWD/qknxprojectinformation.h \
     $$PWD/qknxprojectroot.h \
@@ -0,0 +1,231 @@
+/******************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxgroupaddressreader.h"
+#include "qknxgroupaddresses.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \internal
+
+    Reads all <Project> elements below the current <KNX> element of \a reader
+    and appends their group address information to \a projects. Returns \c true
+    on success; \c false otherwise with the error set on \a reader. If
+    \a pedantic is \c true, the visited elements are checked against the
+    restrictions of the KNX project schema.
+*/
+bool QKnxGroupAddressReader::readProjects(QXmlStreamReader *reader, QVector<Project> *projects,
+    bool pedantic)
+{
+    if (!reader || !projects)
+        return false;
+
+    while (reader->readNextStartElement()) {
+        if (reader->name() == QLatin1String("Project")) {
+            Project project;
+            if (!readProject(reader, &project, pedantic))
+                return false;
+            projects->append(project);
+        } else {
+            reader->skipCurrentElement();
+        }
+    }
+    return !reader->hasError();
+}
+
+/*!
+    \internal
+
+    Reads the project names below the current <KNX> element of \a reader, as
+    found in a \c project.xml file, and inserts them into \a names keyed by the
+    project ID.
+*/
+bool QKnxGroupAddressReader::readProjectNames(QXmlStreamReader *reader,
+    QHash<QString, QString> *names)
+{
+    if (!reader || !names)
+        return false;
+
+    while (reader->readNextStartElement()) {
+        if (reader->name() != QLatin1String("Project")) {
+            reader->skipCurrentElement();
+            continue;
+        }
+
+        const QString id = reader->attributes().value(QLatin1String("Id")).toString();
+        while (reader->readNextStartElement()) {
+            if (reader->name() == QLatin1String("ProjectInformation") && !names->contains(id))
+                names->insert(id, reader->attributes().value(QLatin1String("Name")).toString());
+            reader->skipCurrentElement();
+        }
+    }
+    return !reader->hasError();
+}
+
+bool QKnxGroupAddressReader::readProject(QXmlStreamReader *reader, Project *project,
+    bool pedantic)
+{
+    QStringRef attr; // required attribute
+    if (!QKnxProjectUtils::fetchAttr(reader->attributes(), QLatin1String("Id"), &attr, reader))
+        return false;
+    if (!QKnxProjectUtils::setNCName(QLatin1String("Id"), attr, &project->id, reader, pedantic))
+        return false;
+
+    while (reader->readNextStartElement()) {
+        if (reader->name() != QLatin1String("Installations")) {
+            reader->skipCurrentElement(); // project information, user files, addin data
+            continue;
+        }
+
+        while (reader->readNextStartElement()) {
+            if (reader->name() != QLatin1String("Installation")) {
+                reader->raiseError(tr("Expected element <Installation>, got: <%1>.")
+                    .arg(reader->name()));
+                return false;
+            }
+            Installation installation;
+            if (!readInstallation(reader, &installation, pedantic))
+                return false;
+            project->installations.append(installation);
+        }
+
+        if (pedantic && project->installations.size() > 16) {
+            reader->raiseError(tr("Pedantic error: Encountered element <Installation> "
+                "more then sixteen times."));
+            return false;
+        }
+    }
+    return !reader->hasError();
+}
+
+bool QKnxGroupAddressReader::readInstallation(QXmlStreamReader *reader,
+    Installation *installation, bool pedantic)
+{
+    QStringRef attr; // required attribute
+    if (!QKnxProjectUtils::fetchAttr(reader->attributes(), QLatin1String("Name"), &attr, reader))
+        return false;
+    if (!QKnxProjectUtils::setString(QLatin1String("Name"), attr, 50, &installation->name,
+        reader, pedantic)) return false;
+
+    bool groupAddresses = false;
+    while (reader->readNextStartElement()) {
+        if (reader->name() != QLatin1String("GroupAddresses")) {
+            reader->skipCurrentElement(); // topology, buildings, trades, bus access, ...
+            continue;
+        }
+
+        if (pedantic && groupAddresses) {
+            reader->raiseError(tr("Pedantic error: Encountered element <GroupAddresses> "
+                "more then once."));
+            return false;
+        }
+        groupAddresses = true;
+
+        if (!readGroupAddresses(reader, installation, pedantic))
+            return false;
+    }
+    return !reader->hasError();
+}
+
+bool QKnxGroupAddressReader::readGroupAddresses(QXmlStreamReader *reader,
+    Installation *installation, bool pedantic)
+{
+    if (!reader->readNextStartElement())
+        return !reader->hasError();
+
+    if (reader->name() != QLatin1String("GroupRanges")) {
+        reader->raiseError(tr("Expected element <GroupRanges>, got: <%1>.").arg(reader->name()));
+        return false;
+    }
+
+    int ranges = 0;
+    while (reader->readNextStartElement()) {
+        if (reader->name() != QLatin1String("GroupRange")) {
+            reader->skipCurrentElement();
+            continue;
+        }
+
+        if (pedantic && ranges++ >= 65535) {
+            reader->raiseError(tr("Pedantic error: Encountered element <GroupRange> "
+                "more then 65535 times."));
+            return false;
+        }
+
+        if (!readGroupRange(reader, installation, pedantic))
+            return false;
+    }
+
+    reader->skipCurrentElement(); // force reading until GroupAddresses end element
+    return !reader->hasError();
+}
+
+bool QKnxGroupAddressReader::readGroupRange(QXmlStreamReader *reader,
+    Installation *installation, bool pedantic)
+{
+    const auto attrs = reader->attributes();
+
+    // required attributes, validated but not stored
+    QString value;
+    QStringRef attr;
+    if (!QKnxProjectUtils::fetchAttr(attrs, QLatin1String("Id"), &attr, reader))
+        return false;
+    if (!QKnxProjectUtils::setNCName(QLatin1String("Id"), attr, &value, reader, pedantic))
+        return false;
+    if (!QKnxProjectUtils::fetchAttr(attrs, QLatin1String("Name"), &attr, reader))
+        return false;
+    if (!QKnxProjectUtils::setString(QLatin1String("Name"), attr, 255, &value, reader,
+        pedantic)) return false;
+    if (!QKnxProjectUtils::fetchAttr(attrs, QLatin1String("RangeStart"), &attr, reader)
+        || !QKnxProjectUtils::fetchAttr(attrs, QLatin1String("RangeEnd"), &attr, reader)
+        || !QKnxProjectUtils::fetchAttr(attrs, QLatin1String("Puid"), &attr, reader)) {
+        return false;
+    }
+
+    // addresses of nested ranges come first, same order as QKnxGroupRange yields them
+    QVector<QKnxGroupAddressInfo> infos;
+    while (reader->readNextStartElement()) {
+        if (reader->name() == QLatin1String("GroupRange")) {
+            if (!readGroupRange(reader, installation, pedantic))
+                return false;
+        } else if (reader->name() == QLatin1String("GroupAddress")) {
+            QKnxGroupAddress address;
+            if (!address.parseElement(reader, pedantic))
+                return false;
+            infos.append({ installation->name, address.Name, quint16(address.Address),
+                address.DatapointType, address.Description });
+        } else {
+            reader->skipCurrentElement();
+        }
+    }
+    installation->infos += infos;
+    return !reader->hasError();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,79 @@
+/******************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXGROUPADDRESSREADER_H
+#define QKNXGROUPADDRESSREADER_H
+
+#include <QtCore/qhash.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qvector.h>
+#include <QtCore/qxmlstream.h>
+#include <QtKnx/qknxgroupaddressinfo.h>
+#include <QtKnx/qknxprojectutils.h>
+
+QT_BEGIN_NAMESPACE
+
+// Pull parser that reads only the group address part of a KNX project file. Unlike
+// QKnxProjectRoot it does not build the project object model; every subtree that does not
+// lead to a group address (topology, buildings, device instances, ...) is skipped without
+// being stored, so memory use depends on the number of group addresses only.
+struct Q_KNX_EXPORT QKnxGroupAddressReader final
+{
+    Q_DECLARE_TR_FUNCTIONS(QKnxGroupAddressReader)
+
+public:
+    struct Installation
+    {
+        QString name;
+        QVector<QKnxGroupAddressInfo> infos;
+    };
+
+    struct Project
+    {
+        QString id;
+        QVector<Installation> installations;
+    };
+
+    static bool readProjects(QXmlStreamReader *reader, QVector<Project> *projects,
+        bool pedantic);
+    static bool readProjectNames(QXmlStreamReader *reader, QHash<QString, QString> *names);
+
+private:
+    static bool readProject(QXmlStreamReader *reader, Project *project, bool pedantic);
+    static bool readInstallation(QXmlStreamReader *reader, Installation *installation,
+        bool pedantic);
+    static bool readGroupAddresses(QXmlStreamReader *reader, Installation *installation,
+        bool pedantic);
+    static bool readGroupRange(QXmlStreamReader *reader, Installation *installation,
+        bool pedantic);
+};
+
+QT_END_NAMESPACE
+
+#endif
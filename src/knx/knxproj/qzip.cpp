@@ -46,9 +46,12 @@
 #include <qendian.h>
 #include <qdebug.h>
 #include <qdir.h>
+#include <qhash.h>
 
 #include <zlib.h>
 
+#include <limits>
+
 // Zip standard version for archives handled by this API
 // (actually, the only basic support of this version is implemented but it is enough for now)
 #define ZIP_VERSION 20
@@ -517,7 +520,72 @@ public:
 
     void scanFiles();
 
+    struct Entry
+    {
+        qint64 offset; // start of the entry data, right after the local file header
+        qint64 compressedSize;
+        qint64 uncompressedSize;
+        int compressionMethod;
+    };
+    bool findEntry(const QString &fileName, Entry *entry);
+
+    qint64 readAt(qint64 pos, char *dest, qint64 len);
+    QByteArray readAt(qint64 pos, qint64 len);
+
     QZipReader::Status status;
+
+    const uchar *data = nullptr; // mapping of the archive, only set for files we own
+    qint64 dataSize = 0;
+    QHash<QString, int> index; // entry name to file header, built on first lookup
+};
+
+class QZipEntryDevice : public QIODevice
+{
+public:
+    QZipEntryDevice(QIODevice *archive, const uchar *mapped,
+            const QZipReaderPrivate::Entry &entry)
+        : archive(archive), mapped(mapped), offset(entry.offset),
+        compressedLeft(entry.compressedSize),
+        uncompressedLeft(entry.uncompressedSize),
+        deflated(entry.compressionMethod == CompressionMethodDeflated)
+    {
+    }
+
+    ~QZipEntryDevice()
+    {
+        close();
+    }
+
+    bool open(OpenMode mode) override;
+    void close() override;
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override
+    {
+        return QIODevice::bytesAvailable() + uncompressedLeft;
+    }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *, qint64) override { return -1; }
+
+private:
+    qint64 readCompressed(char *dest, qint64 maxSize);
+    qint64 inflateData(char *data, qint64 maxSize);
+
+    enum { ChunkSize = 64 * 1024 };
+
+    QIODevice *archive;
+    const uchar *mapped; // mapping of the archive, if any
+    qint64 offset; // next compressed byte in the archive
+    qint64 compressedLeft;
+    qint64 uncompressedLeft;
+
+    bool deflated;
+    bool streamInitialized = false;
+    bool finished = false; // end of stream reached or inflating failed
+    z_stream stream;
+    QByteArray chunk;
 };
 
 class QZipWriterPrivate : public QZipPrivate
@@ -572,8 +640,17 @@ void QZipReaderPrivate::scanFiles()
     }
 
     dirtyFileTree = false;
+
+    // Only map files we opened ourselves, someone else might close their device while we still
+    // hold on to the mapping. Mapping fails e.g. for compressed resources, then we just read.
+    QFile *file = ownDevice ? qobject_cast<QFile *>(device) : nullptr;
+    if (file && !file->isSequential() && file->size() > 0) {
+        data = file->map(0, file->size());
+        dataSize = data ? file->size() : 0;
+    }
+
     uchar tmp[4];
-    device->read((char *)tmp, 4);
+    readAt(0, (char *)tmp, 4);
     if (readUInt(tmp) != 0x04034b50) {
         qWarning("QZip: not a zip file!");
         return;
@@ -583,16 +660,17 @@ void QZipReaderPrivate::scanFiles()
     int i = 0;
     int start_of_directory = -1;
     int num_dir_entries = 0;
+    const qint64 size = data ? dataSize : device->size();
+    qint64 pos = 0;
     EndOfDirectory eod;
     while (start_of_directory == -1) {
-        const int pos = device->size() - int(sizeof(EndOfDirectory)) - i;
+        pos = size - qint64(sizeof(EndOfDirectory)) - i;
         if (pos < 0 || i > 65535) {
             qWarning("QZip: EndOfDirectory not found");
             return;
         }
 
-        device->seek(pos);
-        device->read((char *)&eod, sizeof(EndOfDirectory));
+        readAt(pos, (char *)&eod, sizeof(EndOfDirectory));
         if (readUInt(eod.signature) == 0x06054b50)
             break;
         ++i;
@@ -605,46 +683,249 @@ void QZipReaderPrivate::scanFiles()
     int comment_length = readUShort(eod.comment_length);
     if (comment_length != i)
         qWarning("QZip: failed to parse zip file.");
-    comment = device->read(qMin(comment_length, i));
+    comment = readAt(pos + qint64(sizeof(EndOfDirectory)), qMin(comment_length, i));
 
 
-    device->seek(start_of_directory);
+    pos = start_of_directory;
+    fileHeaders.reserve(num_dir_entries);
     for (i = 0; i < num_dir_entries; ++i) {
         FileHeader header;
-        int read = device->read((char *) &header.h, sizeof(CentralFileHeader));
+        int read = int(readAt(pos, (char *) &header.h, sizeof(CentralFileHeader)));
         if (read < (int)sizeof(CentralFileHeader)) {
             qWarning("QZip: Failed to read complete header, index may be incomplete");
             break;
         }
+        pos += read;
         if (readUInt(header.h.signature) != 0x02014b50) {
             qWarning("QZip: invalid header signature, index may be incomplete");
             break;
         }
 
         int l = readUShort(header.h.file_name_length);
-        header.file_name = device->read(l);
+        header.file_name = readAt(pos, l);
         if (header.file_name.length() != l) {
             qWarning("QZip: Failed to read filename from zip index, index may be incomplete");
             break;
         }
+        pos += l;
         l = readUShort(header.h.extra_field_length);
-        header.extra_field = device->read(l);
+        header.extra_field = readAt(pos, l);
         if (header.extra_field.length() != l) {
             qWarning("QZip: Failed to read extra field in zip file, skipping file, index may be incomplete");
             break;
         }
+        pos += l;
         l = readUShort(header.h.file_comment_length);
-        header.file_comment = device->read(l);
+        header.file_comment = readAt(pos, l);
         if (header.file_comment.length() != l) {
             qWarning("QZip: Failed to read read file comment, index may be incomplete");
             break;
         }
+        pos += l;
 
         ZDEBUG("found file '%s'", header.file_name.data());
         fileHeaders.append(header);
     }
 }
 
+qint64 QZipReaderPrivate::readAt(qint64 pos, char *dest, qint64 len)
+{
+    if (data) {
+        if (pos < 0 || pos >= dataSize)
+            return 0;
+        len = qMin(len, dataSize - pos);
+        memcpy(dest, data + pos, size_t(len));
+        return len;
+    }
+
+    if (!device->seek(pos))
+        return -1;
+    return device->read(dest, len);
+}
+
+QByteArray QZipReaderPrivate::readAt(qint64 pos, qint64 len)
+{
+    if (data) {
+        if (pos < 0 || pos >= dataSize)
+            return QByteArray();
+        return QByteArray(reinterpret_cast<const char *>(data + pos),
+            int(qMin(len, dataSize - pos)));
+    }
+
+    if (!device->seek(pos))
+        return QByteArray();
+    return device->read(len);
+}
+
+bool QZipReaderPrivate::findEntry(const QString &fileName, Entry *entry)
+{
+    scanFiles();
+    if (index.isEmpty()) {
+        index.reserve(fileHeaders.size());
+        for (int i = 0; i < fileHeaders.size(); ++i) {
+            const auto name = QString::fromLocal8Bit(fileHeaders.at(i).file_name);
+            if (!index.contains(name)) // the first entry wins, same as a linear search
+                index.insert(name, i);
+        }
+    }
+
+    const auto it = index.constFind(fileName);
+    if (it == index.constEnd())
+        return false;
+
+    const FileHeader &header = fileHeaders.at(it.value());
+
+    ushort version_needed = readUShort(header.h.version_needed);
+    if (version_needed > ZIP_VERSION) {
+        qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
+        return false;
+    }
+
+    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
+    uint start = readUInt(header.h.offset_local_header);
+    //qDebug("uncompressing file %d: local header at %d", i, start);
+
+    LocalFileHeader lh;
+    if (readAt(start, (char *)&lh, sizeof(LocalFileHeader)) != sizeof(LocalFileHeader))
+        return false;
+    uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
+
+    if ((general_purpose_bits & Encrypted) != 0) {
+        qWarning("QZip: Unsupported encryption method is needed to extract the data.");
+        return false;
+    }
+
+    entry->offset = qint64(start) + qint64(sizeof(LocalFileHeader)) + skip;
+    entry->compressedSize = readUInt(header.h.compressed_size);
+    entry->uncompressedSize = readUInt(header.h.uncompressed_size);
+    entry->compressionMethod = readUShort(lh.compression_method);
+
+    // entry devices read a mapped archive without any further checks
+    return !data || entry->offset + entry->compressedSize <= dataSize;
+}
+
+bool QZipEntryDevice::open(OpenMode mode)
+{
+    if ((mode & QIODevice::WriteOnly) != 0)
+        return false;
+
+    if (deflated && !streamInitialized) {
+        stream.next_in = Z_NULL;
+        stream.avail_in = 0;
+        stream.zalloc = (alloc_func)0;
+        stream.zfree = (free_func)0;
+        stream.opaque = (voidpf)0;
+        if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+            return false;
+        streamInitialized = true;
+        if (!mapped) // a mapped archive is inflated in place
+            chunk.resize(int(qMin<qint64>(ChunkSize, qMax<qint64>(compressedLeft, 1))));
+    }
+    return QIODevice::open(mode);
+}
+
+void QZipEntryDevice::close()
+{
+    if (streamInitialized)
+        inflateEnd(&stream);
+    streamInitialized = false;
+    chunk.clear();
+    QIODevice::close();
+}
+
+qint64 QZipEntryDevice::readCompressed(char *dest, qint64 maxSize)
+{
+    qint64 read = qMin(maxSize, compressedLeft);
+    if (mapped) {
+        memcpy(dest, mapped + offset, size_t(read));
+    } else {
+        // the archive device is shared with the reader and other entries, so always seek first
+        if (!archive->seek(offset))
+            return -1;
+        read = archive->read(dest, read);
+    }
+    if (read > 0) {
+        offset += read;
+        compressedLeft -= read;
+    }
+    return read;
+}
+
+qint64 QZipEntryDevice::inflateData(char *data, qint64 maxSize)
+{
+    stream.next_out = reinterpret_cast<Bytef *>(data);
+    stream.avail_out = uInt(qMin<qint64>(maxSize, std::numeric_limits<uInt>::max()));
+    const uInt requested = stream.avail_out;
+
+    bool failed = false;
+    while (stream.avail_out > 0) {
+        if (stream.avail_in == 0 && compressedLeft > 0 && mapped) {
+            stream.next_in = const_cast<Bytef *>(mapped + offset);
+            stream.avail_in = uInt(qMin<qint64>(compressedLeft, std::numeric_limits<uInt>::max()));
+            offset += stream.avail_in;
+            compressedLeft -= stream.avail_in;
+        } else if (stream.avail_in == 0 && compressedLeft > 0) {
+            const qint64 read = readCompressed(chunk.data(), chunk.size());
+            if (read <= 0) {
+                setErrorString(QStringLiteral("Could not read compressed data"));
+                failed = true;
+                break;
+            }
+            stream.next_in = reinterpret_cast<Bytef *>(chunk.data());
+            stream.avail_in = uInt(read);
+        }
+
+        const int res = inflate(&stream, Z_NO_FLUSH);
+        if (res == Z_STREAM_END) {
+            finished = true;
+            break;
+        }
+        if (res == Z_OK)
+            continue;
+
+        if (res == Z_MEM_ERROR) {
+            qWarning("QZip: Z_MEM_ERROR: Not enough memory");
+            setErrorString(QStringLiteral("Not enough memory"));
+        } else {
+            qWarning("QZip: Z_DATA_ERROR: Input data is corrupted");
+            setErrorString(QStringLiteral("Input data is corrupted"));
+        }
+        failed = true;
+        break;
+    }
+
+    const qint64 produced = requested - stream.avail_out;
+    uncompressedLeft = qMax<qint64>(0, uncompressedLeft - produced);
+    if (failed)
+        finished = true;
+    if (finished)
+        uncompressedLeft = 0;
+    return (failed && produced == 0) ? -1 : produced;
+}
+
+qint64 QZipEntryDevice::readData(char *data, qint64 maxSize)
+{
+    if (maxSize <= 0)
+        return 0;
+
+    if (deflated) {
+        if (finished)
+            return -1;
+        return inflateData(data, maxSize);
+    }
+
+    if (uncompressedLeft == 0)
+        return -1;
+    const qint64 read = readCompressed(data, qMin(maxSize, uncompressedLeft));
+    if (read <= 0) {
+        setErrorString(QStringLiteral("Could not read stored data"));
+        uncompressedLeft = 0;
+        return -1;
+    }
+    uncompressedLeft -= read;
+    return read;
+}
+
 void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const QByteArray &contents/*, QFile::Permissions permissions, QZip::Method m*/)
 {
 #ifndef NDEBUG
@@ -814,6 +1095,10 @@ void QZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
     which files are in the archive using fileInfoList() and entryInfoAt() but
     also to extract individual files using fileData() or even to extract all
     files in the archive using extractAll()
+
+    If the reader opens the archive itself from a file name, the file is
+    memory mapped if possible and the archive is read from the mapping. Looking
+    up an entry by name uses an index that is built on the first lookup.
 */
 
 /*!
@@ -906,6 +1191,21 @@ QVector<QZipReader::FileInfo> QZipReader::fileInfoList() const
 
 }
 
+/*!
+    Returns the names of the files the archive contains, as used to look them
+    up with fileData() and openEntry(). Unlike fileInfoList(), this does not
+    build a FileInfo for every entry.
+*/
+QStringList QZipReader::fileNames() const
+{
+    d->scanFiles();
+    QStringList names;
+    names.reserve(d->fileHeaders.size());
+    for (const FileHeader &header : qAsConst(d->fileHeaders))
+        names.append(QString::fromLocal8Bit(header.file_name));
+    return names;
+}
+
 /*!
     Return the number of items in the zip archive.
 */
@@ -935,60 +1235,32 @@ QZipReader::FileInfo QZipReader::entryInfoAt(int index) const
 */
 QByteArray QZipReader::fileData(const QString &fileName) const
 {
-    d->scanFiles();
-    int i;
-    for (i = 0; i < d->fileHeaders.size(); ++i) {
-        if (QString::fromLocal8Bit(d->fileHeaders.at(i).file_name) == fileName)
-            break;
-    }
-    if (i == d->fileHeaders.size())
+    QZipReaderPrivate::Entry entry;
+    if (!d->findEntry(fileName, &entry))
         return QByteArray();
 
-    FileHeader header = d->fileHeaders.at(i);
-
-    ushort version_needed = readUShort(header.h.version_needed);
-    if (version_needed > ZIP_VERSION) {
-        qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
-        return QByteArray();
-    }
-
-    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
-    int compressed_size = readUInt(header.h.compressed_size);
-    int uncompressed_size = readUInt(header.h.uncompressed_size);
-    int start = readUInt(header.h.offset_local_header);
-    //qDebug("uncompressing file %d: local header at %d", i, start);
-
-    d->device->seek(start);
-    LocalFileHeader lh;
-    d->device->read((char *)&lh, sizeof(LocalFileHeader));
-    uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
-    d->device->seek(d->device->pos() + skip);
-
-    int compression_method = readUShort(lh.compression_method);
+    int compressed_size = int(entry.compressedSize);
+    int uncompressed_size = int(entry.uncompressedSize);
+    int compression_method = entry.compressionMethod;
     //qDebug("file=%s: compressed_size=%d, uncompressed_size=%d", fileName.toLocal8Bit().data(), compressed_size, uncompressed_size);
 
-    if ((general_purpose_bits & Encrypted) != 0) {
-        qWarning("QZip: Unsupported encryption method is needed to extract the data.");
-        return QByteArray();
-    }
-
-    //qDebug("file at %lld", d->device->pos());
-    QByteArray compressed = d->device->read(compressed_size);
     if (compression_method == CompressionMethodStored) {
-        // no compression
-        compressed.truncate(uncompressed_size);
-        return compressed;
+        // no compression, the caller owns the data so even a mapped archive needs a copy
+        return d->readAt(entry.offset, qMin(compressed_size, uncompressed_size));
     } else if (compression_method == CompressionMethodDeflated) {
-        // Deflate
+        // Deflate, straight out of the mapping if there is one
+        const QByteArray compressed = d->data
+            ? QByteArray::fromRawData(reinterpret_cast<const char *>(d->data + entry.offset),
+                compressed_size)
+            : d->readAt(entry.offset, compressed_size);
         //qDebug("compressed=%d", compressed.size());
-        compressed.truncate(compressed_size);
         QByteArray baunzip;
         ulong len = qMax(uncompressed_size,  1);
         int res;
         do {
             baunzip.resize(len);
             res = inflate((uchar*)baunzip.data(), &len,
-                          (const uchar*)compressed.constData(), compressed_size);
+                          (const uchar*)compressed.constData(), compressed.size());
 
             switch (res) {
             case Z_OK:
@@ -1013,6 +1285,36 @@ QByteArray QZipReader::fileData(const QString &fileName) const
     return QByteArray();
 }
 
+/*!
+    Opens the entry \a fileName of the zip archive for reading and returns a
+    sequential device that inflates the entry while it is being read, or
+    \c nullptr if there is no such entry or it cannot be extracted.
+
+    Unlike fileData(), neither the compressed nor the uncompressed entry is
+    held in memory at once; the compressed data is read from the archive in
+    chunks of 64 KB, or inflated in place if the archive is memory mapped.
+    The caller takes ownership of the returned device, which must not be used
+    after the zip reader is closed or destroyed.
+*/
+QIODevice *QZipReader::openEntry(const QString &fileName) const
+{
+    QZipReaderPrivate::Entry entry;
+    if (!d->findEntry(fileName, &entry))
+        return nullptr;
+
+    if (entry.compressionMethod != CompressionMethodStored
+        && entry.compressionMethod != CompressionMethodDeflated) {
+        qWarning("QZip: Unsupported compression method %d is needed to extract the data.",
+            entry.compressionMethod);
+        return nullptr;
+    }
+
+    QScopedPointer<QZipEntryDevice> device(new QZipEntryDevice(d->device, d->data, entry));
+    if (!device->open(QIODevice::ReadOnly))
+        return nullptr;
+    return device.take();
+}
+
 /*!
     Extracts the full contents of the zip file into \a destinationDir on
     the local filesystem.
@@ -1094,7 +1396,9 @@ QZipReader::Status QZipReader::status() const
 */
 void QZipReader::close()
 {
-    d->device->close();
+    d->device->close(); // also unmaps the archive
+    d->data = nullptr;
+    d->dataSize = 0;
 }
 
 ////////////////////////////// Writer
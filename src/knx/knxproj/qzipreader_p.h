@@ -56,6 +56,7 @@
 #include <QtCore/qdatetime.h>
 #include <QtCore/qfile.h>
 #include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
 #include <QtKnx/qknxglobal.h>
 
 QT_BEGIN_NAMESPACE
@@ -94,10 +95,12 @@ public:
     };
 
     QVector<FileInfo> fileInfoList() const;
+    QStringList fileNames() const;
     int count() const;
 
     FileInfo entryInfoAt(int index) const;
     QByteArray fileData(const QString &fileName) const;
+    QIODevice *openEntry(const QString &fileName) const;
     bool extractAll(const QString &destinationDir) const;
 
     enum Status {
@@ -4,6 +4,7 @@ PUBLIC_HEADERS += $$PWD/qknxnetip.h \
     $$PWD/qknxnetipconfigdib.h \
     $$PWD/qknxnetipconnectionheader.h \
     $$PWD/qknxnetipconnectionheaderframe.h \
+    $$PWD/qknxnetipconnectionstatistics.h \
     $$PWD/qknxnetipconnectionstaterequest.h \
     $$PWD/qknxnetipconnectionstateresponse.h \
     $$PWD/qknxnetipconnectrequest.h \
@@ -27,6 +28,7 @@ PUBLIC_HEADERS += $$PWD/qknxnetip.h \
     $$PWD/qknxnetipmanufacturerdib.h \
     $$PWD/qknxnetippackage.h \
     $$PWD/qknxnetippayload.h \
+    $$PWD/qknxnetiprouter.h \
     $$PWD/qknxnetiproutingbusy.h \
     $$PWD/qknxnetiproutingindication.h \
     $$PWD/qknxnetiproutinglostmessage.h \
@@ -39,17 +41,26 @@ PUBLIC_HEADERS += $$PWD/qknxnetip.h \
     $$PWD/qknxnetipstruct.h \
     $$PWD/qknxnetipstructheader.h \
     $$PWD/qknxnetipstructref.h \
+    $$PWD/qknxnetipthreadedtunnelconnection.h \
     $$PWD/qknxnetiptunnelconnection.h \
+    $$PWD/qknxnetiptunnelconnectionpool.h \
     $$PWD/qknxnetiptunnelingacknowledge.h \
     $$PWD/qknxnetiptunnelingrequest.h
 
-PRIVATE_HEADERS += $$PWD/qknxnetipendpointconnection_p.h \
+PRIVATE_HEADERS += $$PWD/qknxnetipconnectionstatistics_p.h \
+    $$PWD/qknxnetipendpointconnection_p.h \
+    $$PWD/qknxnetipframeview_p.h \
+    $$PWD/qknxnetiprouter_p.h \
     $$PWD/qknxnetipserverdescriptionagent_p.h \
     $$PWD/qknxnetipserverdiscoveryagent_p.h \
-    $$PWD/qknxnetipserverinfo_p.h
+    $$PWD/qknxnetipserverinfo_p.h \
+    $$PWD/qknxnetipthreadedtunnelconnection_p.h \
+    $$PWD/qknxnetiptrace_p.h \
+    $$PWD/qknxnetiptunnelconnectionpool_p.h
 
 SOURCES += $$PWD/qknxnetipconfigdib.cpp \
     $$PWD/qknxnetipconnectionheader.cpp \
+    $$PWD/qknxnetipconnectionstatistics.cpp \
     $$PWD/qknxnetipconnectionstaterequest.cpp \
     $$PWD/qknxnetipconnectionstateresponse.cpp \
     $$PWD/qknxnetipconnectrequest.cpp \
@@ -72,6 +83,7 @@ SOURCES += $$PWD/qknxnetipconfigdib.cpp \
     $$PWD/qknxnetipknxaddressesdib.cpp \
     $$PWD/qknxnetipmanufacturerdib.cpp \
     $$PWD/qknxnetippayload.cpp \
+    $$PWD/qknxnetiprouter.cpp \
     $$PWD/qknxnetiproutingbusy.cpp \
     $$PWD/qknxnetiproutingindication.cpp \
     $$PWD/qknxnetiproutinglostmessage.cpp \
@@ -83,6 +95,9 @@ SOURCES += $$PWD/qknxnetipconfigdib.cpp \
     $$PWD/qknxnetipservicefamiliesdib.cpp \
     $$PWD/qknxnetipstruct.cpp \
     $$PWD/qknxnetipstructheader.cpp \
+    $$PWD/qknxnetipthreadedtunnelconnection.cpp \
+    $$PWD/qknxnetiptrace.cpp \
     $$PWD/qknxnetiptunnelconnection.cpp \
+    $$PWD/qknxnetiptunnelconnectionpool.cpp \
     $$PWD/qknxnetiptunnelingacknowledge.cpp \
     $$PWD/qknxnetiptunnelingrequest.cpp
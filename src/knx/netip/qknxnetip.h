@@ -95,7 +95,7 @@ struct Q_KNX_EXPORT QKnxNetIp final
         // KNXnet/IP Routing service type identifier
         RoutingIndication = 0x0530,
         RoutingLostMessage = 0x0531,
-        RoutingBusy = 0x0352
+        RoutingBusy = 0x0532
     };
 
     enum class Error : quint8
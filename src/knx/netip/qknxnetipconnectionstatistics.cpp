@@ -0,0 +1,261 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxnetipconnectionstatistics.h"
+#include "qknxnetipconnectionstatistics_p.h"
+
+#include <QtCore/qalgorithms.h>
+
+#include <cmath>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QKnxNetIpLatencyHistogram
+
+    \inmodule QtKnx
+    \brief The QKnxNetIpLatencyHistogram class holds a snapshot of latencies measured by a
+    KNXnet/IP connection.
+
+    All values are given in microseconds. The histogram uses eight linear buckets per power of
+    two, so the values reported by percentile() deviate at most 12.5 percent from the value
+    actually measured. Values of about 71 minutes and above share the last bucket.
+
+    \sa QKnxNetIpConnectionStatistics
+*/
+
+/*!
+    \fn quint64 QKnxNetIpLatencyHistogram::count() const
+
+    Returns the number of recorded values.
+*/
+
+/*!
+    \fn bool QKnxNetIpLatencyHistogram::isEmpty() const
+
+    Returns \c true if no value was recorded; otherwise returns \c false.
+*/
+
+/*!
+    \fn qint64 QKnxNetIpLatencyHistogram::minimum() const
+
+    Returns the smallest recorded value, or \c 0 if the histogram is empty.
+*/
+
+/*!
+    \fn qint64 QKnxNetIpLatencyHistogram::maximum() const
+
+    Returns the largest recorded value, or \c 0 if the histogram is empty.
+*/
+
+/*!
+    \fn QVector<quint64> QKnxNetIpLatencyHistogram::buckets() const
+
+    Returns the number of values recorded per bucket. Use bucketLowerBound() and
+    bucketUpperBound() to get the range of values covered by a bucket.
+*/
+
+/*!
+    Returns the average of all recorded values, or \c 0 if the histogram is empty.
+*/
+qint64 QKnxNetIpLatencyHistogram::mean() const
+{
+    return (m_count > 0 ? qint64(m_sum / m_count) : 0);
+}
+
+/*!
+    Returns the value below or at which \a percent of the recorded values fall, for example
+    \c 99.0 for the 99th percentile. The value is the upper bound of the bucket it was found in,
+    but never larger than maximum().
+*/
+qint64 QKnxNetIpLatencyHistogram::percentile(double percent) const
+{
+    if (m_count == 0)
+        return 0;
+
+    const quint64 rank = qBound<quint64>(1, quint64(std::ceil(qBound(0.0, percent, 100.0)
+        / 100.0 * double(m_count))), m_count);
+
+    quint64 seen = 0;
+    for (int i = 0; i < m_buckets.size(); ++i) {
+        seen += m_buckets.at(i);
+        if (seen >= rank)
+            return qBound(m_min, bucketUpperBound(i), m_max);
+    }
+    return m_max;
+}
+
+/*!
+    Returns the number of buckets in the histogram.
+*/
+int QKnxNetIpLatencyHistogram::bucketCount()
+{
+    return QKnxNetIpLatencyRecorder::BucketCount;
+}
+
+/*!
+    Returns the index of the bucket that holds the value \a usec.
+*/
+int QKnxNetIpLatencyHistogram::bucketIndex(qint64 usec)
+{
+    const int bits = QKnxNetIpLatencyRecorder::SubBucketBits;
+    if (usec < (1 << bits))
+        return int(qMax(Q_INT64_C(0), usec));
+
+    const quint64 value = qMin(quint64(usec), Q_UINT64_C(0xffffffff));
+    const int exponent = 63 - int(qCountLeadingZeroBits(value));
+    const int subBucket = int(value >> (exponent - bits)) & ((1 << bits) - 1);
+    return ((exponent - bits + 1) << bits) + subBucket;
+}
+
+/*!
+    Returns the smallest value that falls into the bucket at \a index.
+*/
+qint64 QKnxNetIpLatencyHistogram::bucketLowerBound(int index)
+{
+    const int bits = QKnxNetIpLatencyRecorder::SubBucketBits;
+    if (index < (1 << bits))
+        return qMax(0, index);
+
+    const int exponent = (index >> bits) + bits - 1;
+    const int subBucket = index & ((1 << bits) - 1);
+    return qint64((1 << bits) + subBucket) << (exponent - bits);
+}
+
+/*!
+    Returns the largest value that falls into the bucket at \a index.
+*/
+qint64 QKnxNetIpLatencyHistogram::bucketUpperBound(int index)
+{
+    return bucketLowerBound(index + 1) - 1;
+}
+
+
+/*!
+    \class QKnxNetIpConnectionStatistics
+
+    \inmodule QtKnx
+    \brief The QKnxNetIpConnectionStatistics class holds a snapshot of the traffic and latency
+    counters of a KNXnet/IP connection.
+
+    A snapshot is obtained by calling QKnxNetIpEndpointConnection::statistics(), which is
+    safe to call from any thread, or by connecting to the
+    QKnxNetIpEndpointConnection::statisticsUpdated() signal. The counters accumulate over the
+    lifetime of the connection object, including reconnects.
+
+    A growing acknowledgeLatency() or queueWaitTime() together with an increasing number of
+    retransmissions() is a sign of an overloaded KNXnet/IP interface.
+*/
+
+/*!
+    \fn quint64 QKnxNetIpConnectionStatistics::framesSent() const
+
+    Returns the number of cEMI frames sent, including retransmissions.
+*/
+
+/*!
+    \fn quint64 QKnxNetIpConnectionStatistics::framesReceived() const
+
+    Returns the number of cEMI frames received and acknowledged, excluding repetitions.
+*/
+
+/*!
+    \fn quint64 QKnxNetIpConnectionStatistics::retransmissions() const
+
+    Returns the number of cEMI frames that were sent again because the acknowledge did not
+    arrive in time or reported an error.
+*/
+
+/*!
+    \fn QKnxNetIpLatencyHistogram QKnxNetIpConnectionStatistics::acknowledgeLatency() const
+
+    Returns the time between sending a cEMI frame and receiving its acknowledge.
+*/
+
+/*!
+    \fn QKnxNetIpLatencyHistogram QKnxNetIpConnectionStatistics::heartbeatLatency() const
+
+    Returns the round-trip time of the connection state requests sent as heartbeat.
+*/
+
+/*!
+    \fn QKnxNetIpLatencyHistogram QKnxNetIpConnectionStatistics::queueWaitTime() const
+
+    Returns the time outgoing cEMI frames spent in the send queue before being sent for the
+    first time.
+*/
+
+
+// -- QKnxNetIpLatencyRecorder
+
+void QKnxNetIpLatencyRecorder::record(qint64 usec)
+{
+    usec = qMax(Q_INT64_C(0), usec);
+    m_buckets[QKnxNetIpLatencyHistogram::bucketIndex(usec)].fetchAndAddRelaxed(1);
+    m_sum.fetchAndAddRelaxed(quint64(usec));
+
+    qint64 current = m_min.load();
+    while ((current < 0 || usec < current) && !m_min.testAndSetRelaxed(current, usec, current)) {}
+    current = m_max.load();
+    while (usec > current && !m_max.testAndSetRelaxed(current, usec, current)) {}
+}
+
+QKnxNetIpLatencyHistogram QKnxNetIpLatencyRecorder::snapshot() const
+{
+    QKnxNetIpLatencyHistogram histogram;
+    histogram.m_buckets.resize(BucketCount);
+    for (int i = 0; i < BucketCount; ++i) {
+        histogram.m_buckets[i] = m_buckets[i].load();
+        histogram.m_count += histogram.m_buckets[i];
+    }
+
+    if (histogram.m_count > 0) {
+        histogram.m_sum = m_sum.load();
+        histogram.m_min = qMax(Q_INT64_C(0), m_min.load());
+        histogram.m_max = m_max.load();
+    }
+    return histogram;
+}
+
+
+// -- QKnxNetIpConnectionStatisticsRecorder
+
+QKnxNetIpConnectionStatistics QKnxNetIpConnectionStatisticsRecorder::snapshot() const
+{
+    QKnxNetIpConnectionStatistics statistics;
+    statistics.m_framesSent = m_framesSent.load();
+    statistics.m_framesReceived = m_framesReceived.load();
+    statistics.m_retransmissions = m_retransmissions.load();
+    statistics.m_acknowledgeLatency = acknowledgeLatency.snapshot();
+    statistics.m_heartbeatLatency = heartbeatLatency.snapshot();
+    statistics.m_queueWaitTime = queueWaitTime.snapshot();
+    return statistics;
+}
+
+QT_END_NAMESPACE
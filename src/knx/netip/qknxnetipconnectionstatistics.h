@@ -0,0 +1,100 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPCONNECTIONSTATISTICS_H
+#define QKNXNETIPCONNECTIONSTATISTICS_H
+
+#include <QtCore/qmetatype.h>
+#include <QtCore/qvector.h>
+#include <QtKnx/qknxglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxNetIpLatencyRecorder;
+
+class Q_KNX_EXPORT QKnxNetIpLatencyHistogram final
+{
+    friend class QKnxNetIpLatencyRecorder;
+
+public:
+    QKnxNetIpLatencyHistogram() = default;
+
+    quint64 count() const { return m_count; }
+    bool isEmpty() const { return m_count == 0; }
+
+    qint64 minimum() const { return m_min; }
+    qint64 maximum() const { return m_max; }
+    qint64 mean() const;
+    qint64 percentile(double percent) const;
+
+    QVector<quint64> buckets() const { return m_buckets; }
+
+    static int bucketCount();
+    static int bucketIndex(qint64 usec);
+    static qint64 bucketLowerBound(int index);
+    static qint64 bucketUpperBound(int index);
+
+private:
+    QVector<quint64> m_buckets;
+    quint64 m_count { 0 };
+    quint64 m_sum { 0 };
+    qint64 m_min { 0 };
+    qint64 m_max { 0 };
+};
+
+class Q_KNX_EXPORT QKnxNetIpConnectionStatistics final
+{
+    friend class QKnxNetIpConnectionStatisticsRecorder;
+
+public:
+    QKnxNetIpConnectionStatistics() = default;
+
+    quint64 framesSent() const { return m_framesSent; }
+    quint64 framesReceived() const { return m_framesReceived; }
+    quint64 retransmissions() const { return m_retransmissions; }
+
+    QKnxNetIpLatencyHistogram acknowledgeLatency() const { return m_acknowledgeLatency; }
+    QKnxNetIpLatencyHistogram heartbeatLatency() const { return m_heartbeatLatency; }
+    QKnxNetIpLatencyHistogram queueWaitTime() const { return m_queueWaitTime; }
+
+private:
+    quint64 m_framesSent { 0 };
+    quint64 m_framesReceived { 0 };
+    quint64 m_retransmissions { 0 };
+
+    QKnxNetIpLatencyHistogram m_acknowledgeLatency;
+    QKnxNetIpLatencyHistogram m_heartbeatLatency;
+    QKnxNetIpLatencyHistogram m_queueWaitTime;
+};
+
+QT_END_NAMESPACE
+
+Q_DECLARE_METATYPE(QKnxNetIpConnectionStatistics)
+
+#endif
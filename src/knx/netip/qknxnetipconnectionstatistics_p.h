@@ -0,0 +1,103 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPCONNECTIONSTATISTICS_P_H
+#define QKNXNETIPCONNECTIONSTATISTICS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtKnx/qknxglobal.h>
+#include <QtKnx/qknxnetipconnectionstatistics.h>
+
+QT_BEGIN_NAMESPACE
+
+// Log-linear histogram of microsecond values: eight linear buckets per power of two, so each
+// bucket is at most 12.5% wide relative to its value, covering 0 us up to about 71 minutes.
+// Values are recorded by the connection thread and can be read from any thread.
+class Q_KNX_EXPORT QKnxNetIpLatencyRecorder final
+{
+public:
+    static constexpr const int SubBucketBits = 3;
+    static constexpr const int BucketCount = (32 - SubBucketBits + 1) << SubBucketBits;
+
+    QKnxNetIpLatencyRecorder() = default;
+
+    void record(qint64 usec);
+    QKnxNetIpLatencyHistogram snapshot() const;
+
+private:
+    QAtomicInteger<quint64> m_buckets[BucketCount];
+    QAtomicInteger<quint64> m_sum { 0 };
+    QAtomicInteger<qint64> m_min { -1 };
+    QAtomicInteger<qint64> m_max { 0 };
+};
+
+class Q_KNX_EXPORT QKnxNetIpConnectionStatisticsRecorder final
+{
+public:
+    QKnxNetIpConnectionStatisticsRecorder() { m_clock.start(); }
+
+    // monotonic time stamp in microseconds, used for all latency measurements
+    qint64 now() const { return m_clock.nsecsElapsed() / 1000; }
+
+    void frameSent(bool retransmission)
+    {
+        m_framesSent.fetchAndAddRelaxed(1);
+        if (retransmission)
+            m_retransmissions.fetchAndAddRelaxed(1);
+    }
+    void frameReceived() { m_framesReceived.fetchAndAddRelaxed(1); }
+
+    QKnxNetIpConnectionStatistics snapshot() const;
+
+    QKnxNetIpLatencyRecorder acknowledgeLatency;
+    QKnxNetIpLatencyRecorder heartbeatLatency;
+    QKnxNetIpLatencyRecorder queueWaitTime;
+
+private:
+    QElapsedTimer m_clock;
+    QAtomicInteger<quint64> m_framesSent { 0 };
+    QAtomicInteger<quint64> m_framesReceived { 0 };
+    QAtomicInteger<quint64> m_retransmissions { 0 };
+};
+
+QT_END_NAMESPACE
+
+#endif
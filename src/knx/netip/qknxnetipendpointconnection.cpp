@@ -37,25 +37,17 @@
 #include "qknxnetipdisconnectresponse.h"
 #include "qknxnetipendpointconnection.h"
 #include "qknxnetipendpointconnection_p.h"
-#include "qknxnetiptunnelingacknowledge.h"
+#include "qknxnetiptrace_p.h"
 #include "qknxnetiptunnelingrequest.h"
 #include "qnetworkdatagram.h"
 #include "qudpsocket.h"
 
+#include <QtCore/qrandom.h>
+
 QT_BEGIN_NAMESPACE
 
 namespace QKnxPrivate
 {
-    static void clearTimer(QTimer **timer)
-    {
-        if (*timer) {
-            (*timer)->stop();
-            (*timer)->disconnect();
-            (*timer)->deleteLater();
-            (*timer) = nullptr;
-        }
-    }
-
     static void clearSocket(QUdpSocket **socket)
     {
         if (*socket) {
@@ -64,67 +56,111 @@ namespace QKnxPrivate
             (*socket) = nullptr;
         }
     }
+
+    static int sendQueueIndex(QKnxControlField::Priority priority)
+    {
+        switch (priority) {
+        case QKnxControlField::Priority::System:
+            return 0;
+        case QKnxControlField::Priority::Urgent:
+            return 1;
+        case QKnxControlField::Priority::Normal:
+            return 2;
+        case QKnxControlField::Priority::Low:
+        default:
+            break;
+        }
+        return 3;
+    }
+
+    static QNetworkDatagram toDatagram(const QKnxNetIpFrameView &frame,
+        const DatagramBuffer &buffer)
+    {
+        QNetworkDatagram datagram(frame.bytes());
+        datagram.setSender(buffer.senderAddress, buffer.senderPort);
+        return datagram;
+    }
+
+    static void setSequenceCount(QByteArray *request, quint8 sequenceCount)
+    {
+        // frame header, structure length, channel id -> sequence counter
+        const int index = QKnxNetIpFrameHeader::HeaderSize10 + 2;
+        if (request->size() > index)
+            (*request)[index] = char(sequenceCount);
+    }
+
+    static bool isDataService(QKnxNetIp::ServiceType type)
+    {
+        switch (type) {
+        case QKnxNetIp::ServiceType::TunnelingRequest:
+        case QKnxNetIp::ServiceType::TunnelingAcknowledge:
+        case QKnxNetIp::ServiceType::DeviceConfigurationRequest:
+        case QKnxNetIp::ServiceType::DeviceConfigurationAcknowledge:
+            return true;
+        default:
+            break;
+        }
+        return false;
+    }
+
+    static int reconnectDelay(int attempt, quint32 interval, quint32 maximum)
+    {
+        quint64 delay = qMax(interval, 1u);
+        for (int i = 1; i < attempt && delay < maximum; ++i)
+            delay *= 2;
+        delay = qMin(delay, quint64(qMax(maximum, interval)));
+
+        // Keep half of the exponential delay and randomize the other half, so that clients
+        // losing their connection at the same time do not reconnect in lockstep.
+        const quint32 half = quint32(delay / 2);
+        return int(delay - half + QRandomGenerator::global()->bounded(half + 1));
+    }
 }
 
 void QKnxNetIpEndpointConnectionPrivate::setupTimer()
 {
-    QKnxPrivate::clearTimer(&m_heartbeatTimer);
-    QKnxPrivate::clearTimer(&m_connectRequestTimer);
-    QKnxPrivate::clearTimer(&m_connectionStateTimer);
-    QKnxPrivate::clearTimer(&m_disconnectRequestTimer);
-    QKnxPrivate::clearTimer(&m_acknowledgeTimer);
+    m_heartbeatTimer.stop();
+    m_connectRequestTimer.stop();
+    m_connectionStateTimer.stop();
+    m_disconnectRequestTimer.stop();
+    m_acknowledgeTimer.stop();
 
-    Q_Q(QKnxNetIpEndpointConnection);
-    m_heartbeatTimer = new QTimer(q);
-    m_heartbeatTimer->setSingleShot(true);
-    QObject::connect(m_heartbeatTimer, &QTimer::timeout, [&]() {
+    m_heartbeatTimer.setCallback([&]() {
         sendStateRequest();
     });
 
-    m_connectRequestTimer = new QTimer(q);
-    m_connectRequestTimer->setSingleShot(true);
-    QObject::connect(m_connectRequestTimer, &QTimer::timeout, [&]() {
+    m_connectRequestTimer.setCallback([&]() {
         setAndEmitStateChanged(QKnxNetIpEndpointConnection::State::Bound);
         setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Acknowledge,
             QKnxNetIpEndpointConnection::tr("Connect request timeout."));
-
-        Q_Q(QKnxNetIpEndpointConnection);
-        q->disconnectFromHost();
+        disconnectAndReconnect();
     });
 
-    m_connectionStateTimer = new QTimer(q);
-    m_connectionStateTimer->setSingleShot(true);
-    QObject::connect(m_connectionStateTimer, &QTimer::timeout, [&]() {
-        m_heartbeatTimer->stop();
-        m_connectionStateTimer->stop();
+    m_connectionStateTimer.setCallback([&]() {
+        m_heartbeatTimer.stop();
+        m_connectionStateTimer.stop();
         if (m_stateRequests > m_maxStateRequests) {
             setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Heartbeat,
                 QKnxNetIpEndpointConnection::tr("Connection state request timeout."));
-
-            Q_Q(QKnxNetIpEndpointConnection);
-            q->disconnectFromHost();
+            // the server might still hold the channel, 03_08_02 Core requires a disconnect
+            // request after the last connection state request failed
+            disconnectAndReconnect();
         } else {
             sendStateRequest();
         }
     });
 
-    m_disconnectRequestTimer = new QTimer(q);
-    m_disconnectRequestTimer->setSingleShot(true);
-    QObject::connect(m_disconnectRequestTimer, &QTimer::timeout, [&] () {
+    m_disconnectRequestTimer.setCallback([&] () {
         setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Acknowledge,
             QKnxNetIpEndpointConnection::tr("Disconnect request timeout."));
         process(QKnxNetIpDisconnectResponse(m_channelId, QKnxNetIp::Error::None));
     });
 
-    m_acknowledgeTimer = new QTimer(q);
-    m_acknowledgeTimer->setSingleShot(true);
-    QObject::connect(m_acknowledgeTimer, &QTimer::timeout, [&]() {
+    m_acknowledgeTimer.setCallback([&]() {
         if (m_cemiRequests > m_maxCemiRequest) {
             setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Cemi,
                 QKnxNetIpEndpointConnection::tr("Did not receive acknowledge in time."));
-
-            Q_Q(QKnxNetIpEndpointConnection);
-            q->disconnectFromHost();
+            disconnectAndReconnect();
         } else {
             m_waitForAcknowledgement = false;
             sendCemiRequest();
@@ -142,6 +178,8 @@ void QKnxNetIpEndpointConnectionPrivate::setup()
     m_receiveCount = 0;
     m_cemiRequests = 0;
     m_lastSendCemiRequest = {};
+    m_waitForAcknowledgement = false;
+    clearSendQueue();
 
     m_stateRequests = 0;
     m_lastStateRequest = {};
@@ -152,109 +190,125 @@ void QKnxNetIpEndpointConnectionPrivate::setup()
     m_errorString = QString();
     m_error = QKnxNetIpEndpointConnection::Error::None;
 
-    QObject::connect(m_dataEndpoint, &QUdpSocket::readyRead, [&]() {
-        while (m_dataEndpoint && m_dataEndpoint->state() == QUdpSocket::BoundState
-            && m_dataEndpoint->hasPendingDatagrams()) {
-                auto datagram = m_dataEndpoint->receiveDatagram();
-                const auto header = QKnxNetIpFrameHeader::fromBytes(datagram.data(), 0);
-                if (header.isValid() && header.totalSize() == datagram.data().size()) {
-                    // TODO: fix the version and validity checks
-                    // if (!m_supportedVersions.contains(header.protocolVersion())) {
-                    //     send E_VERSION_NOT_SUPPORTED confirmation frame
-                    //     send disconnect request
-                    // } else if (header.protocolVersion() != m_dataEndpointVersion {
-                    //     send disconnect request
-                    // } else {
-                    // TODO: set the m_dataEndpointVersion once we receive or send the first frame
-                        switch (header.code()) {
-                        case QKnxNetIp::ServiceType::TunnelingRequest:
-                            process(QKnxNetIpTunnelingRequest::fromBytes(datagram.data(), 0));
-                            break;
-                        case QKnxNetIp::ServiceType::TunnelingAcknowledge:
-                            process(QKnxNetIpTunnelingAcknowledge::fromBytes(datagram.data(), 0));
-                            break;
-                        case QKnxNetIp::ServiceType::DeviceConfigurationRequest:
-                            process(QKnxNetIpDeviceConfigurationRequest::fromBytes(datagram.data(),
-                                0));
-                            break;
-                        case QKnxNetIp::ServiceType::DeviceConfigurationAcknowledge:
-                            process(QKnxNetIpDeviceConfigurationAcknowledge::fromBytes(datagram
-                                .data(), 0));
-                            break;
-                        default:
-                            processDatagram(QKnxNetIpEndpointConnection::EndpointType::Data, datagram);
-                            break;
-                        }
-                    // }
-                }
-        }
-    });
-
     using overload = void (QUdpSocket::*)(QUdpSocket::SocketError);
-    QObject::connect(m_dataEndpoint,
-        static_cast<overload>(&QUdpSocket::error), [&](QUdpSocket::SocketError) {
-            setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Network,
-                m_dataEndpoint->errorString());
-
-            Q_Q(QKnxNetIpEndpointConnection);
-            q->disconnectFromHost();
-    });
-
-    QObject::connect(m_controlEndpoint, &QUdpSocket::readyRead, [&]() {
-        while (m_controlEndpoint && m_controlEndpoint->state() == QUdpSocket::BoundState
-            && m_controlEndpoint->hasPendingDatagrams()) {
-                auto datagram = m_controlEndpoint->receiveDatagram();
-                const auto header = QKnxNetIpFrameHeader::fromBytes(datagram.data(), 0);
-                if (header.isValid() && header.totalSize() == datagram.data().size()) {
-                    // TODO: fix the version and validity checks
-                    // if (!m_supportedVersions.contains(header.protocolVersion())) {
-                    //     send E_VERSION_NOT_SUPPORTED confirmation frame
-                    //     send disconnect request
-                    // } else if (header.protocolVersion() != m_controlEndpointVersion) {
-                    //     send disconnect request
-                    // } else {
-                        switch (header.code()) {
-                        case QKnxNetIp::ServiceType::ConnectResponse:
-                            process(QKnxNetIpConnectResponse::fromBytes(datagram.data(), 0),
-                                datagram);
-                            break;
-                        case QKnxNetIp::ServiceType::ConnectionStateResponse:
-                            process(QKnxNetIpConnectionStateResponse::fromBytes(datagram.data(), 0));
-                            break;
-                        case QKnxNetIp::ServiceType::DisconnectRequest:
-                            process(QKnxNetIpDisconnectRequest::fromBytes(datagram.data(), 0));
-                            break;
-                        case QKnxNetIp::ServiceType::DisconnectResponse:
-                            process(QKnxNetIpDisconnectResponse::fromBytes(datagram.data(), 0));
-                            break;
-                        default:
-                            processDatagram(QKnxNetIpEndpointConnection::EndpointType::Control,
-                                datagram);
-                            break;
-                        }
-                    // }
-                }
-        }
-    });
+    if (m_singleSocket) {
+        // control and data endpoint share the socket, dispatch by service type
+        QObject::connect(m_controlEndpoint, &QUdpSocket::readyRead, [&]() {
+            QKnxNetIpFrameView frame;
+            while (readDatagram(m_controlEndpoint, &m_controlBuffer, &frame)) {
+                if (QKnxPrivate::isDataService(frame.code()))
+                    processDataFrame(frame, m_controlBuffer);
+                else
+                    processControlFrame(frame, m_controlBuffer);
+            }
+        });
+    } else {
+        QObject::connect(m_dataEndpoint, &QUdpSocket::readyRead, [&]() {
+            QKnxNetIpFrameView frame;
+            while (readDatagram(m_dataEndpoint, &m_dataBuffer, &frame))
+                processDataFrame(frame, m_dataBuffer);
+        });
+
+        QObject::connect(m_dataEndpoint,
+            static_cast<overload>(&QUdpSocket::error), [&](QUdpSocket::SocketError) {
+                setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Network,
+                    m_dataEndpoint->errorString());
+                closeAndReconnect();
+        });
+
+        QObject::connect(m_controlEndpoint, &QUdpSocket::readyRead, [&]() {
+            QKnxNetIpFrameView frame;
+            while (readDatagram(m_controlEndpoint, &m_controlBuffer, &frame))
+                processControlFrame(frame, m_controlBuffer);
+        });
+    }
 
-    using overload = void (QUdpSocket::*)(QUdpSocket::SocketError);
     QObject::connect(m_controlEndpoint,
         static_cast<overload>(&QUdpSocket::error), [&](QUdpSocket::SocketError) {
             setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Network,
                 m_controlEndpoint->errorString());
-
-            Q_Q(QKnxNetIpEndpointConnection);
-            q->disconnectFromHost();
+            closeAndReconnect();
     });
 }
 
+void QKnxNetIpEndpointConnectionPrivate::processDataFrame(const QKnxNetIpFrameView &frame,
+    const DatagramBuffer &buffer)
+{
+    // TODO: fix the version and validity checks
+    // if (!m_supportedVersions.contains(frame.protocolVersion())) {
+    //     send E_VERSION_NOT_SUPPORTED confirmation frame
+    //     send disconnect request
+    // } else if (frame.protocolVersion() != m_dataEndpointVersion {
+    //     send disconnect request
+    // } else {
+    // TODO: set the m_dataEndpointVersion once we receive or send the first frame
+        switch (frame.code()) {
+        case QKnxNetIp::ServiceType::TunnelingRequest:
+            processTunnelingRequest(frame);
+            break;
+        case QKnxNetIp::ServiceType::TunnelingAcknowledge:
+            processTunnelingAcknowledge(frame);
+            break;
+        case QKnxNetIp::ServiceType::DeviceConfigurationRequest:
+            process(QKnxNetIpDeviceConfigurationRequest::fromBytes(frame.bytes(), 0));
+            break;
+        case QKnxNetIp::ServiceType::DeviceConfigurationAcknowledge:
+            process(QKnxNetIpDeviceConfigurationAcknowledge::fromBytes(frame.bytes(), 0));
+            break;
+        default:
+            processDatagram(QKnxNetIpEndpointConnection::EndpointType::Data,
+                QKnxPrivate::toDatagram(frame, buffer));
+            break;
+        }
+    // }
+}
+
+void QKnxNetIpEndpointConnectionPrivate::processControlFrame(const QKnxNetIpFrameView &frame,
+    const DatagramBuffer &buffer)
+{
+    // TODO: fix the version and validity checks
+    // if (!m_supportedVersions.contains(frame.protocolVersion())) {
+    //     send E_VERSION_NOT_SUPPORTED confirmation frame
+    //     send disconnect request
+    // } else if (frame.protocolVersion() != m_controlEndpointVersion) {
+    //     send disconnect request
+    // } else {
+        switch (frame.code()) {
+        case QKnxNetIp::ServiceType::ConnectResponse:
+            process(QKnxNetIpConnectResponse::fromBytes(frame.bytes(), 0),
+                QKnxPrivate::toDatagram(frame, buffer));
+            break;
+        case QKnxNetIp::ServiceType::ConnectionStateResponse:
+            process(QKnxNetIpConnectionStateResponse::fromBytes(frame.bytes(), 0));
+            break;
+        case QKnxNetIp::ServiceType::DisconnectRequest:
+            process(QKnxNetIpDisconnectRequest::fromBytes(frame.bytes(), 0));
+            break;
+        case QKnxNetIp::ServiceType::DisconnectResponse:
+            process(QKnxNetIpDisconnectResponse::fromBytes(frame.bytes(), 0));
+            break;
+        default:
+            processDatagram(QKnxNetIpEndpointConnection::EndpointType::Control,
+                QKnxPrivate::toDatagram(frame, buffer));
+            break;
+        }
+    // }
+}
+
 void QKnxNetIpEndpointConnectionPrivate::cleanup()
 {
-    QKnxPrivate::clearTimer(&m_heartbeatTimer);
-    QKnxPrivate::clearTimer(&m_connectRequestTimer);
-    QKnxPrivate::clearTimer(&m_connectionStateTimer);
-    QKnxPrivate::clearTimer(&m_disconnectRequestTimer);
-    QKnxPrivate::clearTimer(&m_acknowledgeTimer);
+    m_heartbeatTimer.stop();
+    m_connectRequestTimer.stop();
+    m_connectionStateTimer.stop();
+    m_disconnectRequestTimer.stop();
+    m_acknowledgeTimer.stop();
+    m_statisticsTimer.stop();
+
+    m_waitForAcknowledgement = false;
+    clearSendQueue();
+
+    if (m_dataEndpoint == m_controlEndpoint)
+        m_dataEndpoint = nullptr; // single socket mode, owned by the control endpoint
 
     if (m_dataEndpoint) m_dataEndpoint->close();
     if (m_controlEndpoint) m_controlEndpoint->close();
@@ -263,30 +317,244 @@ void QKnxNetIpEndpointConnectionPrivate::cleanup()
     QKnxPrivate::clearSocket(&m_controlEndpoint);
 
     setAndEmitStateChanged(QKnxNetIpEndpointConnection::State::Disconnected);
+
+    if (m_reconnectPending)
+        scheduleReconnect();
+}
+
+void QKnxNetIpEndpointConnectionPrivate::disconnectAndReconnect()
+{
+    Q_Q(QKnxNetIpEndpointConnection);
+    q->disconnectFromHost();
+
+    // The public function cancels any pending reconnect, so the request is recorded afterwards.
+    // If the disconnect was not finished synchronously, cleanup() picks it up.
+    m_reconnectPending = m_autoReconnect;
+    if (m_state == QKnxNetIpEndpointConnection::State::Disconnected)
+        scheduleReconnect();
+}
+
+void QKnxNetIpEndpointConnectionPrivate::closeAndReconnect()
+{
+    // The server closed the connection or the socket failed, so there is no point in sending a
+    // disconnect request and waiting for its response.
+    if (m_state == QKnxNetIpEndpointConnection::State::Disconnected) {
+        m_reconnectPending = m_autoReconnect;
+        scheduleReconnect();
+        return;
+    }
+
+    // a disconnect we initiated ourselves keeps its reconnect decision
+    if (m_state != QKnxNetIpEndpointConnection::State::Disconnecting) {
+        m_reconnectPending = m_autoReconnect;
+        setAndEmitStateChanged(QKnxNetIpEndpointConnection::State::Disconnecting);
+    }
+    cleanup();
+}
+
+void QKnxNetIpEndpointConnectionPrivate::scheduleReconnect()
+{
+    const bool pending = m_reconnectPending;
+    m_reconnectPending = false;
+    if (!pending || !m_autoReconnect || m_state != QKnxNetIpEndpointConnection::State::Disconnected)
+        return;
+
+    if (m_maxReconnectAttempts > 0 && m_reconnectAttempts >= m_maxReconnectAttempts) {
+        const int attempts = m_reconnectAttempts;
+        m_reconnectAttempts = 0;
+        setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Reconnect,
+            QKnxNetIpEndpointConnection::tr("Could not reconnect after %1 attempts.")
+                .arg(attempts));
+        return;
+    }
+
+    m_reconnectTimer.setCallback([&]() { reconnect(); });
+
+    m_reconnectAttempts++;
+    const int delay = QKnxPrivate::reconnectDelay(m_reconnectAttempts, m_reconnectInterval,
+        m_maxReconnectInterval);
+    m_reconnectTimer.start(delay);
+
+    qCDebug(QT_KNX_NETIP) << "Reconnect attempt" << m_reconnectAttempts << "in" << delay << "ms.";
+    Q_Q(QKnxNetIpEndpointConnection);
+    emit q->reconnecting(m_reconnectAttempts, delay);
+}
+
+void QKnxNetIpEndpointConnectionPrivate::reconnect()
+{
+    Q_Q(QKnxNetIpEndpointConnection);
+    q->connectToHost(m_remoteControlEndpoint.address, m_remoteControlEndpoint.port);
+
+    // binding the local sockets failed, there will be no response to wait for
+    if (m_state == QKnxNetIpEndpointConnection::State::Disconnected) {
+        m_reconnectPending = m_autoReconnect;
+        scheduleReconnect();
+    }
 }
 
 bool QKnxNetIpEndpointConnectionPrivate::sendCemiRequest()
 {
-    if (!m_waitForAcknowledgement) {
-        m_waitForAcknowledgement = true;
-        m_dataEndpoint->writeDatagram(m_lastSendCemiRequest, m_remoteDataEndpoint.address,
-            m_remoteDataEndpoint.port);
-        m_cemiRequests++;
-        m_acknowledgeTimer->start(m_acknowledgeTimeout);
+    if (m_waitForAcknowledgement || m_lastSendCemiRequest.isEmpty())
+        return false;
+
+    m_waitForAcknowledgement = true;
+    writeDatagram(m_dataEndpoint, m_lastSendCemiRequest, m_remoteDataEndpoint);
+    m_cemiRequests++;
+    m_cemiRequestSent = m_statistics.now();
+    m_statistics.frameSent(m_cemiRequests > 1);
+    m_acknowledgeTimer.start(m_acknowledgeTimeout);
+    return true;
+}
+
+bool QKnxNetIpEndpointConnectionPrivate::enqueueCemiRequest(const QByteArray &request,
+    QKnxControlField::Priority priority)
+{
+    Q_Q(QKnxNetIpEndpointConnection);
+    if (sendQueueSize() >= m_maxSendQueueSize) {
+        m_droppedFrames++;
+        emit q->frameDropped();
+        return false;
     }
-    return !m_waitForAcknowledgement;
+
+    m_sendQueues[QKnxPrivate::sendQueueIndex(priority)].enqueue({ request, m_statistics.now() });
+    emit q->sendQueueSizeChanged(sendQueueSize());
+
+    if (!m_waitForAcknowledgement)
+        sendNextCemiRequest();
+    return true;
 }
 
-void QKnxNetIpEndpointConnectionPrivate::sendStateRequest()
+void QKnxNetIpEndpointConnectionPrivate::sendNextCemiRequest()
 {
-    qDebug().noquote().nospace() << "Sending connection state request: 0x" << m_lastStateRequest
-        .toHex();
+    for (auto &queue : m_sendQueues) {
+        if (queue.isEmpty())
+            continue;
+
+        // The sequence counter is only known once the previous request got acknowledged, so it
+        // is stamped into the request right before it goes out for the first time.
+        const auto queued = queue.dequeue();
+        m_statistics.queueWaitTime.record(m_statistics.now() - queued.enqueued);
 
-    m_controlEndpoint->writeDatagram(m_lastStateRequest, m_remoteControlEndpoint.address,
-        m_remoteControlEndpoint.port);
+        m_lastSendCemiRequest = queued.bytes;
+        QKnxPrivate::setSequenceCount(&m_lastSendCemiRequest, m_sendCount);
+        m_cemiRequests = 0;
+
+        Q_Q(QKnxNetIpEndpointConnection);
+        emit q->sendQueueSizeChanged(sendQueueSize());
+
+        sendCemiRequest();
+        break;
+    }
+}
+
+void QKnxNetIpEndpointConnectionPrivate::clearSendQueue()
+{
+    const int size = sendQueueSize();
+    if (size == 0)
+        return;
+
+    for (auto &queue : m_sendQueues)
+        queue.clear();
+    m_droppedFrames += quint32(size);
+
+    // frames discarded on teardown count as dropped, the same as on overflow
+    Q_Q(QKnxNetIpEndpointConnection);
+    emit q->sendQueueSizeChanged(0);
+    for (int i = 0; i < size; ++i)
+        emit q->frameDropped();
+}
+
+int QKnxNetIpEndpointConnectionPrivate::sendQueueSize() const
+{
+    int size = 0;
+    for (const auto &queue : m_sendQueues)
+        size += queue.size();
+    return size;
+}
+
+void QKnxNetIpEndpointConnectionPrivate::startStatisticsTimer()
+{
+    m_statisticsTimer.stop();
+    if (m_statisticsInterval <= 0 || m_state != QKnxNetIpEndpointConnection::State::Connected)
+        return;
+
+    m_statisticsTimer.setCallback([&]() {
+        Q_Q(QKnxNetIpEndpointConnection);
+        m_statisticsTimer.start();
+        emit q->statisticsUpdated(m_statistics.snapshot());
+    });
+    m_statisticsTimer.start(m_statisticsInterval);
+}
+
+void QKnxNetIpEndpointConnectionPrivate::sendStateRequest()
+{
+    qCDebug(QT_KNX_NETIP) << "Sending connection state request.";
+    writeDatagram(m_controlEndpoint, m_lastStateRequest, m_remoteControlEndpoint);
+    m_stateRequestSent = m_statistics.now();
 
     m_stateRequests++;
-    m_connectionStateTimer->start(QKnxNetIp::ConnectionStateRequestTimeout);
+    m_connectionStateTimer.start(QKnxNetIp::ConnectionStateRequestTimeout);
+}
+
+bool QKnxNetIpEndpointConnectionPrivate::readDatagram(QUdpSocket *socket, DatagramBuffer *buffer,
+    QKnxNetIpFrameView *frame)
+{
+    while (socket && socket->state() == QUdpSocket::BoundState && socket->hasPendingDatagrams()) {
+        const qint64 pendingSize = socket->pendingDatagramSize();
+        if (pendingSize > buffer->data.size())
+            buffer->data.resize(int(pendingSize));
+
+        const qint64 size = socket->readDatagram(buffer->data.data(), buffer->data.size(),
+            &buffer->senderAddress, &buffer->senderPort);
+        if (size < 0)
+            return false;
+
+        *frame = QKnxNetIpFrameView(reinterpret_cast<const quint8 *>(buffer->data.constData()),
+            quint16(size));
+        if (frame->isValid()) {
+            m_trace.record(QKnxNetIpFrameTrace::Direction::Received, buffer->data.constData(),
+                int(size));
+            qCDebug(QT_KNX_NETIP_FRAMES).noquote().nospace() << "Received: 0x"
+                << QByteArray::fromRawData(buffer->data.constData(), int(size)).toHex();
+            return true;
+        }
+    }
+    return false;
+}
+
+void QKnxNetIpEndpointConnectionPrivate::writeDatagram(QUdpSocket *socket, const char *data,
+    int size, const Endpoint &remote)
+{
+    m_trace.record(QKnxNetIpFrameTrace::Direction::Sent, data, size);
+    qCDebug(QT_KNX_NETIP_FRAMES).noquote().nospace() << "Sending: 0x"
+        << QByteArray::fromRawData(data, size).toHex();
+
+    socket->writeDatagram(data, size, remote.address, remote.port);
+}
+
+void QKnxNetIpEndpointConnectionPrivate::writeDatagram(QUdpSocket *socket,
+    const QByteArray &datagram, const Endpoint &remote)
+{
+    writeDatagram(socket, datagram.constData(), datagram.size(), remote);
+}
+
+void QKnxNetIpEndpointConnectionPrivate::sendAcknowledge(QKnxNetIp::ServiceType type,
+    quint8 sequenceCount)
+{
+    // frame header + connection header, built on the stack to avoid allocations per telegram
+    const quint8 ack[] = {
+        QKnxNetIpFrameHeader::HeaderSize10, QKnxNetIpFrameHeader::KnxNetIpVersion10,
+        quint8(quint16(type) >> 8), quint8(type),
+        0x00, 0x0a,
+        0x04, quint8(m_channelId), sequenceCount, quint8(QKnxNetIp::Error::None)
+    };
+    writeDatagram(m_dataEndpoint, reinterpret_cast<const char *>(ack), sizeof(ack),
+        m_remoteDataEndpoint);
+}
+
+void QKnxNetIpEndpointConnectionPrivate::process(const QKnxLinkLayerFrameView &frame)
+{
+    process(frame.toFrame());
 }
 
 void QKnxNetIpEndpointConnectionPrivate::process(const QKnxLinkLayerFrame &)
@@ -295,117 +563,134 @@ void QKnxNetIpEndpointConnectionPrivate::process(const QKnxLinkLayerFrame &)
 void QKnxNetIpEndpointConnectionPrivate::process(const QKnxLocalDeviceManagementFrame &)
 {}
 
-void QKnxNetIpEndpointConnectionPrivate::process(const QKnxNetIpTunnelingRequest &request)
+void QKnxNetIpEndpointConnectionPrivate::processTunnelingRequest(const QKnxNetIpFrameView &request)
 {
-    qDebug() << "Received tunneling request:" << request;
+    // a malformed request is dropped without acknowledge, the server repeats it and eventually
+    // closes the connection
+    if (!request.isValid() || request.connectionHeaderSize() != 4 || request.cemi().isEmpty()) {
+        qCDebug(QT_KNX_NETIP) << "Invalid tunneling request was ignored.";
+        return;
+    }
 
     if (request.channelId() == m_channelId) {
         if (bool counterEquals = (request.sequenceCount() == m_receiveCount)
-            || (request.sequenceCount() + 1 == m_receiveCount)) {
+            || (quint8(request.sequenceCount() + 1) == m_receiveCount)) {
                 // sequence equals -> acknowledge -> process frame
                 // sequence -1 -> acknowledge -> drop frame
-                auto ack = QKnxNetIpTunnelingAcknowledge(m_channelId, m_receiveCount,
-                    QKnxNetIp::Error::None);
-
-                qDebug() << "Sending tunneling acknowledge:" << ack;
-                m_dataEndpoint->writeDatagram(ack.bytes(), m_remoteDataEndpoint.address,
-                    m_remoteDataEndpoint.port);
+                qCDebug(QT_KNX_NETIP_FRAMES) << "Sending tunneling acknowledge, sequence count:"
+                    << request.sequenceCount();
+                sendAcknowledge(QKnxNetIp::ServiceType::TunnelingAcknowledge,
+                    request.sequenceCount());
 
                 if (!counterEquals)
                     return;
                 m_receiveCount++;
+                m_statistics.frameReceived();
                 process(request.cemi());
         }
     } else {
-        qDebug() << "Request was ignored due to wrong channel ID. Expected:" << m_channelId
-            << "Current:" << request.channelId();
+        qCDebug(QT_KNX_NETIP) << "Request was ignored due to wrong channel ID. Expected:"
+            << m_channelId << "Current:" << request.channelId();
     }
 }
 
-void QKnxNetIpEndpointConnectionPrivate::process(const QKnxNetIpTunnelingAcknowledge &acknowledge)
+void QKnxNetIpEndpointConnectionPrivate::processTunnelingAcknowledge(
+    const QKnxNetIpFrameView &acknowledge)
 {
-    qDebug() << "Received tunneling acknowledge:" << acknowledge;
-
     if (acknowledge.channelId() == m_channelId) {
-        m_acknowledgeTimer->stop();
+        if (!m_waitForAcknowledgement || acknowledge.sequenceCount() != m_sendCount) {
+            qCDebug(QT_KNX_NETIP)
+                << "Acknowledge was ignored due to wrong sequence count. Expected:"
+                << m_sendCount << "Current:" << acknowledge.sequenceCount();
+            return;
+        }
+
+        m_acknowledgeTimer.stop();
         m_waitForAcknowledgement = false;
-        if (acknowledge.status() == QKnxNetIp::Error::None
-            && acknowledge.sequenceCount() == m_sendCount) {
-                m_sendCount++;
-                m_cemiRequests = 0;
+        m_statistics.acknowledgeLatency.record(m_statistics.now() - m_cemiRequestSent);
+        if (QKnxNetIp::Error(acknowledge.serviceTypeSpecificValue()) == QKnxNetIp::Error::None) {
+            m_sendCount++;
+            m_cemiRequests = 0;
+            m_lastSendCemiRequest.clear();
+            sendNextCemiRequest();
         } else {
             sendCemiRequest();
         }
     } else {
-        qDebug() << "Acknowledge was ignored due to wrong channel ID. Expected:" << m_channelId
-            << "Current:" << acknowledge.channelId();
+        qCDebug(QT_KNX_NETIP) << "Acknowledge was ignored due to wrong channel ID. Expected:"
+            << m_channelId << "Current:" << acknowledge.channelId();
     }
 }
 
 bool QKnxNetIpEndpointConnectionPrivate::sendTunnelingRequest(const QKnxLinkLayerFrame &frame)
 {
-    m_lastSendCemiRequest = QKnxNetIpTunnelingRequest(m_channelId, m_sendCount, frame).bytes();
-    qDebug().noquote().nospace() << "Sending tunneling request: 0x" << m_lastSendCemiRequest.toHex();
-
-    return sendCemiRequest();
+    return enqueueCemiRequest(QKnxNetIpTunnelingRequest(m_channelId, m_sendCount, frame).bytes(),
+        frame.controlField().priority());
 }
 
 void QKnxNetIpEndpointConnectionPrivate::process(const QKnxNetIpDeviceConfigurationRequest &request)
 {
-    qDebug() << "Received device configuration request:" << request;
+    qCDebug(QT_KNX_NETIP_FRAMES) << "Received device configuration request:" << request;
 
     if (request.channelId() == m_channelId) {
         if (request.sequenceCount() == m_receiveCount) {
                 auto ack = QKnxNetIpDeviceConfigurationAcknowledge(m_channelId, m_receiveCount,
                     QKnxNetIp::Error::None);
 
-                qDebug() << "Sending device configuration acknowledge:" << ack;
-                m_dataEndpoint->writeDatagram(ack.bytes(), m_remoteDataEndpoint.address,
-                    m_remoteDataEndpoint.port);
+                qCDebug(QT_KNX_NETIP_FRAMES) << "Sending device configuration acknowledge:" << ack;
+                writeDatagram(m_dataEndpoint, ack.bytes(), m_remoteDataEndpoint);
 
                 m_receiveCount++;
+                m_statistics.frameReceived();
                 if (m_waitForAcknowledgement)
                     m_lastReceivedCemiRequest = request.cemi().bytes();
                 else
                     process(request.cemi());
         }
     } else {
-        qDebug() << "Request was ignored due to wrong channel ID. Expected:" << m_channelId
-            << "Current:" << request.channelId();
+        qCDebug(QT_KNX_NETIP) << "Request was ignored due to wrong channel ID. Expected:"
+            << m_channelId << "Current:" << request.channelId();
     }
 }
 
 void QKnxNetIpEndpointConnectionPrivate::process(const QKnxNetIpDeviceConfigurationAcknowledge &ack)
 {
-    qDebug() << "Received device configuration acknowledge:" << ack;
+    qCDebug(QT_KNX_NETIP_FRAMES) << "Received device configuration acknowledge:" << ack;
 
     if (ack.channelId() == m_channelId) {
-        m_acknowledgeTimer->stop();
+        if (!m_waitForAcknowledgement || ack.sequenceCount() != m_sendCount) {
+            qCDebug(QT_KNX_NETIP)
+                << "Acknowledge was ignored due to wrong sequence count. Expected:"
+                << m_sendCount << "Current:" << ack.sequenceCount();
+            return;
+        }
+
+        m_acknowledgeTimer.stop();
         m_waitForAcknowledgement = false;
-        if (ack.status() == QKnxNetIp::Error::None
-            && ack.sequenceCount() == m_sendCount) {
+        m_statistics.acknowledgeLatency.record(m_statistics.now() - m_cemiRequestSent);
+        if (ack.status() == QKnxNetIp::Error::None) {
                 m_sendCount++;
                 m_cemiRequests = 0;
+                m_lastSendCemiRequest.clear();
                 if (!m_lastReceivedCemiRequest.isEmpty()) {
                      process(QKnxLocalDeviceManagementFrame::fromBytes(m_lastReceivedCemiRequest, 0,
                          m_lastReceivedCemiRequest.size()));
                      m_lastReceivedCemiRequest.clear();
                 }
+                sendNextCemiRequest();
         } else {
             sendCemiRequest();
         }
     } else {
-        qDebug() << "Acknowledge was ignored due to wrong channel ID. Expected:" << m_channelId
-            << "Current:" << ack.channelId();
+        qCDebug(QT_KNX_NETIP) << "Acknowledge was ignored due to wrong channel ID. Expected:"
+            << m_channelId << "Current:" << ack.channelId();
     }
 }
 
 bool QKnxNetIpEndpointConnectionPrivate::sendDeviceConfigurationRequest(const QKnxLocalDeviceManagementFrame &frame)
 {
-    m_lastSendCemiRequest = QKnxNetIpDeviceConfigurationRequest(m_channelId, m_sendCount, frame).bytes();
-    qDebug().noquote().nospace() << "Sending device configuration request: 0x" << m_lastSendCemiRequest
-        .toHex();
-    return sendCemiRequest();
+    return enqueueCemiRequest(QKnxNetIpDeviceConfigurationRequest(m_channelId, m_sendCount, frame)
+        .bytes(), QKnxControlField::Priority::System);
 }
 
 namespace QKnxPrivate
@@ -419,11 +704,11 @@ namespace QKnxPrivate
 void QKnxNetIpEndpointConnectionPrivate::process(const QKnxNetIpConnectResponse &response,
     const QNetworkDatagram &datagram)
 {
-    qDebug() << "Received connect response:" << response;
+    qCDebug(QT_KNX_NETIP) << "Received connect response:" << response;
 
     if (m_state == QKnxNetIpEndpointConnection::State::Connecting) {
         if (response.status() == QKnxNetIp::Error::None) {
-            QKnxPrivate::clearTimer(&m_connectRequestTimer);
+            m_connectRequestTimer.stop();
 
             m_channelId = response.channelId();
             m_remoteDataEndpoint = response.dataEndpoint();
@@ -438,67 +723,67 @@ void QKnxNetIpEndpointConnectionPrivate::process(const QKnxNetIpConnectResponse
             m_lastStateRequest = QKnxNetIpConnectionStateRequest(m_channelId,
                 m_nat ? m_natEndpoint : m_localControlEndpoint).bytes();
 
+            m_reconnectAttempts = 0;
             QTimer::singleShot(0, [&]() { sendStateRequest(); });
             setAndEmitStateChanged(QKnxNetIpEndpointConnection::State::Connected);
+            startStatisticsTimer();
         } else {
             setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Acknowledge,
                 QKnxNetIpEndpointConnection::tr("Could not connect to remote control endpoint. "
                     "Error code: 0x%1").arg(quint8(response.status()), 2, 16, QLatin1Char('0')));
 
-            Q_Q(QKnxNetIpEndpointConnection);
-            q->disconnectFromHost();
+            // e.g. NoMoreUniqueConnections, the server might accept us again later
+            disconnectAndReconnect();
         }
     } else {
-        qDebug() << "Response was ignored due to current state. Expected:"
+        qCDebug(QT_KNX_NETIP) << "Response was ignored due to current state. Expected:"
             << QKnxNetIpEndpointConnection::State::Connecting << "Current:" << m_state;
     }
 }
 
 void QKnxNetIpEndpointConnectionPrivate::process(const QKnxNetIpConnectionStateResponse &response)
 {
-    qDebug() << "Received connection state response:" << response;
+    qCDebug(QT_KNX_NETIP) << "Received connection state response:" << response;
 
     if (response.channelId() == m_channelId) {
         if (response.status() == QKnxNetIp::Error::None) {
+            m_statistics.heartbeatLatency.record(m_statistics.now() - m_stateRequestSent);
             m_stateRequests = 0;
-            m_connectionStateTimer->stop();
-            m_heartbeatTimer->start(m_heartbeatTimeout);
-        } else if (!m_connectionStateTimer->isActive()) {
+            m_connectionStateTimer.stop();
+            m_heartbeatTimer.start(m_heartbeatTimeout);
+        } else if (!m_connectionStateTimer.isActive()) {
             sendStateRequest();
         }
     } else {
-        qDebug() << "Response was ignored due to wrong channel ID. Expected:" << m_channelId
-            << "Current:" << response.channelId();
+        qCDebug(QT_KNX_NETIP) << "Response was ignored due to wrong channel ID. Expected:"
+            << m_channelId << "Current:" << response.channelId();
     }
 }
 
 void QKnxNetIpEndpointConnectionPrivate::process(const QKnxNetIpDisconnectRequest &request)
 {
-    qDebug() << "Received disconnect request:" << request;
+    qCDebug(QT_KNX_NETIP) << "Received disconnect request:" << request;
 
     if (request.channelId() == m_channelId) {
         auto response = QKnxNetIpDisconnectResponse(m_channelId, QKnxNetIp::Error::None);
-        qDebug() << "Sending disconnect response:" << response;
-        m_controlEndpoint->writeDatagram(response.bytes(), m_remoteControlEndpoint.address,
-            m_remoteControlEndpoint.port);
-
-        Q_Q(QKnxNetIpEndpointConnection);
-        q->disconnectFromHost();
+        qCDebug(QT_KNX_NETIP) << "Sending disconnect response:" << response;
+        writeDatagram(m_controlEndpoint, response.bytes(), m_remoteControlEndpoint);
+        closeAndReconnect();
     } else {
-        qDebug() << "Response was ignored due to wrong channel ID. Expected:" << m_channelId
-            << "Current:" << request.channelId();
+        qCDebug(QT_KNX_NETIP) << "Response was ignored due to wrong channel ID. Expected:"
+            << m_channelId << "Current:" << request.channelId();
     }
 }
 
 void QKnxNetIpEndpointConnectionPrivate::process(const QKnxNetIpDisconnectResponse &response)
 {
-    qDebug() << "Received disconnect response:" << response;
+    qCDebug(QT_KNX_NETIP) << "Received disconnect response:" << response;
 
     if (response.channelId() == m_channelId) {
         cleanup();
     } else {
-        qDebug() << "Response was ignored due to wrong channel ID. Expected:" << m_channelId
-            << "Current:" << response.channelId();
+        qCDebug(QT_KNX_NETIP) << "Response was ignored due to wrong channel ID. Expected:"
+            << m_channelId << "Current:" << response.channelId();
     }
 }
 
@@ -535,6 +820,8 @@ void QKnxNetIpEndpointConnectionPrivate::setAndEmitErrorOccurred(
 
 QKnxNetIpEndpointConnection::~QKnxNetIpEndpointConnection()
 {
+    Q_D(QKnxNetIpEndpointConnection);
+    d->m_autoReconnect = false;
     disconnectFromHost();
 }
 
@@ -608,6 +895,40 @@ void QKnxNetIpEndpointConnection::setNatAware(bool isAware)
     d->m_user.natAware = isAware;
 }
 
+/*!
+    Returns \c true if the control and data endpoint share one UDP socket;
+    \c false otherwise. While disconnected, the value that the next
+    \l connectToHost() will use is returned, which is always \c true for NAT
+    aware connections.
+
+    \sa setSingleSocket(), natAware()
+*/
+bool QKnxNetIpEndpointConnection::singleSocket() const
+{
+    Q_D(const QKnxNetIpEndpointConnection);
+    if (d->m_state == QKnxNetIpEndpointConnection::Disconnected)
+        return d->m_user.singleSocket || d->m_user.natAware;
+    return d->m_singleSocket;
+}
+
+/*!
+    Sets whether the control and data endpoint share one UDP socket to
+    \a single. The default is \c false. The setting takes effect on the next
+    call to \l connectToHost().
+
+    The connection then needs only one socket, and frames for both endpoints
+    are told apart by their service type. NAT aware connections always use a
+    single socket, because the KNXnet/IP server sends all frames to the address
+    and port the connect request came from.
+
+    \sa natAware()
+*/
+void QKnxNetIpEndpointConnection::setSingleSocket(bool single)
+{
+    Q_D(QKnxNetIpEndpointConnection);
+    d->m_user.singleSocket = single;
+}
+
 quint32 QKnxNetIpEndpointConnection::heartbeatTimeout() const
 {
     Q_D(const QKnxNetIpEndpointConnection);
@@ -621,8 +942,7 @@ void QKnxNetIpEndpointConnection::setHeartbeatTimeout(quint32 msec)
 
     Q_D(QKnxNetIpEndpointConnection);
     d->m_heartbeatTimeout = msec;
-    if (d->m_heartbeatTimer)
-        d->m_heartbeatTimer->setInterval(msec);
+    d->m_heartbeatTimer.setInterval(msec);
 }
 
 QVector<quint8> QKnxNetIpEndpointConnection::supportedProtocolVersions() const
@@ -639,6 +959,279 @@ void QKnxNetIpEndpointConnection::setSupportedProtocolVersions(const QVector<qui
     d->m_user.supportedVersions = versions;
 }
 
+/*!
+    Returns the number of cEMI frames waiting in the send queue. The frame that
+    was sent and waits for its acknowledge is not counted.
+
+    \sa sendQueueSizeChanged(), maximumSendQueueSize()
+*/
+int QKnxNetIpEndpointConnection::sendQueueSize() const
+{
+    Q_D(const QKnxNetIpEndpointConnection);
+    return d->sendQueueSize();
+}
+
+/*!
+    Returns the maximum number of cEMI frames the send queue holds while a
+    previous frame waits for its acknowledge. The default is \c 64.
+
+    Frames leave the queue by priority, system priority first and low priority
+    last, and in the order they were sent within the same priority.
+
+    \sa setMaximumSendQueueSize(), droppedFrameCount()
+*/
+int QKnxNetIpEndpointConnection::maximumSendQueueSize() const
+{
+    Q_D(const QKnxNetIpEndpointConnection);
+    return d->m_maxSendQueueSize;
+}
+
+/*!
+    Sets the maximum number of frames in the send queue to \a size. Values
+    smaller than \c 1 are ignored, because a frame has to pass the queue even
+    if no other frame is waiting for its acknowledge.
+
+    Frames that are sent while the queue is full are dropped and the
+    \l frameDropped() signal is emitted.
+
+    \sa maximumSendQueueSize()
+*/
+void QKnxNetIpEndpointConnection::setMaximumSendQueueSize(int size)
+{
+    if (size < 1)
+        return;
+
+    Q_D(QKnxNetIpEndpointConnection);
+    d->m_maxSendQueueSize = size;
+}
+
+/*!
+    Returns the number of frames dropped since the connection was created. A
+    frame is dropped if the send queue is full when it is sent, or if it is
+    still queued when the connection is closed. The \l frameDropped() signal
+    is emitted once for every dropped frame in both cases.
+*/
+quint32 QKnxNetIpEndpointConnection::droppedFrameCount() const
+{
+    Q_D(const QKnxNetIpEndpointConnection);
+    return d->m_droppedFrames;
+}
+
+/*!
+    \fn void QKnxNetIpEndpointConnection::sendQueueSizeChanged(int size)
+
+    This signal is emitted when a frame enters or leaves the send queue, with
+    \a size being the new number of queued frames. A producer can use it to
+    pause sending while the queue fills up.
+
+    \sa sendQueueSize(), maximumSendQueueSize()
+*/
+
+/*!
+    \fn void QKnxNetIpEndpointConnection::frameDropped()
+
+    This signal is emitted for each frame that is dropped, either because the
+    send queue was full or because the frame was still queued when the
+    connection was closed.
+
+    \sa droppedFrameCount()
+*/
+
+/*!
+    Returns the size in bytes of the ring buffer that records the raw frames sent and received
+    by this connection. The default value is \c 0, meaning no frames are recorded.
+*/
+int QKnxNetIpEndpointConnection::frameTraceCapacity() const
+{
+    Q_D(const QKnxNetIpEndpointConnection);
+    return d->m_trace.capacity();
+}
+
+/*!
+    Sets the size in \a bytes of the frame trace ring buffer and discards all recorded frames.
+    Once the buffer is full, the oldest frames are overwritten. Setting the capacity to \c 0
+    disables the trace.
+
+    \sa frameTrace()
+*/
+void QKnxNetIpEndpointConnection::setFrameTraceCapacity(int bytes)
+{
+    Q_D(QKnxNetIpEndpointConnection);
+    d->m_trace.setCapacity(bytes);
+}
+
+/*!
+    Returns the recorded frames, oldest first. Each record starts with an eleven byte header
+    holding the time stamp in microseconds since epoch (64 bit), the direction (\c 0 received,
+    \c 1 sent) and the size of the frame (16 bit), both integers in little endian byte order,
+    followed by the frame bytes.
+
+    \sa setFrameTraceCapacity()
+*/
+QByteArray QKnxNetIpEndpointConnection::frameTrace() const
+{
+    Q_D(const QKnxNetIpEndpointConnection);
+    return d->m_trace.toByteArray();
+}
+
+/*!
+    Returns a snapshot of the traffic and latency counters of this connection.
+
+    The counters are updated atomically, so unlike the rest of this class the function may be
+    called from any thread while the connection is running.
+*/
+QKnxNetIpConnectionStatistics QKnxNetIpEndpointConnection::statistics() const
+{
+    Q_D(const QKnxNetIpEndpointConnection);
+    return d->m_statistics.snapshot();
+}
+
+/*!
+    Returns the interval in milliseconds at which statisticsUpdated() is emitted while the
+    connection is established. The default value is \c 0, meaning the signal is not emitted.
+*/
+int QKnxNetIpEndpointConnection::statisticsInterval() const
+{
+    Q_D(const QKnxNetIpEndpointConnection);
+    return d->m_statisticsInterval;
+}
+
+/*!
+    Sets the interval at which statisticsUpdated() is emitted to \a msec milliseconds. A
+    value of \c 0 disables the signal.
+*/
+void QKnxNetIpEndpointConnection::setStatisticsInterval(int msec)
+{
+    if (msec < 0)
+        return;
+
+    Q_D(QKnxNetIpEndpointConnection);
+    d->m_statisticsInterval = msec;
+    d->startStatisticsTimer();
+}
+
+/*!
+    Returns \c true if the connection reconnects automatically after it was
+    refused or lost; \c false otherwise.
+
+    \sa setAutoReconnect()
+*/
+bool QKnxNetIpEndpointConnection::autoReconnect() const
+{
+    Q_D(const QKnxNetIpEndpointConnection);
+    return d->m_autoReconnect;
+}
+
+/*!
+    Enables automatic reconnection if \a enabled is \c true. The default is
+    \c false.
+
+    With automatic reconnection enabled, the connection tries to connect to the
+    same KNXnet/IP server again after it was refused, for example with
+    \l QKnxNetIp::Error::NoMoreUniqueConnections, or lost because of a heartbeat
+    or acknowledge timeout, a network error, or a disconnect request sent by the
+    server. A call to \l disconnectFromHost() stops reconnecting.
+
+    The delay before each attempt doubles, starting at \l reconnectInterval()
+    and limited by \l maximumReconnectInterval(). Half of the delay is chosen at
+    random, so that several clients do not reconnect at the same time after the
+    server restarts. The \l reconnecting() signal is emitted for each attempt.
+
+    \sa maximumReconnectAttempts()
+*/
+void QKnxNetIpEndpointConnection::setAutoReconnect(bool enabled)
+{
+    Q_D(QKnxNetIpEndpointConnection);
+    d->m_autoReconnect = enabled;
+    if (!enabled)
+        d->m_reconnectTimer.stop();
+}
+
+/*!
+    Returns the number of reconnect attempts made before giving up. The default
+    is \c 10. A value of \c 0 means there is no limit.
+
+    When the last attempt fails, the \l errorOccurred() signal is emitted with
+    \l {QKnxNetIpEndpointConnection::Error}{Error::Reconnect}.
+*/
+int QKnxNetIpEndpointConnection::maximumReconnectAttempts() const
+{
+    Q_D(const QKnxNetIpEndpointConnection);
+    return d->m_maxReconnectAttempts;
+}
+
+/*!
+    Sets the number of reconnect attempts made before giving up to \a attempts.
+    A value of \c 0 means there is no limit, negative values are ignored.
+
+    \sa maximumReconnectAttempts(), setAutoReconnect()
+*/
+void QKnxNetIpEndpointConnection::setMaximumReconnectAttempts(int attempts)
+{
+    if (attempts < 0)
+        return;
+
+    Q_D(QKnxNetIpEndpointConnection);
+    d->m_maxReconnectAttempts = attempts;
+}
+
+/*!
+    Returns the delay in milliseconds before the first reconnect attempt. The
+    default is \c 1000.
+
+    \sa setReconnectInterval(), maximumReconnectInterval()
+*/
+quint32 QKnxNetIpEndpointConnection::reconnectInterval() const
+{
+    Q_D(const QKnxNetIpEndpointConnection);
+    return d->m_reconnectInterval;
+}
+
+/*!
+    Sets the delay before the first reconnect attempt to \a msec milliseconds.
+    The delay doubles with each further attempt.
+
+    \sa reconnectInterval()
+*/
+void QKnxNetIpEndpointConnection::setReconnectInterval(quint32 msec)
+{
+    Q_D(QKnxNetIpEndpointConnection);
+    d->m_reconnectInterval = msec;
+}
+
+/*!
+    Returns the upper limit in milliseconds of the delay between two reconnect
+    attempts. The default is \c 60000.
+
+    \sa setMaximumReconnectInterval(), reconnectInterval()
+*/
+quint32 QKnxNetIpEndpointConnection::maximumReconnectInterval() const
+{
+    Q_D(const QKnxNetIpEndpointConnection);
+    return d->m_maxReconnectInterval;
+}
+
+/*!
+    Sets the upper limit of the delay between two reconnect attempts to \a msec
+    milliseconds.
+
+    \sa maximumReconnectInterval()
+*/
+void QKnxNetIpEndpointConnection::setMaximumReconnectInterval(quint32 msec)
+{
+    Q_D(QKnxNetIpEndpointConnection);
+    d->m_maxReconnectInterval = msec;
+}
+
+/*!
+    \fn void QKnxNetIpEndpointConnection::reconnecting(int attempt, int msec)
+
+    This signal is emitted when the reconnect attempt number \a attempt is
+    scheduled to start in \a msec milliseconds.
+
+    \sa setAutoReconnect()
+*/
+
 void QKnxNetIpEndpointConnection::connectToHost(const QKnxNetIpHpai &controlEndpoint)
 {
     connectToHost(controlEndpoint.address(), controlEndpoint.port());
@@ -651,6 +1244,8 @@ void QKnxNetIpEndpointConnection::connectToHost(const QHostAddress &address, qui
     if (d->m_state != State::Disconnected)
         return;
 
+    d->m_reconnectTimer.stop();
+
     auto isIPv4 = false;
     address.toIPv4Address(&isIPv4);
     if (!isIPv4) {
@@ -683,19 +1278,27 @@ void QKnxNetIpEndpointConnection::connectToHost(const QHostAddress &address, qui
     d->m_controlEndpoint = socket;
     d->m_localControlEndpoint = Endpoint(socket->localAddress(), socket->localPort());
 
-    socket = new QUdpSocket(this);
-    QKnxPrivate::clearSocket(&(d->m_dataEndpoint));
-    if (!socket->bind(d->m_localControlEndpoint.address, 0)) {
-        d->setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Network,
-            QKnxNetIpEndpointConnection::tr("Could not bind local data endpoint: %1")
-                .arg(socket->errorString()));
-        QKnxPrivate::clearSocket(&socket);
-        QKnxPrivate::clearSocket(&(d->m_controlEndpoint));
-        d->setAndEmitStateChanged(QKnxNetIpEndpointConnection::State::Disconnected);
-        return;
+    // In NAT mode the server sends to the address and port the connect request came from, so
+    // data can only be received if it shares the socket with the control endpoint.
+    d->m_singleSocket = d->m_user.singleSocket || d->m_user.natAware;
+    if (d->m_singleSocket) {
+        d->m_dataEndpoint = socket;
+        d->m_localDataEndpoint = d->m_localControlEndpoint;
+    } else {
+        socket = new QUdpSocket(this);
+        QKnxPrivate::clearSocket(&(d->m_dataEndpoint));
+        if (!socket->bind(d->m_localControlEndpoint.address, 0)) {
+            d->setAndEmitErrorOccurred(QKnxNetIpEndpointConnection::Error::Network,
+                QKnxNetIpEndpointConnection::tr("Could not bind local data endpoint: %1")
+                    .arg(socket->errorString()));
+            QKnxPrivate::clearSocket(&socket);
+            QKnxPrivate::clearSocket(&(d->m_controlEndpoint));
+            d->setAndEmitStateChanged(QKnxNetIpEndpointConnection::State::Disconnected);
+            return;
+        }
+        d->m_dataEndpoint = socket;
+        d->m_localDataEndpoint = Endpoint(socket->localAddress(), socket->localPort());
     }
-    d->m_dataEndpoint = socket;
-    d->m_localDataEndpoint = Endpoint(socket->localAddress(), socket->localPort());
 
     d->setAndEmitStateChanged(QKnxNetIpEndpointConnection::State::Bound);
 
@@ -704,23 +1307,25 @@ void QKnxNetIpEndpointConnection::connectToHost(const QHostAddress &address, qui
     d->setAndEmitStateChanged(QKnxNetIpEndpointConnection::State::Connecting);
 
     auto request = QKnxNetIpConnectRequest(d->m_nat ? d->m_natEndpoint : d->m_localControlEndpoint,
-        // TODO: Fix this. It cannot work in NAT mode, because the sever does not know the data
-        // endpoint address if we pass a NAT endpoint. The most likely solution will be to use a
-        // single socket for control and data endpoint...
         d->m_nat ? d->m_natEndpoint : d->m_localDataEndpoint, d->m_cri);
     d->m_controlEndpointVersion = request.header().protocolVersion();
 
-    qDebug() << "Sending connect request:" << request;
+    qCDebug(QT_KNX_NETIP) << "Sending connect request:" << request;
 
-    d->m_connectRequestTimer->start(QKnxNetIp::ConnectRequestTimeout);
-    d->m_controlEndpoint->writeDatagram(request.bytes(), d->m_remoteControlEndpoint.address,
-        d->m_remoteControlEndpoint.port);
+    d->m_connectRequestTimer.start(QKnxNetIp::ConnectRequestTimeout);
+    d->writeDatagram(d->m_controlEndpoint, request.bytes(), d->m_remoteControlEndpoint);
 }
 
 void QKnxNetIpEndpointConnection::disconnectFromHost()
 {
     Q_D(QKnxNetIpEndpointConnection);
 
+    d->m_reconnectPending = false;
+    if (d->m_reconnectTimer.isActive()) {
+        d->m_reconnectTimer.stop();
+        d->m_reconnectAttempts = 0;
+    }
+
     if (d->m_state == State::Disconnecting || d->m_state == State::Disconnected)
         return;
 
@@ -735,11 +1340,10 @@ void QKnxNetIpEndpointConnection::disconnectFromHost()
             }
         );
 
-        qDebug() << "Sending disconnect request:" << request;
-        d->m_controlEndpoint->writeDatagram(request.bytes(), d->m_remoteControlEndpoint.address,
-            d->m_remoteControlEndpoint.port);
+        qCDebug(QT_KNX_NETIP) << "Sending disconnect request:" << request;
+        d->writeDatagram(d->m_controlEndpoint, request.bytes(), d->m_remoteControlEndpoint);
 
-        d->m_disconnectRequestTimer->start(QKnxNetIp::DisconnectRequestTimeout);
+        d->m_disconnectRequestTimer.start(QKnxNetIp::DisconnectRequestTimeout);
         // Fully disconnected will be handled inside the private cleanup function.
     }
 }
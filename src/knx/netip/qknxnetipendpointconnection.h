@@ -31,6 +31,7 @@
 #define QKNXNETIPENDPOINTCONNECTION_H
 
 #include <QtKnx/qknxglobal.h>
+#include <QtKnx/qknxnetipconnectionstatistics.h>
 #include <QtKnx/qknxnetipcri.h>
 #include <QtKnx/qknxnetiphpai.h>
 #include <QtKnx/qknxnetipframe.h>
@@ -69,6 +70,7 @@ public:
         Acknowledge,
         Heartbeat,
         Cemi,
+        Reconnect,
         Unknown = 0x80
     };
     Q_ENUM(Error)
@@ -103,12 +105,40 @@ public:
     bool natAware() const;
     void setNatAware(bool isAware);
 
+    bool singleSocket() const;
+    void setSingleSocket(bool single);
+
     quint32 heartbeatTimeout() const;
     void setHeartbeatTimeout(quint32 msec);
 
     QVector<quint8> supportedProtocolVersions() const;
     void setSupportedProtocolVersions(const QVector<quint8> &versions);
 
+    int sendQueueSize() const;
+    int maximumSendQueueSize() const;
+    void setMaximumSendQueueSize(int size);
+    quint32 droppedFrameCount() const;
+
+    int frameTraceCapacity() const;
+    void setFrameTraceCapacity(int bytes);
+    QByteArray frameTrace() const;
+
+    QKnxNetIpConnectionStatistics statistics() const;
+    int statisticsInterval() const;
+    void setStatisticsInterval(int msec);
+
+    bool autoReconnect() const;
+    void setAutoReconnect(bool enabled);
+
+    int maximumReconnectAttempts() const;
+    void setMaximumReconnectAttempts(int attempts);
+
+    quint32 reconnectInterval() const;
+    void setReconnectInterval(quint32 msec);
+
+    quint32 maximumReconnectInterval() const;
+    void setMaximumReconnectInterval(quint32 msec);
+
     void connectToHost(const QKnxNetIpHpai &controlEndpoint);
     void connectToHost(const QHostAddress &address, quint16 port);
 
@@ -123,6 +153,13 @@ Q_SIGNALS:
 
     void stateChanged(QKnxNetIpEndpointConnection::State state);
     void errorOccurred(QKnxNetIpEndpointConnection::Error error, QString errorString);
+
+    void sendQueueSizeChanged(int size);
+    void frameDropped();
+
+    void reconnecting(int attempt, int msec);
+
+    void statisticsUpdated(const QKnxNetIpConnectionStatistics &statistics);
 };
 
 QT_END_NAMESPACE
@@ -41,14 +41,21 @@
 // We mean it.
 //
 
+#include <QtCore/qqueue.h>
 #include <QtCore/qtimer.h>
 #include <QtKnx/qknxaddress.h>
+#include <QtKnx/qknxcontrolfield.h>
 #include <QtKnx/qknxglobal.h>
 #include <QtKnx/qknxnetipendpointconnection.h>
 #include <QtNetwork/qhostaddress.h>
 #include <QtKnx/qknxlocaldevicemanagementframe.h>
 #include <QtKnx/qknxlinklayerframe.h>
 
+#include <private/qknxlinklayerframeview_p.h>
+#include <private/qknxnetipconnectionstatistics_p.h>
+#include <private/qknxnetipframeview_p.h>
+#include <private/qknxnetiptrace_p.h>
+#include <private/qknxtimerwheel_p.h>
 #include <private/qobject_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -59,14 +66,13 @@ class QKnxNetIpDeviceConfigurationAcknowledge;
 class QKnxNetIpDeviceConfigurationRequest;
 class QKnxNetIpDisconnectRequest;
 class QKnxNetIpDisconnectResponse;
-class QKnxNetIpTunnelingAcknowledge;
-class QKnxNetIpTunnelingRequest;
 class QUdpSocket;
 
 struct UserProperties
 {
     quint16 port { 0 };
     bool natAware { false };
+    bool singleSocket { false };
     QHostAddress address { QHostAddress::LocalHost };
     QVector<quint8> supportedVersions  { QKnxNetIpFrameHeader::KnxNetIpVersion10 };
 };
@@ -97,6 +103,19 @@ struct Endpoint final
     quint16 port { 0 };
 };
 
+struct QueuedRequest final
+{
+    QByteArray bytes;
+    qint64 enqueued { 0 }; // microseconds, see QKnxNetIpConnectionStatisticsRecorder::now()
+};
+
+struct DatagramBuffer final
+{
+    QByteArray data;
+    QHostAddress senderAddress;
+    quint16 senderPort { 0 };
+};
+
 class Q_KNX_EXPORT QKnxNetIpEndpointConnectionPrivate : public QObjectPrivate
 {
     Q_DECLARE_PUBLIC(QKnxNetIpEndpointConnection)
@@ -118,13 +137,34 @@ public:
     bool sendCemiRequest();
     void sendStateRequest();
 
+    bool enqueueCemiRequest(const QByteArray &request, QKnxControlField::Priority priority);
+    void sendNextCemiRequest();
+    void clearSendQueue();
+    int sendQueueSize() const;
+
+    void startStatisticsTimer();
+
+    void disconnectAndReconnect();
+    void closeAndReconnect();
+    void scheduleReconnect();
+    void reconnect();
+
+    void processDataFrame(const QKnxNetIpFrameView &frame, const DatagramBuffer &buffer);
+    void processControlFrame(const QKnxNetIpFrameView &frame, const DatagramBuffer &buffer);
+
+    bool readDatagram(QUdpSocket *socket, DatagramBuffer *buffer, QKnxNetIpFrameView *frame);
+    void writeDatagram(QUdpSocket *socket, const char *data, int size, const Endpoint &remote);
+    void writeDatagram(QUdpSocket *socket, const QByteArray &datagram, const Endpoint &remote);
+    void sendAcknowledge(QKnxNetIp::ServiceType type, quint8 sequenceCount);
+
+    virtual void process(const QKnxLinkLayerFrameView &frame);
     virtual void process(const QKnxLinkLayerFrame &frame);
     virtual void process(const QKnxLocalDeviceManagementFrame &frame);
 
     // datapoint related processing
     bool sendTunnelingRequest(const QKnxLinkLayerFrame &frame);
-    virtual void process(const QKnxNetIpTunnelingRequest &);
-    virtual void process(const QKnxNetIpTunnelingAcknowledge &);
+    virtual void processTunnelingRequest(const QKnxNetIpFrameView &request);
+    virtual void processTunnelingAcknowledge(const QKnxNetIpFrameView &acknowledge);
 
     bool sendDeviceConfigurationRequest(const QKnxLocalDeviceManagementFrame &frame);
     virtual void process(const QKnxNetIpDeviceConfigurationRequest &);
@@ -162,11 +202,27 @@ private:
     QByteArray m_lastSendCemiRequest {};
     QByteArray m_lastReceivedCemiRequest {};
 
+    // one queue per KNX priority, ordered system, urgent, normal, low
+    QQueue<QueuedRequest> m_sendQueues[4];
+    int m_maxSendQueueSize { 64 };
+    quint32 m_droppedFrames { 0 };
+
+    // raw frames sent and received, disabled unless a capacity is set
+    QKnxNetIpFrameTrace m_trace;
+
+    // counters are atomic, statistics() may be called from any thread
+    QKnxNetIpConnectionStatisticsRecorder m_statistics;
+    qint64 m_cemiRequestSent { 0 };
+    qint64 m_stateRequestSent { 0 };
+    int m_statisticsInterval { 0 };
+    QKnxWheelTimer m_statisticsTimer;
+
     int m_stateRequests { 0 };
     const int m_maxStateRequests = { 3 };
     QByteArray m_lastStateRequest {};
 
     bool m_nat { false };
+    bool m_singleSocket { false };
     quint32 m_heartbeatTimeout { QKnxNetIp::HeartbeatTimeout };
     QVector<quint8> m_supportedVersions { QKnxNetIpFrameHeader::KnxNetIpVersion10 };
 
@@ -177,16 +233,28 @@ private:
     QKnxNetIpEndpointConnection::Error m_error = QKnxNetIpEndpointConnection::Error::None;
     QKnxNetIpEndpointConnection::State m_state = QKnxNetIpEndpointConnection::State::Disconnected;
 
-    QTimer *m_heartbeatTimer { nullptr };
-    QTimer *m_connectRequestTimer { nullptr };
-    QTimer *m_connectionStateTimer { nullptr };
-    QTimer *m_disconnectRequestTimer { nullptr };
-    QTimer *m_acknowledgeTimer { nullptr };
+    QKnxWheelTimer m_heartbeatTimer;
+    QKnxWheelTimer m_connectRequestTimer;
+    QKnxWheelTimer m_connectionStateTimer;
+    QKnxWheelTimer m_disconnectRequestTimer;
+    QKnxWheelTimer m_acknowledgeTimer;
     bool m_waitForAcknowledgement { false };
 
+    // reconnect handling after connection loss or a refused connect request
+    bool m_autoReconnect { false };
+    bool m_reconnectPending { false };
+    int m_reconnectAttempts { 0 };
+    int m_maxReconnectAttempts { 10 };
+    quint32 m_reconnectInterval { 1000 };
+    quint32 m_maxReconnectInterval { 60000 };
+    QKnxWheelTimer m_reconnectTimer;
+
     QUdpSocket *m_dataEndpoint { nullptr };
     QUdpSocket *m_controlEndpoint { nullptr };
 
+    DatagramBuffer m_dataBuffer;
+    DatagramBuffer m_controlBuffer;
+
     UserProperties m_user;
 };
 
@@ -0,0 +1,122 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPFRAMEVIEW_P_H
+#define QKNXNETIPFRAMEVIEW_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qbytearray.h>
+#include <QtKnx/qknxglobal.h>
+#include <QtKnx/qknxnetip.h>
+#include <QtKnx/qknxnetipframeheader.h>
+
+#include <private/qknxlinklayerframeview_p.h>
+
+QT_BEGIN_NAMESPACE
+
+// Non-owning view over a received KNXnet/IP frame, usually pointing into the receive buffer of
+// an endpoint socket. Accessing the frame header or connection header does not allocate, the view
+// is only valid as long as the underlying buffer is not modified.
+class QKnxNetIpFrameView final
+{
+public:
+    QKnxNetIpFrameView() = default;
+    QKnxNetIpFrameView(const quint8 *data, quint16 size)
+        : m_data(data)
+        , m_size(data ? size : 0)
+    {}
+
+    const quint8 *data() const { return m_data; }
+    quint16 size() const { return m_size; }
+
+    quint8 byte(quint16 index) const
+    {
+        return (index < m_size ? m_data[index] : quint8(0));
+    }
+
+    bool isValid() const
+    {
+        return m_size >= QKnxNetIpFrameHeader::HeaderSize10
+            && headerSize() == QKnxNetIpFrameHeader::HeaderSize10
+            && protocolVersion() == QKnxNetIpFrameHeader::KnxNetIpVersion10
+            && totalSize() == m_size
+            && QKnxNetIp::isFrameType(code());
+    }
+
+    quint8 headerSize() const { return byte(0); }
+    quint8 protocolVersion() const { return byte(1); }
+    QKnxNetIp::ServiceType code() const { return QKnxNetIp::ServiceType(word(2)); }
+    quint16 totalSize() const { return word(4); }
+
+    // Only meaningful for frames that carry a connection header, e.g. tunneling requests and
+    // acknowledges.
+    quint8 connectionHeaderSize() const { return byte(QKnxNetIpFrameHeader::HeaderSize10); }
+    quint8 channelId() const { return byte(QKnxNetIpFrameHeader::HeaderSize10 + 1); }
+    quint8 sequenceCount() const { return byte(QKnxNetIpFrameHeader::HeaderSize10 + 2); }
+    quint8 serviceTypeSpecificValue() const { return byte(QKnxNetIpFrameHeader::HeaderSize10 + 3); }
+
+    QKnxLinkLayerFrameView cemi() const
+    {
+        const quint16 offset = QKnxNetIpFrameHeader::HeaderSize10 + connectionHeaderSize();
+        if (connectionHeaderSize() == 0 || offset >= m_size)
+            return {};
+        return { m_data + offset, quint16(m_size - offset) };
+    }
+
+    QByteArray bytes() const
+    {
+        return QByteArray(reinterpret_cast<const char *>(m_data), m_size);
+    }
+
+private:
+    quint16 word(quint16 index) const
+    {
+        return quint16(quint16(byte(index)) << 8 | byte(index + 1));
+    }
+
+private:
+    const quint8 *m_data = nullptr;
+    quint16 m_size = 0;
+};
+
+Q_DECLARE_TYPEINFO(QKnxNetIpFrameView, Q_PRIMITIVE_TYPE);
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,753 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxnetiprouter.h"
+#include "qknxnetiprouter_p.h"
+#include "qknxnetiproutingindication.h"
+
+#include <QtCore/qrandom.h>
+#include <QtNetwork/qnetworkinterface.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QKnxNetIpRouter
+
+    \inmodule QtKnx
+    \brief The QKnxNetIpRouter class sends and receives KNXnet/IP routing
+    indications using IP multicast.
+
+    Unlike a \l QKnxNetIpTunnelConnection, a router does not open a connection
+    to a single KNXnet/IP server. It joins the KNXnet/IP routing multicast group
+    and exchanges \l QKnxLinkLayerFrame frames with every KNXnet/IP router in
+    the installation, without waiting for acknowledges.
+
+    Outgoing frames are queued and sent at no more than 50 telegrams per second,
+    as required by the KNXnet/IP routing specification. If a router on the
+    network signals that it is overloaded by sending a ROUTING_BUSY frame,
+    sending is paused for the requested wait time plus a random back-off.
+
+    \code
+        QKnxNetIpRouter router;
+        QHostAddress clientLocalAddress = ...
+        router.setLocalAddress(clientLocalAddress);
+        router.start();
+
+        QKnxLinkLayerFrame frame = ...
+        router.sendRoutingIndication(frame);
+    \endcode
+*/
+
+/*!
+    \enum QKnxNetIpRouter::State
+
+    This enum describes the state of the router.
+
+    \value NotRunning
+            The router is not running.
+    \value Starting
+            The router is binding its socket and joining the multicast group.
+    \value Running
+            The router is running and exchanges routing indications.
+    \value Stopping
+            The router is leaving the multicast group.
+*/
+
+/*!
+    \enum QKnxNetIpRouter::Error
+
+    This enum describes the errors that can occur.
+
+    \value None
+            No error occurred.
+    \value Network
+            A network error occurred, for example the socket could not be bound
+            or the multicast group could not be joined.
+    \value NotIPv4
+            The local address is not an IPv4 address.
+    \value Unknown
+            An unknown error occurred.
+*/
+
+/*!
+    \fn void QKnxNetIpRouter::started()
+
+    This signal is emitted when the router has joined the multicast group.
+*/
+
+/*!
+    \fn void QKnxNetIpRouter::finished()
+
+    This signal is emitted when the router has stopped.
+*/
+
+/*!
+    \fn void QKnxNetIpRouter::receivedRoutingIndication(QKnxLinkLayerFrame frame)
+
+    This signal is emitted when a routing indication carrying \a frame was
+    received.
+*/
+
+/*!
+    \fn void QKnxNetIpRouter::routingBusyReceived(QKnxNetIp::DeviceState state, int waitTime)
+
+    This signal is emitted when a ROUTING_BUSY frame with the device state
+    \a state and the wait time \a waitTime in milliseconds was received.
+    Sending is paused for the wait time plus a random back-off.
+*/
+
+/*!
+    \fn void QKnxNetIpRouter::lostMessageReceived(QKnxNetIp::DeviceState state, int lostMessageCount)
+
+    This signal is emitted when a ROUTING_LOST_MESSAGE frame with the device
+    state \a state and the number of lost messages \a lostMessageCount was
+    received.
+
+    \sa lostMessageCount()
+*/
+
+/*!
+    \fn void QKnxNetIpRouter::sendQueueSizeChanged(int size)
+
+    This signal is emitted when the number of frames waiting in the send queue
+    changed to \a size.
+*/
+
+/*!
+    \fn void QKnxNetIpRouter::frameDropped()
+
+    This signal is emitted when a frame was dropped, either because the send
+    queue was full or because the router was stopped before it was sent.
+
+    \sa droppedFrameCount()
+*/
+
+/*!
+    \fn void QKnxNetIpRouter::stateChanged(QKnxNetIpRouter::State state)
+
+    This signal is emitted when the state of the router changed to \a state.
+*/
+
+/*!
+    \fn void QKnxNetIpRouter::errorOccurred(QKnxNetIpRouter::Error error, QString errorString)
+
+    This signal is emitted when the error \a error occurred. \a errorString
+    describes the error.
+*/
+
+// -- QKnxNetIpRouterPrivate
+
+QKnxNetIpRouterPrivate::QKnxNetIpRouterPrivate(const QHostAddress &addr)
+    : address(addr)
+{}
+
+namespace QKnxPrivate
+{
+    static void clearSocket(QUdpSocket **socket)
+    {
+        if (*socket) {
+            (*socket)->disconnect();
+            (*socket)->deleteLater();
+            (*socket) = nullptr;
+        }
+    }
+
+    static void clearTimer(QTimer **timer)
+    {
+        if (*timer) {
+            (*timer)->stop();
+            (*timer)->disconnect();
+            (*timer)->deleteLater();
+            (*timer) = nullptr;
+        }
+    }
+
+    static QNetworkInterface multicastInterface(const QHostAddress &address)
+    {
+        const auto interfaces = QNetworkInterface::allInterfaces();
+        for (const auto &iface : interfaces) {
+            if (!iface.flags().testFlag(QNetworkInterface::CanMulticast))
+                continue;
+
+            const auto entries = iface.addressEntries();
+            for (const auto &entry : entries) {
+                auto ip = entry.ip();
+                if (ip.protocol() != QAbstractSocket::NetworkLayerProtocol::IPv4Protocol)
+                    continue;
+                if (ip == address)
+                    return iface;
+            }
+        }
+        return {};
+    }
+}
+
+void QKnxNetIpRouterPrivate::setupSocket()
+{
+    QKnxPrivate::clearSocket(&socket);
+
+    Q_Q(QKnxNetIpRouter);
+    socket = new QUdpSocket(q);
+    socket->setSocketOption(QUdpSocket::SocketOption::MulticastTtlOption, ttl);
+
+    QObject::connect(socket, &QUdpSocket::stateChanged, [&](QUdpSocket::SocketState s) {
+        if (s != QUdpSocket::BoundState)
+            return;
+
+        Q_Q(QKnxNetIpRouter);
+        const auto iface = QKnxPrivate::multicastInterface(address);
+        if (!socket->joinMulticastGroup(multicastAddress, iface)) {
+            setAndEmitErrorOccurred(QKnxNetIpRouter::Error::Network,
+                QKnxNetIpRouter::tr("Could not join multicast group."));
+            q->stop();
+            return;
+        }
+
+        if (iface.isValid())
+            socket->setMulticastInterface(iface);
+        socket->setSocketOption(QUdpSocket::SocketOption::MulticastLoopbackOption,
+            loopback ? 1 : 0);
+
+        clock.start();
+        nextSendTime = 0;
+        busyUntil = 0;
+        lastBusyTime = 0;
+        busyCounter = 0;
+
+        setAndEmitStateChanged(QKnxNetIpRouter::State::Running);
+        scheduleSend();
+    });
+
+    using overload = void (QUdpSocket::*)(QUdpSocket::SocketError);
+    QObject::connect(socket,
+        static_cast<overload>(&QUdpSocket::error), [&](QUdpSocket::SocketError) {
+            setAndEmitErrorOccurred(QKnxNetIpRouter::Error::Network, socket->errorString());
+
+            Q_Q(QKnxNetIpRouter);
+            q->stop();
+    });
+
+    QObject::connect(socket, &QUdpSocket::readyRead, [&]() { readDatagrams(); });
+
+    QKnxPrivate::clearTimer(&sendTimer);
+    sendTimer = new QTimer(q);
+    sendTimer->setSingleShot(true);
+    QObject::connect(sendTimer, &QTimer::timeout, [&]() { sendNextRoutingIndication(); });
+}
+
+void QKnxNetIpRouterPrivate::readDatagrams()
+{
+    Q_Q(QKnxNetIpRouter);
+    while (socket && socket->hasPendingDatagrams()) {
+        if (state != QKnxNetIpRouter::State::Running)
+            break;
+
+        const qint64 pendingSize = socket->pendingDatagramSize();
+        if (pendingSize > buffer.size())
+            buffer.resize(int(pendingSize));
+
+        const qint64 size = socket->readDatagram(buffer.data(), buffer.size());
+        if (size < 0)
+            break;
+
+        const QKnxNetIpFrameView frame(reinterpret_cast<const quint8 *>(buffer.constData()),
+            quint16(size));
+        if (!frame.isValid())
+            continue;
+
+        switch (frame.code()) {
+        case QKnxNetIp::ServiceType::RoutingIndication:
+            if (frame.size() > frame.headerSize()) {
+                emit q->receivedRoutingIndication(QKnxLinkLayerFrameView(frame.data()
+                    + frame.headerSize(), quint16(frame.size() - frame.headerSize())).toFrame());
+            }
+            break;
+        case QKnxNetIp::ServiceType::RoutingBusy:
+            processRoutingBusy(frame);
+            break;
+        case QKnxNetIp::ServiceType::RoutingLostMessage:
+            processLostMessage(frame);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void QKnxNetIpRouterPrivate::processRoutingBusy(const QKnxNetIpFrameView &frame)
+{
+    // header, structure length, device state, wait time (2 bytes), control field (2 bytes)
+    if (frame.size() != 12)
+        return;
+
+    const auto state = QKnxNetIp::DeviceState(frame.byte(7));
+    const int waitTime = int(quint16(frame.byte(8)) << 8 | frame.byte(9));
+    const quint16 control = quint16(frame.byte(10)) << 8 | frame.byte(11);
+
+    Q_Q(QKnxNetIpRouter);
+    emit q->routingBusyReceived(state, waitTime);
+
+    // A non zero control field addresses a single device, which is never a routing client.
+    if (control != 0x0000)
+        return;
+
+    // 03_08_05 Routing v01.05.01 AS.pdf, paragraph 2.3.5.1: after t_slowduration = N * 100 ms
+    // without a ROUTING_BUSY, N is decremented every 5 ms. Several routers may answer the same
+    // overflow, so frames received within 10 ms of the first one count as a single event.
+    const qint64 now = clock.elapsed();
+    if (busyCounter == 0 || now - lastBusyTime >= 10) {
+        const qint64 slowDuration = busyCounter * 100;
+        if (now - lastBusyTime > slowDuration)
+            busyCounter = qMax(0, busyCounter - int((now - lastBusyTime - slowDuration) / 5));
+        busyCounter++;
+        lastBusyTime = now;
+    }
+
+    const int randomWait = QRandomGenerator::global()->bounded(busyCounter * 50 + 1);
+    busyUntil = qMax(busyUntil, now + waitTime + randomWait);
+
+    if (sendTimer && sendTimer->isActive())
+        sendTimer->stop();
+    scheduleSend();
+}
+
+void QKnxNetIpRouterPrivate::processLostMessage(const QKnxNetIpFrameView &frame)
+{
+    // header, structure length, device state, lost message count (2 bytes)
+    if (frame.size() != 10)
+        return;
+
+    const auto state = QKnxNetIp::DeviceState(frame.byte(7));
+    const int count = int(quint16(frame.byte(8)) << 8 | frame.byte(9));
+    lostMessages += quint32(count);
+
+    Q_Q(QKnxNetIpRouter);
+    emit q->lostMessageReceived(state, count);
+}
+
+void QKnxNetIpRouterPrivate::scheduleSend()
+{
+    if (state != QKnxNetIpRouter::State::Running || sendQueue.isEmpty() || !sendTimer
+        || sendTimer->isActive()) {
+        return;
+    }
+
+    const qint64 now = clock.elapsed();
+    const qint64 next = qMax(nextSendTime, busyUntil);
+    sendTimer->start(int(qMax<qint64>(0, next - now)));
+}
+
+void QKnxNetIpRouterPrivate::sendNextRoutingIndication()
+{
+    if (state != QKnxNetIpRouter::State::Running || sendQueue.isEmpty())
+        return;
+
+    // the timer might fire early, never send before the rate limit or back-off allow it
+    const qint64 now = clock.elapsed();
+    if (now < qMax(nextSendTime, busyUntil)) {
+        scheduleSend();
+        return;
+    }
+
+    socket->writeDatagram(sendQueue.dequeue(), multicastAddress, multicastPort);
+    nextSendTime = now + (sendRate > 0 ? 1000 / sendRate : 0);
+
+    Q_Q(QKnxNetIpRouter);
+    emit q->sendQueueSizeChanged(sendQueue.size());
+
+    scheduleSend();
+}
+
+void QKnxNetIpRouterPrivate::setAndEmitStateChanged(QKnxNetIpRouter::State newState)
+{
+    state = newState;
+
+    Q_Q(QKnxNetIpRouter);
+    emit q->stateChanged(newState);
+
+    if (state == QKnxNetIpRouter::State::Running)
+        emit q->started();
+    else if (state == QKnxNetIpRouter::State::NotRunning)
+        emit q->finished();
+}
+
+void QKnxNetIpRouterPrivate::setAndEmitErrorOccurred(QKnxNetIpRouter::Error newError,
+    const QString &message)
+{
+    error = newError;
+    errorString = message;
+
+    Q_Q(QKnxNetIpRouter);
+    emit q->errorOccurred(error, errorString);
+}
+
+
+// -- QKnxNetIpRouter
+
+/*!
+    Creates a router with the parent \a parent that uses any IPv4 interface.
+*/
+QKnxNetIpRouter::QKnxNetIpRouter(QObject *parent)
+    : QKnxNetIpRouter(QHostAddress(QHostAddress::AnyIPv4), parent)
+{}
+
+/*!
+    Stops the router and destroys it.
+*/
+QKnxNetIpRouter::~QKnxNetIpRouter()
+{
+    stop();
+}
+
+/*!
+    Creates a router with the parent \a parent that joins the multicast group
+    on the interface of \a localAddress.
+*/
+QKnxNetIpRouter::QKnxNetIpRouter(const QHostAddress &localAddress, QObject *parent)
+    : QKnxNetIpRouter(*new QKnxNetIpRouterPrivate(localAddress), parent)
+{}
+
+/*!
+    Returns the state of the router.
+*/
+QKnxNetIpRouter::State QKnxNetIpRouter::state() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->state;
+}
+
+/*!
+    Returns the last error that occurred.
+*/
+QKnxNetIpRouter::Error QKnxNetIpRouter::error() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->error;
+}
+
+/*!
+    Returns a human readable description of the last error that occurred.
+*/
+QString QKnxNetIpRouter::errorString() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->errorString;
+}
+
+/*!
+    Returns the address of the interface used to join the multicast group.
+*/
+QHostAddress QKnxNetIpRouter::localAddress() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->address;
+}
+
+/*!
+    Sets the address of the interface used to join the multicast group to
+    \a address. The value can only be changed while the router is not running.
+*/
+void QKnxNetIpRouter::setLocalAddress(const QHostAddress &address)
+{
+    Q_D(QKnxNetIpRouter);
+    if (d->state == QKnxNetIpRouter::State::NotRunning)
+        d->address = address;
+}
+
+/*!
+    Returns the routing multicast group.
+*/
+QHostAddress QKnxNetIpRouter::multicastAddress() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->multicastAddress;
+}
+
+/*!
+    Sets the routing multicast group to \a address. The default is the KNXnet/IP
+    system setup multicast address 224.0.23.12. The value can only be changed
+    while the router is not running.
+*/
+void QKnxNetIpRouter::setMulticastAddress(const QHostAddress &address)
+{
+    Q_D(QKnxNetIpRouter);
+    if (d->state == QKnxNetIpRouter::State::NotRunning)
+        d->multicastAddress = address;
+}
+
+/*!
+    Returns the routing multicast port. The default is \c 3671.
+*/
+quint16 QKnxNetIpRouter::multicastPort() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->multicastPort;
+}
+
+/*!
+    Sets the routing multicast port to \a port. The value can only be changed
+    while the router is not running.
+*/
+void QKnxNetIpRouter::setMulticastPort(quint16 port)
+{
+    Q_D(QKnxNetIpRouter);
+    if (d->state == QKnxNetIpRouter::State::NotRunning)
+        d->multicastPort = port;
+}
+
+/*!
+    Returns the time to live of outgoing multicast datagrams. The default is
+    \c 60.
+*/
+quint8 QKnxNetIpRouter::multicastTtl() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->ttl;
+}
+
+/*!
+    Sets the time to live of outgoing multicast datagrams to \a ttl.
+*/
+void QKnxNetIpRouter::setMulticastTtl(quint8 ttl)
+{
+    Q_D(QKnxNetIpRouter);
+    d->ttl = ttl;
+    if (d->socket)
+        d->socket->setSocketOption(QUdpSocket::SocketOption::MulticastTtlOption, ttl);
+}
+
+/*!
+    Returns whether frames sent by this router are looped back to receivers on
+    the local host.
+*/
+bool QKnxNetIpRouter::multicastLoopback() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->loopback;
+}
+
+/*!
+    Sets whether frames sent by this router are looped back to receivers on the
+    local host to \a enabled. The default is \c false.
+*/
+void QKnxNetIpRouter::setMulticastLoopback(bool enabled)
+{
+    Q_D(QKnxNetIpRouter);
+    d->loopback = enabled;
+    if (d->socket)
+        d->socket->setSocketOption(QUdpSocket::SocketOption::MulticastLoopbackOption, enabled);
+}
+
+/*!
+    Returns the maximum number of routing indications sent per second. The
+    default value is 50.
+
+    \sa setMaximumSendRate()
+*/
+int QKnxNetIpRouter::maximumSendRate() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->sendRate;
+}
+
+/*!
+    Sets the maximum number of routing indications sent per second to
+    \a telegramsPerSecond. Values above 50 violate the KNXnet/IP routing
+    specification and should only be used on dedicated networks. A value of 0
+    disables rate limiting. Negative values are ignored.
+
+    The rate limit applies on top of the back-off requested by ROUTING_BUSY
+    frames, which pauses sending regardless of this value.
+
+    \sa routingBusyReceived()
+*/
+void QKnxNetIpRouter::setMaximumSendRate(int telegramsPerSecond)
+{
+    if (telegramsPerSecond < 0)
+        return;
+
+    Q_D(QKnxNetIpRouter);
+    d->sendRate = telegramsPerSecond;
+}
+
+/*!
+    Returns the number of frames waiting to be sent.
+
+    \sa sendQueueSizeChanged()
+*/
+int QKnxNetIpRouter::sendQueueSize() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->sendQueue.size();
+}
+
+/*!
+    Returns the maximum number of frames waiting to be sent. The default is
+    \c 256.
+*/
+int QKnxNetIpRouter::maximumSendQueueSize() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->maxSendQueueSize;
+}
+
+/*!
+    Sets the maximum number of frames waiting to be sent to \a size. Frames
+    passed to \l sendRoutingIndication() while the queue is full are dropped.
+    Values smaller than \c 1 are ignored.
+*/
+void QKnxNetIpRouter::setMaximumSendQueueSize(int size)
+{
+    if (size < 1)
+        return;
+
+    Q_D(QKnxNetIpRouter);
+    d->maxSendQueueSize = size;
+}
+
+/*!
+    Returns the number of frames that were dropped because the send queue was
+    full or the router was stopped before they could be sent. The
+    \l frameDropped() signal is emitted once for each dropped frame in both
+    cases.
+*/
+quint32 QKnxNetIpRouter::droppedFrameCount() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->droppedFrames;
+}
+
+/*!
+    Returns the sum of all lost message counts reported by other KNXnet/IP
+    routers through ROUTING_LOST_MESSAGE frames since the router was started.
+*/
+quint32 QKnxNetIpRouter::lostMessageCount() const
+{
+    Q_D(const QKnxNetIpRouter);
+    return d->lostMessages;
+}
+
+/*!
+    Queues the \a frame to be sent as routing indication.
+
+    Returns \c true if the frame was queued; \c false if the router is not
+    running or the send queue is full. In the latter case the frame is dropped
+    and the \l frameDropped() signal is emitted.
+*/
+bool QKnxNetIpRouter::sendRoutingIndication(const QKnxLinkLayerFrame &frame)
+{
+    Q_D(QKnxNetIpRouter);
+    if (d->state != QKnxNetIpRouter::State::Running)
+        return false;
+
+    if (d->sendQueue.size() >= d->maxSendQueueSize) {
+        d->droppedFrames++;
+        emit frameDropped();
+        return false;
+    }
+
+    d->sendQueue.enqueue(QKnxNetIpRoutingIndication(frame).bytes());
+    emit sendQueueSizeChanged(d->sendQueue.size());
+
+    d->scheduleSend();
+    return true;
+}
+
+/*!
+    Binds the socket to the multicast port and joins the routing multicast
+    group. The \l started() signal is emitted once the router is running.
+*/
+void QKnxNetIpRouter::start()
+{
+    Q_D(QKnxNetIpRouter);
+
+    if (d->state != QKnxNetIpRouter::State::NotRunning)
+        return;
+
+    auto isIPv4 = true;
+    d->address.toIPv4Address(&isIPv4);
+    if (isIPv4) {
+        d->lostMessages = 0;
+        d->setAndEmitStateChanged(QKnxNetIpRouter::State::Starting);
+
+        d->setupSocket();
+        auto socket = d->socket;
+        if (!socket->bind(QHostAddress::AnyIPv4, d->multicastPort, QUdpSocket::ShareAddress
+            | QAbstractSocket::ReuseAddressHint)) {
+            // the socket error handler might already have stopped the router
+            if (d->state != QKnxNetIpRouter::State::NotRunning) {
+                d->setAndEmitErrorOccurred(Error::Network, socket->errorString());
+                stop();
+            }
+        }
+    } else {
+        d->setAndEmitErrorOccurred(Error::NotIPv4, tr("Only IPv4 local address supported."));
+    }
+}
+
+/*!
+    Leaves the multicast group and stops the router. Frames still waiting in
+    the send queue are dropped.
+*/
+void QKnxNetIpRouter::stop()
+{
+    Q_D(QKnxNetIpRouter);
+
+    if (d->state == State::Stopping || d->state == State::NotRunning)
+        return;
+
+    d->setAndEmitStateChanged(QKnxNetIpRouter::State::Stopping);
+
+    if (d->socket->state() == QUdpSocket::BoundState)
+        d->socket->leaveMulticastGroup(d->multicastAddress);
+    d->socket->close();
+
+    QKnxPrivate::clearSocket(&(d->socket));
+    QKnxPrivate::clearTimer(&(d->sendTimer));
+
+    if (!d->sendQueue.isEmpty()) {
+        const auto size = d->sendQueue.size();
+        d->droppedFrames += quint32(size);
+        d->sendQueue.clear();
+        emit sendQueueSizeChanged(0);
+        for (int i = 0; i < size; ++i)
+            emit frameDropped();
+    }
+
+    d->setAndEmitStateChanged(QKnxNetIpRouter::State::NotRunning);
+}
+
+/*!
+    \internal
+*/
+QKnxNetIpRouter::QKnxNetIpRouter(QKnxNetIpRouterPrivate &dd, QObject *parent)
+    : QObject(dd, parent)
+{}
+
+QT_END_NAMESPACE
@@ -0,0 +1,128 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPROUTER_H
+#define QKNXNETIPROUTER_H
+
+#include <QtCore/qobject.h>
+#include <QtKnx/qknxglobal.h>
+#include <QtKnx/qknxlinklayerframe.h>
+#include <QtKnx/qknxnetip.h>
+#include <QtNetwork/qhostaddress.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxNetIpRouterPrivate;
+
+class Q_KNX_EXPORT QKnxNetIpRouter final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(QKnxNetIpRouter)
+    Q_DECLARE_PRIVATE(QKnxNetIpRouter)
+
+public:
+    enum class State : quint8
+    {
+        NotRunning,
+        Starting,
+        Running,
+        Stopping
+    };
+    Q_ENUM(State)
+
+    enum class Error : quint8
+    {
+        None,
+        Network,
+        NotIPv4,
+        Unknown = 0x80
+    };
+    Q_ENUM(Error)
+
+    QKnxNetIpRouter(QObject *parent = nullptr);
+    ~QKnxNetIpRouter();
+
+    explicit QKnxNetIpRouter(const QHostAddress &localAddress, QObject *parent = nullptr);
+
+    QKnxNetIpRouter::State state() const;
+    QKnxNetIpRouter::Error error() const;
+    QString errorString() const;
+
+    QHostAddress localAddress() const;
+    void setLocalAddress(const QHostAddress &address);
+
+    QHostAddress multicastAddress() const;
+    void setMulticastAddress(const QHostAddress &address);
+
+    quint16 multicastPort() const;
+    void setMulticastPort(quint16 port);
+
+    quint8 multicastTtl() const;
+    void setMulticastTtl(quint8 ttl);
+
+    bool multicastLoopback() const;
+    void setMulticastLoopback(bool enabled);
+
+    int maximumSendRate() const;
+    void setMaximumSendRate(int telegramsPerSecond);
+
+    int sendQueueSize() const;
+    int maximumSendQueueSize() const;
+    void setMaximumSendQueueSize(int size);
+
+    quint32 droppedFrameCount() const;
+    quint32 lostMessageCount() const;
+
+    bool sendRoutingIndication(const QKnxLinkLayerFrame &frame);
+
+public Q_SLOTS:
+    void start();
+    void stop();
+
+Q_SIGNALS:
+    void started();
+    void finished();
+
+    void receivedRoutingIndication(QKnxLinkLayerFrame frame);
+    void routingBusyReceived(QKnxNetIp::DeviceState state, int waitTime);
+    void lostMessageReceived(QKnxNetIp::DeviceState state, int lostMessageCount);
+
+    void sendQueueSizeChanged(int size);
+    void frameDropped();
+
+    void stateChanged(QKnxNetIpRouter::State state);
+    void errorOccurred(QKnxNetIpRouter::Error error, QString errorString);
+
+private:
+    QKnxNetIpRouter(QKnxNetIpRouterPrivate &dd, QObject *parent);
+};
+
+QT_END_NAMESPACE
+
+#endif
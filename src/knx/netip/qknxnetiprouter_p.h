@@ -0,0 +1,112 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPROUTER_P_H
+#define QKNXNETIPROUTER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qqueue.h>
+#include <QtCore/qtimer.h>
+#include <QtKnx/qknxglobal.h>
+#include <QtKnx/qknxnetip.h>
+#include <QtKnx/qknxnetiprouter.h>
+#include <QtNetwork/qhostaddress.h>
+#include <QtNetwork/qudpsocket.h>
+
+#include <private/qknxnetipframeview_p.h>
+#include <private/qobject_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class Q_KNX_EXPORT QKnxNetIpRouterPrivate final : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QKnxNetIpRouter)
+
+public:
+    explicit QKnxNetIpRouterPrivate(const QHostAddress &addr);
+    ~QKnxNetIpRouterPrivate() override = default;
+
+    void setupSocket();
+    void readDatagrams();
+
+    void processRoutingBusy(const QKnxNetIpFrameView &frame);
+    void processLostMessage(const QKnxNetIpFrameView &frame);
+
+    void scheduleSend();
+    void sendNextRoutingIndication();
+
+    void setAndEmitStateChanged(QKnxNetIpRouter::State newState);
+    void setAndEmitErrorOccurred(QKnxNetIpRouter::Error newError, const QString &message);
+
+private:
+    QUdpSocket *socket { nullptr };
+    QTimer *sendTimer { nullptr };
+    QElapsedTimer clock;
+
+    QHostAddress address { QHostAddress::AnyIPv4 };
+    QHostAddress multicastAddress { QLatin1String(QKnxNetIp::MulticastAddress) };
+    quint16 multicastPort { QKnxNetIp::DefaultPort };
+
+    quint8 ttl { 60 };
+    bool loopback { false };
+
+    // 03_08_05 Routing v01.05.01 AS.pdf, paragraph 2.3.5: at most 50 telegrams per second
+    int sendRate { 50 };
+    qint64 nextSendTime { 0 };
+
+    // ROUTING_BUSY flow control, paragraph 2.3.5.1
+    qint64 busyUntil { 0 };
+    qint64 lastBusyTime { 0 };
+    int busyCounter { 0 };
+
+    QByteArray buffer;
+    QQueue<QByteArray> sendQueue;
+    int maxSendQueueSize { 256 };
+    quint32 droppedFrames { 0 };
+    quint32 lostMessages { 0 };
+
+    QString errorString;
+    QKnxNetIpRouter::Error error { QKnxNetIpRouter::Error::None };
+    QKnxNetIpRouter::State state { QKnxNetIpRouter::State::NotRunning };
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,580 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxnetipthreadedtunnelconnection.h"
+#include "qknxnetipthreadedtunnelconnection_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QKnxNetIpThreadedTunnelConnection
+
+    \inmodule QtKnx
+    \brief The QKnxNetIpThreadedTunnelConnection class runs a tunnel connection
+    to a KNXnet/IP server on a dedicated I/O thread.
+
+    A \l QKnxNetIpTunnelConnection handles its sockets, acknowledges and
+    heartbeat timers on the thread it lives in. If that thread is busy, for
+    example drawing a user interface, acknowledges can be sent too late and
+    the server closes the tunnel.
+
+    QKnxNetIpThreadedTunnelConnection owns a tunnel connection that lives on
+    an internal thread, so the protocol deadlines do not depend on how fast the
+    application handles events. Frames cross the thread boundary through
+    lock-free ring buffers. Received frames are collected and emitted in a batch
+    through the \l receivedTunnelFrame() signal on the thread that owns this
+    object. If a ring buffer is full, the frame is dropped and counted in
+    \l droppedFrameCount().
+
+    All functions must be called from the thread that owns the object. Settings
+    take effect on the next call to \l connectToHost(). The NAT, single socket,
+    heartbeat, send queue and reconnect settings are forwarded to the tunnel
+    connection. The frame trace, the statistics interval, the supported protocol
+    versions and the individual address are not available and keep the defaults
+    of \l QKnxNetIpTunnelConnection.
+
+    \code
+        QHostAddress clientLocalAddress = ...
+        QKnxNetIpThreadedTunnelConnection tunnel(clientLocalAddress);
+
+        QHostAddress knxNetIpServerAddress = ...
+        quint16 knxNetIpServerControlEndPointPort = ...
+        tunnel.connectToHost(knxNetIpServerAddress, knxNetIpServerControlEndPointPort);
+
+        QKnxLinkLayerFrame frame = ...
+        tunnel.sendTunnelFrame(frame);
+    \endcode
+*/
+
+// -- QKnxNetIpThreadedTunnelConnectionPrivate
+
+QKnxNetIpThreadedTunnelConnectionPrivate::QKnxNetIpThreadedTunnelConnectionPrivate(
+        const QHostAddress &addr, quint16 p, QKnxNetIp::TunnelingLayer l)
+    : address(addr)
+    , port(p)
+    , layer(l)
+{}
+
+void QKnxNetIpThreadedTunnelConnectionPrivate::setupWorker()
+{
+    if (thread)
+        return;
+
+    thread = new QThread;
+    thread->setObjectName(QStringLiteral("QKnxNetIpThreadedTunnelConnection"));
+
+    connection = new QKnxNetIpTunnelConnection(address, port, layer);
+    connection->moveToThread(thread);
+
+    // The lambdas run on the I/O thread and hand everything over to the owning thread with
+    // queued calls, which keep the order of the signals.
+    Q_Q(QKnxNetIpThreadedTunnelConnection);
+    QObject::connect(connection, &QKnxNetIpEndpointConnection::stateChanged, connection,
+        [this](QKnxNetIpEndpointConnection::State newState) {
+            state.storeRelease(newState);
+
+            Q_Q(QKnxNetIpThreadedTunnelConnection);
+            QMetaObject::invokeMethod(q, [q, newState]() {
+                emit q->stateChanged(newState);
+                if (newState == QKnxNetIpEndpointConnection::State::Connected)
+                    emit q->connected();
+                else if (newState == QKnxNetIpEndpointConnection::State::Disconnected)
+                    emit q->disconnected();
+            }, Qt::QueuedConnection);
+    }, Qt::DirectConnection);
+
+    QObject::connect(connection, &QKnxNetIpEndpointConnection::errorOccurred, connection,
+        [q](QKnxNetIpEndpointConnection::Error error, const QString &errorString) {
+            QMetaObject::invokeMethod(q, [q, error, errorString]() {
+                emit q->errorOccurred(error, errorString);
+            }, Qt::QueuedConnection);
+    }, Qt::DirectConnection);
+
+    QObject::connect(connection, &QKnxNetIpTunnelConnection::receivedTunnelFrame, connection,
+        [this](const QKnxLinkLayerFrame &frame) {
+            frameReceived(frame);
+    }, Qt::DirectConnection);
+
+    thread->start();
+}
+
+void QKnxNetIpThreadedTunnelConnectionPrivate::stopWorker()
+{
+    if (!thread)
+        return;
+
+    // the connection has to be destroyed on the thread its sockets and timers live in
+    auto c = connection;
+    QMetaObject::invokeMethod(c, [c]() {
+        c->disconnect();
+        delete c;
+    }, Qt::BlockingQueuedConnection);
+    connection = nullptr;
+
+    thread->quit();
+    thread->wait();
+    delete thread;
+    thread = nullptr;
+}
+
+void QKnxNetIpThreadedTunnelConnectionPrivate::frameReceived(const QKnxLinkLayerFrame &frame)
+{
+    if (!inbound.push(frame)) {
+        droppedFrames.fetchAndAddRelaxed(1);
+        return;
+    }
+
+    if (!inboundWakeup.testAndSetAcquire(0, 1))
+        return; // the owning thread has not drained the previous frames yet
+
+    Q_Q(QKnxNetIpThreadedTunnelConnection);
+    QMetaObject::invokeMethod(q, [this]() { emitReceivedFrames(); }, Qt::QueuedConnection);
+}
+
+void QKnxNetIpThreadedTunnelConnectionPrivate::sendQueuedFrames()
+{
+    outboundWakeup.storeRelease(0);
+
+    QKnxLinkLayerFrame frame;
+    while (outbound.pop(&frame)) {
+        if (!connection->sendTunnelFrame(frame))
+            droppedFrames.fetchAndAddRelaxed(1);
+    }
+}
+
+void QKnxNetIpThreadedTunnelConnectionPrivate::emitReceivedFrames()
+{
+    // reset before draining, frames pushed after this point trigger a new wakeup
+    inboundWakeup.storeRelease(0);
+
+    Q_Q(QKnxNetIpThreadedTunnelConnection);
+    QKnxLinkLayerFrame frame;
+    while (inbound.pop(&frame))
+        emit q->receivedTunnelFrame(frame);
+}
+
+
+// -- QKnxNetIpThreadedTunnelConnection
+
+/*!
+    Creates a threaded tunnel connection with the parent \a parent. The
+    connection binds to the local host and a free port and tunnels on the link
+    layer.
+*/
+QKnxNetIpThreadedTunnelConnection::QKnxNetIpThreadedTunnelConnection(QObject *parent)
+    : QKnxNetIpThreadedTunnelConnection({ QHostAddress::LocalHost }, 0,
+        QKnxNetIp::TunnelingLayer::Link, parent)
+{}
+
+/*!
+    Destroys the tunnel connection on its I/O thread and stops the thread.
+    An established connection is closed without waiting for the disconnect
+    response.
+*/
+QKnxNetIpThreadedTunnelConnection::~QKnxNetIpThreadedTunnelConnection()
+{
+    Q_D(QKnxNetIpThreadedTunnelConnection);
+    d->stopWorker();
+}
+
+/*!
+    Creates a threaded tunnel connection with the parent \a parent that binds
+    to \a localAddress and a free port.
+*/
+QKnxNetIpThreadedTunnelConnection::QKnxNetIpThreadedTunnelConnection(
+        const QHostAddress &localAddress, QObject *parent)
+    : QKnxNetIpThreadedTunnelConnection(localAddress, 0, QKnxNetIp::TunnelingLayer::Link, parent)
+{}
+
+/*!
+    Creates a threaded tunnel connection with the parent \a parent that binds
+    to \a localAddress and \a localPort.
+*/
+QKnxNetIpThreadedTunnelConnection::QKnxNetIpThreadedTunnelConnection(
+        const QHostAddress &localAddress, quint16 localPort, QObject *parent)
+    : QKnxNetIpThreadedTunnelConnection(localAddress, localPort, QKnxNetIp::TunnelingLayer::Link,
+        parent)
+{}
+
+/*!
+    Creates a threaded tunnel connection with the parent \a parent that binds
+    to \a localAddress and \a localPort and tunnels on the KNX layer \a layer.
+*/
+QKnxNetIpThreadedTunnelConnection::QKnxNetIpThreadedTunnelConnection(
+        const QHostAddress &localAddress, quint16 localPort, QKnxNetIp::TunnelingLayer layer,
+        QObject *parent)
+    : QKnxNetIpThreadedTunnelConnection(*new QKnxNetIpThreadedTunnelConnectionPrivate(
+        localAddress, localPort, layer), parent)
+{}
+
+/*!
+    Returns the state of the tunnel connection on the I/O thread. The state is
+    read without waiting for the I/O thread, so it can be ahead of the last
+    \l stateChanged() signal received on the owning thread.
+
+    \sa QKnxNetIpEndpointConnection::state()
+*/
+QKnxNetIpEndpointConnection::State QKnxNetIpThreadedTunnelConnection::state() const
+{
+    Q_D(const QKnxNetIpThreadedTunnelConnection);
+    return QKnxNetIpEndpointConnection::State(d->state.loadAcquire());
+}
+
+/*!
+    Returns \c true if the connection is NAT aware; \c false otherwise.
+
+    \sa QKnxNetIpEndpointConnection::natAware()
+*/
+bool QKnxNetIpThreadedTunnelConnection::natAware() const
+{
+    Q_D(const QKnxNetIpThreadedTunnelConnection);
+    return d->settings.nat;
+}
+
+/*!
+    Sets whether the connection is NAT aware to \a isAware.
+
+    \sa QKnxNetIpEndpointConnection::setNatAware()
+*/
+void QKnxNetIpThreadedTunnelConnection::setNatAware(bool isAware)
+{
+    Q_D(QKnxNetIpThreadedTunnelConnection);
+    d->settings.nat = isAware;
+}
+
+/*!
+    Returns \c true if the control and data endpoint share one UDP socket;
+    \c false otherwise. NAT aware connections always use a single socket.
+
+    \sa QKnxNetIpEndpointConnection::singleSocket()
+*/
+bool QKnxNetIpThreadedTunnelConnection::singleSocket() const
+{
+    Q_D(const QKnxNetIpThreadedTunnelConnection);
+    return d->settings.singleSocket || d->settings.nat;
+}
+
+/*!
+    Sets whether the control and data endpoint share one UDP socket to
+    \a single.
+
+    \sa QKnxNetIpEndpointConnection::setSingleSocket()
+*/
+void QKnxNetIpThreadedTunnelConnection::setSingleSocket(bool single)
+{
+    Q_D(QKnxNetIpThreadedTunnelConnection);
+    d->settings.singleSocket = single;
+}
+
+/*!
+    Returns \c true if the connection reconnects automatically; \c false
+    otherwise.
+
+    \sa QKnxNetIpEndpointConnection::autoReconnect()
+*/
+bool QKnxNetIpThreadedTunnelConnection::autoReconnect() const
+{
+    Q_D(const QKnxNetIpThreadedTunnelConnection);
+    return d->settings.reconnect;
+}
+
+/*!
+    Enables automatic reconnection if \a enabled is \c true.
+
+    \sa QKnxNetIpEndpointConnection::setAutoReconnect()
+*/
+void QKnxNetIpThreadedTunnelConnection::setAutoReconnect(bool enabled)
+{
+    Q_D(QKnxNetIpThreadedTunnelConnection);
+    d->settings.reconnect = enabled;
+}
+
+/*!
+    Returns the interval in milliseconds between two connection state requests.
+
+    \sa QKnxNetIpEndpointConnection::heartbeatTimeout()
+*/
+quint32 QKnxNetIpThreadedTunnelConnection::heartbeatTimeout() const
+{
+    Q_D(const QKnxNetIpThreadedTunnelConnection);
+    return d->settings.heartbeatTimeout;
+}
+
+/*!
+    Sets the interval between two connection state requests to \a msec
+    milliseconds. Values above \l QKnxNetIp::ConnectionAliveTimeout are
+    ignored.
+
+    \sa QKnxNetIpEndpointConnection::setHeartbeatTimeout()
+*/
+void QKnxNetIpThreadedTunnelConnection::setHeartbeatTimeout(quint32 msec)
+{
+    if (msec > QKnxNetIp::ConnectionAliveTimeout)
+        return;
+
+    Q_D(QKnxNetIpThreadedTunnelConnection);
+    d->settings.heartbeatTimeout = msec;
+}
+
+/*!
+    Returns the maximum number of frames the tunnel connection on the I/O thread
+    queues while it waits for acknowledges. The default is \c 64.
+
+    \sa QKnxNetIpEndpointConnection::maximumSendQueueSize()
+*/
+int QKnxNetIpThreadedTunnelConnection::maximumSendQueueSize() const
+{
+    Q_D(const QKnxNetIpThreadedTunnelConnection);
+    return d->settings.maxSendQueueSize;
+}
+
+/*!
+    Sets the maximum number of frames in the send queue of the tunnel
+    connection to \a size. Values smaller than \c 1 are ignored.
+
+    \sa QKnxNetIpEndpointConnection::setMaximumSendQueueSize()
+*/
+void QKnxNetIpThreadedTunnelConnection::setMaximumSendQueueSize(int size)
+{
+    if (size < 1)
+        return;
+
+    Q_D(QKnxNetIpThreadedTunnelConnection);
+    d->settings.maxSendQueueSize = size;
+}
+
+/*!
+    Returns the number of reconnect attempts made before giving up. The default
+    is \c 10. A value of \c 0 means there is no limit.
+
+    \sa QKnxNetIpEndpointConnection::maximumReconnectAttempts()
+*/
+int QKnxNetIpThreadedTunnelConnection::maximumReconnectAttempts() const
+{
+    Q_D(const QKnxNetIpThreadedTunnelConnection);
+    return d->settings.maxReconnectAttempts;
+}
+
+/*!
+    Sets the number of reconnect attempts made before giving up to \a attempts.
+
+    \sa QKnxNetIpEndpointConnection::setMaximumReconnectAttempts()
+*/
+void QKnxNetIpThreadedTunnelConnection::setMaximumReconnectAttempts(int attempts)
+{
+    if (attempts < 0)
+        return;
+
+    Q_D(QKnxNetIpThreadedTunnelConnection);
+    d->settings.maxReconnectAttempts = attempts;
+}
+
+/*!
+    Returns the delay in milliseconds before the first reconnect attempt.
+
+    \sa QKnxNetIpEndpointConnection::reconnectInterval()
+*/
+quint32 QKnxNetIpThreadedTunnelConnection::reconnectInterval() const
+{
+    Q_D(const QKnxNetIpThreadedTunnelConnection);
+    return d->settings.reconnectInterval;
+}
+
+/*!
+    Sets the delay before the first reconnect attempt to \a msec milliseconds.
+
+    \sa QKnxNetIpEndpointConnection::setReconnectInterval()
+*/
+void QKnxNetIpThreadedTunnelConnection::setReconnectInterval(quint32 msec)
+{
+    Q_D(QKnxNetIpThreadedTunnelConnection);
+    d->settings.reconnectInterval = msec;
+}
+
+/*!
+    Returns the upper limit in milliseconds of the delay between two reconnect
+    attempts.
+
+    \sa QKnxNetIpEndpointConnection::maximumReconnectInterval()
+*/
+quint32 QKnxNetIpThreadedTunnelConnection::maximumReconnectInterval() const
+{
+    Q_D(const QKnxNetIpThreadedTunnelConnection);
+    return d->settings.maxReconnectInterval;
+}
+
+/*!
+    Sets the upper limit of the delay between two reconnect attempts to \a msec
+    milliseconds.
+
+    \sa QKnxNetIpEndpointConnection::setMaximumReconnectInterval()
+*/
+void QKnxNetIpThreadedTunnelConnection::setMaximumReconnectInterval(quint32 msec)
+{
+    Q_D(QKnxNetIpThreadedTunnelConnection);
+    d->settings.maxReconnectInterval = msec;
+}
+
+/*!
+    Returns the number of frames each of the ring buffers between the I/O
+    thread and the owning thread can hold.
+*/
+int QKnxNetIpThreadedTunnelConnection::queueCapacity() const
+{
+    Q_D(const QKnxNetIpThreadedTunnelConnection);
+    return d->inbound.capacity();
+}
+
+/*!
+    Returns the number of frames dropped because a ring buffer was full or the
+    tunnel connection did not accept them.
+*/
+quint32 QKnxNetIpThreadedTunnelConnection::droppedFrameCount() const
+{
+    Q_D(const QKnxNetIpThreadedTunnelConnection);
+    return d->droppedFrames.loadAcquire();
+}
+
+/*!
+    Returns a snapshot of the traffic and latency counters of the tunnel
+    connection running on the I/O thread. The counters are read directly without
+    waiting for the I/O thread.
+
+    \sa QKnxNetIpEndpointConnection::statistics()
+*/
+QKnxNetIpConnectionStatistics QKnxNetIpThreadedTunnelConnection::statistics() const
+{
+    Q_D(const QKnxNetIpThreadedTunnelConnection);
+    return (d->connection ? d->connection->statistics() : QKnxNetIpConnectionStatistics());
+}
+
+/*!
+    Establishes a connection to the KNXnet/IP server at \a controlEndpoint.
+
+    \sa QKnxNetIpEndpointConnection::connectToHost()
+*/
+void QKnxNetIpThreadedTunnelConnection::connectToHost(const QKnxNetIpHpai &controlEndpoint)
+{
+    connectToHost(controlEndpoint.address(), controlEndpoint.port());
+}
+
+/*!
+    \overload
+
+    Starts the I/O thread if it is not running yet and establishes a connection
+    to the KNXnet/IP server at \a address and \a port. The current settings are
+    copied to the tunnel connection. The call returns immediately, the
+    \l connected() signal is emitted once the connection is established.
+
+    Nothing happens if the connection is not disconnected.
+*/
+void QKnxNetIpThreadedTunnelConnection::connectToHost(const QHostAddress &address, quint16 port)
+{
+    Q_D(QKnxNetIpThreadedTunnelConnection);
+    if (!d->state.testAndSetOrdered(QKnxNetIpEndpointConnection::State::Disconnected,
+        QKnxNetIpEndpointConnection::State::Starting)) {
+        return;
+    }
+
+    d->setupWorker();
+
+    const auto settings = d->settings;
+    auto c = d->connection;
+    QMetaObject::invokeMethod(c, [d, c, settings, address, port]() {
+        c->setNatAware(settings.nat);
+        c->setSingleSocket(settings.singleSocket);
+        c->setHeartbeatTimeout(settings.heartbeatTimeout);
+        c->setMaximumSendQueueSize(settings.maxSendQueueSize);
+        c->setAutoReconnect(settings.reconnect);
+        c->setMaximumReconnectAttempts(settings.maxReconnectAttempts);
+        c->setReconnectInterval(settings.reconnectInterval);
+        c->setMaximumReconnectInterval(settings.maxReconnectInterval);
+        c->connectToHost(address, port);
+
+        // invalid addresses are rejected without a state change
+        if (c->state() == QKnxNetIpEndpointConnection::State::Disconnected)
+            d->state.storeRelease(QKnxNetIpEndpointConnection::State::Disconnected);
+    }, Qt::QueuedConnection);
+}
+
+/*!
+    Closes the connection to the KNXnet/IP server and stops reconnecting. The
+    call returns immediately, the \l disconnected() signal is emitted once the
+    connection is closed. The I/O thread keeps running until the object is
+    destroyed.
+
+    \sa QKnxNetIpEndpointConnection::disconnectFromHost()
+*/
+void QKnxNetIpThreadedTunnelConnection::disconnectFromHost()
+{
+    Q_D(QKnxNetIpThreadedTunnelConnection);
+    if (!d->connection)
+        return;
+
+    auto c = d->connection;
+    QMetaObject::invokeMethod(c, [c]() { c->disconnectFromHost(); }, Qt::QueuedConnection);
+}
+
+/*!
+    Hands the \a frame over to the I/O thread, which queues it on the tunnel
+    connection.
+
+    Returns \c true if the frame was handed over; \c false if the connection is
+    not established, the tunnel is in busmonitor mode, or the ring buffer is
+    full.
+
+    \sa QKnxNetIpTunnelConnection::sendTunnelFrame()
+*/
+bool QKnxNetIpThreadedTunnelConnection::sendTunnelFrame(const QKnxLinkLayerFrame &frame)
+{
+    if (state() != QKnxNetIpEndpointConnection::State::Connected)
+        return false;
+
+    Q_D(QKnxNetIpThreadedTunnelConnection);
+    if (d->layer == QKnxNetIp::TunnelingLayer::Busmonitor)
+        return false; // 03_08_04 Tunneling v01.05.03, paragraph 2.4
+
+    if (!d->outbound.push(frame)) {
+        d->droppedFrames.fetchAndAddRelaxed(1);
+        return false;
+    }
+
+    if (d->outboundWakeup.testAndSetAcquire(0, 1)) {
+        QMetaObject::invokeMethod(d->connection, [d]() { d->sendQueuedFrames(); },
+            Qt::QueuedConnection);
+    }
+    return true;
+}
+
+QKnxNetIpThreadedTunnelConnection::QKnxNetIpThreadedTunnelConnection(
+        QKnxNetIpThreadedTunnelConnectionPrivate &dd, QObject *parent)
+    : QObject(dd, parent)
+{}
+
+QT_END_NAMESPACE
@@ -0,0 +1,114 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPTHREADEDTUNNELCONNECTION_H
+#define QKNXNETIPTHREADEDTUNNELCONNECTION_H
+
+#include <QtCore/qobject.h>
+#include <QtKnx/qknxglobal.h>
+#include <QtKnx/qknxlinklayerframe.h>
+#include <QtKnx/qknxnetip.h>
+#include <QtKnx/qknxnetiphpai.h>
+#include <QtKnx/qknxnetiptunnelconnection.h>
+#include <QtNetwork/qhostaddress.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxNetIpThreadedTunnelConnectionPrivate;
+
+class Q_KNX_EXPORT QKnxNetIpThreadedTunnelConnection final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(QKnxNetIpThreadedTunnelConnection)
+    Q_DECLARE_PRIVATE(QKnxNetIpThreadedTunnelConnection)
+
+public:
+    QKnxNetIpThreadedTunnelConnection(QObject *parent = nullptr);
+    ~QKnxNetIpThreadedTunnelConnection() override;
+
+    QKnxNetIpThreadedTunnelConnection(const QHostAddress &localAddress, QObject *parent = nullptr);
+    QKnxNetIpThreadedTunnelConnection(const QHostAddress &localAddress, quint16 localPort,
+        QObject *parent = nullptr);
+    QKnxNetIpThreadedTunnelConnection(const QHostAddress &localAddress, quint16 localPort,
+        QKnxNetIp::TunnelingLayer layer, QObject *parent = nullptr);
+
+    QKnxNetIpEndpointConnection::State state() const;
+
+    bool natAware() const;
+    void setNatAware(bool isAware);
+
+    bool singleSocket() const;
+    void setSingleSocket(bool single);
+
+    bool autoReconnect() const;
+    void setAutoReconnect(bool enabled);
+
+    quint32 heartbeatTimeout() const;
+    void setHeartbeatTimeout(quint32 msec);
+
+    int maximumSendQueueSize() const;
+    void setMaximumSendQueueSize(int size);
+
+    int maximumReconnectAttempts() const;
+    void setMaximumReconnectAttempts(int attempts);
+
+    quint32 reconnectInterval() const;
+    void setReconnectInterval(quint32 msec);
+
+    quint32 maximumReconnectInterval() const;
+    void setMaximumReconnectInterval(quint32 msec);
+
+    int queueCapacity() const;
+    quint32 droppedFrameCount() const;
+    QKnxNetIpConnectionStatistics statistics() const;
+
+    void connectToHost(const QKnxNetIpHpai &controlEndpoint);
+    void connectToHost(const QHostAddress &address, quint16 port);
+
+    void disconnectFromHost();
+
+    bool sendTunnelFrame(const QKnxLinkLayerFrame &frame);
+
+Q_SIGNALS:
+    void connected();
+    void disconnected();
+
+    void stateChanged(QKnxNetIpEndpointConnection::State state);
+    void errorOccurred(QKnxNetIpEndpointConnection::Error error, QString errorString);
+
+    void receivedTunnelFrame(QKnxLinkLayerFrame frame);
+
+private:
+    QKnxNetIpThreadedTunnelConnection(QKnxNetIpThreadedTunnelConnectionPrivate &dd,
+        QObject *parent);
+};
+
+QT_END_NAMESPACE
+
+#endif
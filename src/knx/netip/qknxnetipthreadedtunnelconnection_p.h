@@ -0,0 +1,111 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPTHREADEDTUNNELCONNECTION_P_H
+#define QKNXNETIPTHREADEDTUNNELCONNECTION_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qthread.h>
+#include <QtKnx/qknxglobal.h>
+#include <QtKnx/qknxlinklayerframe.h>
+#include <QtKnx/qknxnetipthreadedtunnelconnection.h>
+#include <QtKnx/qknxnetiptunnelconnection.h>
+#include <QtNetwork/qhostaddress.h>
+
+#include <private/qknxspscringbuffer_p.h>
+#include <private/qobject_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class Q_KNX_EXPORT QKnxNetIpThreadedTunnelConnectionPrivate final : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QKnxNetIpThreadedTunnelConnection)
+
+public:
+    QKnxNetIpThreadedTunnelConnectionPrivate(const QHostAddress &addr, quint16 port,
+        QKnxNetIp::TunnelingLayer layer);
+    ~QKnxNetIpThreadedTunnelConnectionPrivate() override = default;
+
+    void setupWorker();
+    void stopWorker();
+
+    // called on the I/O thread
+    void frameReceived(const QKnxLinkLayerFrame &frame);
+    void sendQueuedFrames();
+
+    // called on the thread owning the public object
+    void emitReceivedFrames();
+
+private:
+    QHostAddress address;
+    quint16 port { 0 };
+    QKnxNetIp::TunnelingLayer layer { QKnxNetIp::TunnelingLayer::Link };
+
+    // copied to the tunnel connection on the I/O thread on each connect
+    struct Settings
+    {
+        bool nat { false };
+        bool singleSocket { false };
+        quint32 heartbeatTimeout { QKnxNetIp::HeartbeatTimeout };
+        int maxSendQueueSize { 64 };
+
+        bool reconnect { false };
+        int maxReconnectAttempts { 10 };
+        quint32 reconnectInterval { 1000 };
+        quint32 maxReconnectInterval { 60000 };
+    } settings;
+
+    QThread *thread { nullptr };
+    QKnxNetIpTunnelConnection *connection { nullptr };
+
+    // frames in both directions pass the thread boundary through the ring buffers, the flags
+    // make sure only one wakeup per direction is in flight
+    QKnxSpscRingBuffer<QKnxLinkLayerFrame> inbound;
+    QKnxSpscRingBuffer<QKnxLinkLayerFrame> outbound;
+    QAtomicInt inboundWakeup { 0 };
+    QAtomicInt outboundWakeup { 0 };
+    QAtomicInteger<quint32> droppedFrames { 0 };
+
+    QAtomicInt state { QKnxNetIpEndpointConnection::State::Disconnected };
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,111 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxnetiptrace_p.h"
+
+#include <QtCore/qdatetime.h>
+#include <QtCore/qendian.h>
+
+QT_BEGIN_NAMESPACE
+
+Q_LOGGING_CATEGORY(QT_KNX_NETIP, "qt.knx.netip")
+Q_LOGGING_CATEGORY(QT_KNX_NETIP_FRAMES, "qt.knx.netip.frames")
+
+void QKnxNetIpFrameTrace::setCapacity(int bytes)
+{
+    m_capacity = qMax(0, bytes);
+    m_buffer = QByteArray(m_capacity, Qt::Uninitialized);
+    clear();
+}
+
+QByteArray QKnxNetIpFrameTrace::toByteArray() const
+{
+    QByteArray bytes(m_size, Qt::Uninitialized);
+    read(m_head, bytes.data(), m_size);
+    return bytes;
+}
+
+void QKnxNetIpFrameTrace::clear()
+{
+    m_head = 0;
+    m_size = 0;
+
+    m_clock.start();
+    m_epoch = QDateTime::currentMSecsSinceEpoch() * 1000;
+}
+
+void QKnxNetIpFrameTrace::append(Direction direction, const char *data, int size)
+{
+    const int length = RecordHeaderSize + size;
+    if (size > 0xffff || length > m_capacity)
+        return;
+
+    while (m_capacity - m_size < length)
+        dropOldest();
+
+    char header[RecordHeaderSize];
+    qToLittleEndian<qint64>(m_epoch + m_clock.nsecsElapsed() / 1000, header);
+    header[8] = char(direction);
+    qToLittleEndian<quint16>(quint16(size), header + 9);
+
+    write(header, RecordHeaderSize);
+    write(data, size);
+}
+
+void QKnxNetIpFrameTrace::dropOldest()
+{
+    char size[2];
+    read((m_head + 9) % m_capacity, size, 2);
+
+    const int length = RecordHeaderSize + qFromLittleEndian<quint16>(size);
+    m_head = (m_head + length) % m_capacity;
+    m_size -= length;
+}
+
+void QKnxNetIpFrameTrace::write(const char *data, int size)
+{
+    if (size <= 0)
+        return;
+    const int tail = (m_head + m_size) % m_capacity;
+    const int first = qMin(size, m_capacity - tail);
+    memcpy(m_buffer.data() + tail, data, size_t(first));
+    memcpy(m_buffer.data(), data + first, size_t(size - first));
+    m_size += size;
+}
+
+void QKnxNetIpFrameTrace::read(int position, char *data, int size) const
+{
+    if (size <= 0)
+        return;
+    const int first = qMin(size, m_capacity - position);
+    memcpy(data, m_buffer.constData() + position, size_t(first));
+    memcpy(data + first, m_buffer.constData(), size_t(size - first));
+}
+
+QT_END_NAMESPACE
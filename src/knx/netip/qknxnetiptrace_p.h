@@ -0,0 +1,114 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPTRACE_P_H
+#define QKNXNETIPTRACE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qloggingcategory.h>
+#include <QtKnx/qknxglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+// Connection life cycle: connect, disconnect, reconnect and ignored frames.
+Q_DECLARE_LOGGING_CATEGORY(QT_KNX_NETIP)
+// Hex dump of every frame sent or received, formatted only if the category is enabled.
+Q_DECLARE_LOGGING_CATEGORY(QT_KNX_NETIP_FRAMES)
+
+// Records raw frames with a timestamp into a fixed size byte ring, overwriting the oldest
+// records once it is full. A capacity of zero disables the trace, recording then costs a
+// single branch. Each record is laid out as
+//
+//     qint64  microseconds since epoch, little endian
+//     quint8  direction, 0 received, 1 sent
+//     quint16 frame size, little endian
+//     quint8  frame bytes[frame size]
+//
+class Q_KNX_EXPORT QKnxNetIpFrameTrace final
+{
+public:
+    enum class Direction : quint8
+    {
+        Received = 0x00,
+        Sent = 0x01
+    };
+
+    static constexpr const int RecordHeaderSize = 11;
+
+    int capacity() const { return m_capacity; }
+    void setCapacity(int bytes);
+
+    bool isEnabled() const { return m_capacity > 0; }
+    int size() const { return m_size; }
+
+    void record(Direction direction, const char *data, int size)
+    {
+        if (m_capacity > 0)
+            append(direction, data, size);
+    }
+    void record(Direction direction, const QByteArray &data)
+    {
+        record(direction, data.constData(), data.size());
+    }
+
+    QByteArray toByteArray() const;
+    void clear();
+
+private:
+    void append(Direction direction, const char *data, int size);
+    void dropOldest();
+
+    void write(const char *data, int size);
+    void read(int position, char *data, int size) const;
+
+private:
+    QByteArray m_buffer;
+    int m_capacity { 0 };
+    int m_head { 0 };
+    int m_size { 0 };
+
+    qint64 m_epoch { 0 };
+    QElapsedTimer m_clock;
+};
+
+QT_END_NAMESPACE
+
+#endif
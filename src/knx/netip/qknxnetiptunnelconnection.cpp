@@ -82,15 +82,13 @@ public:
 
     void process(const QKnxNetIpConnectResponse &response, const QNetworkDatagram &dg) override
     {
-        if (response.status() == QKnxNetIp::Error::NoMoreUniqueConnections) {
-            Q_ASSERT_X(false, "QKnxNetIpTunnelConnectionPrivate::process", "NoMoreUniqueConnections "
-                "error handling not implemented yet.");
-            // TODO: Maybe implement 03_08_04 Tunneling v01.05.03 AS.pdf, paragraph 3.3
-        }
-
+        // A refused connection, e.g. NoMoreUniqueConnections, is reported and retried by the
+        // endpoint connection if automatic reconnection is enabled.
         Q_Q(QKnxNetIpTunnelConnection);
-        if (q->state() != QKnxNetIpTunnelConnection::Connected)
+        if (q->state() != QKnxNetIpTunnelConnection::Connected
+            && response.status() == QKnxNetIp::Error::None) {
             m_address = response.responseData().individualAddress();
+        }
         QKnxNetIpEndpointConnectionPrivate::process(response, dg);
     }
 
@@ -145,6 +143,18 @@ void QKnxNetIpTunnelConnection::setTunnelingLayer(QKnxNetIp::TunnelingLayer laye
     d_func()->m_layer = layer;
 }
 
+/*!
+    Queues the \a frame for sending to the KNXnet/IP server. Frames are sent one
+    at a time; the next frame leaves the queue once the previous one has been
+    acknowledged. Frames with a higher KNX priority are sent first.
+
+    Returns \c true if the frame was queued; \c false if the connection is not
+    established, the tunnel is in busmonitor mode, or the send queue is full.
+    In the latter case the frame is dropped and the \l frameDropped() signal
+    is emitted.
+
+    \sa maximumSendQueueSize(), sendQueueSize()
+*/
 bool QKnxNetIpTunnelConnection::sendTunnelFrame(const QKnxLinkLayerFrame &frame)
 {
     if (state() != State::Connected)
@@ -0,0 +1,403 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxnetiptunnelconnectionpool.h"
+#include "qknxnetiptunnelconnectionpool_p.h"
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QKnxNetIpTunnelConnectionPool
+
+    \inmodule QtKnx
+    \brief The QKnxNetIpTunnelConnectionPool class opens several tunnel
+    connections to the same KNXnet/IP server and uses them in parallel.
+
+    A single \l QKnxNetIpTunnelConnection waits for the acknowledge of each
+    tunneling request before sending the next one. Many KNXnet/IP interfaces
+    offer more than one tunnel, so the throughput to a single interface can be
+    raised by opening several of them.
+
+    The pool opens up to \l size() tunnels, one after the other. If the server
+    refuses a connection, the pool keeps working with the tunnels that are
+    already established. Outgoing frames are spread over the connected tunnels
+    by their destination address, so all frames sent to the same address use
+    the same tunnel and keep their order. Frames received on any tunnel are
+    emitted through the \l receivedTunnelFrame() signal.
+
+    \note The mapping from destination address to tunnel changes if the number
+    of connected tunnels changes.
+
+    \code
+        QKnxNetIpTunnelConnectionPool pool;
+        QHostAddress clientLocalAddress = ...
+        pool.setLocalAddress(clientLocalAddress);
+        pool.setSize(4);
+
+        QHostAddress knxNetIpServerAddress = ...
+        quint16 knxNetIpServerControlEndPointPort = ...
+        pool.connectToHost(knxNetIpServerAddress, knxNetIpServerControlEndPointPort);
+
+        QKnxLinkLayerFrame frame = ...
+        pool.sendTunnelFrame(frame);
+    \endcode
+*/
+
+// -- QKnxNetIpTunnelConnectionPoolPrivate
+
+QKnxNetIpTunnelConnectionPoolPrivate::QKnxNetIpTunnelConnectionPoolPrivate(
+        const QHostAddress &addr, int count)
+    : address(addr)
+    , size(count)
+{}
+
+void QKnxNetIpTunnelConnectionPoolPrivate::setupConnections()
+{
+    clearConnections();
+
+    Q_Q(QKnxNetIpTunnelConnectionPool);
+    for (int i = 0; i < size; ++i) {
+        auto connection = new QKnxNetIpTunnelConnection(address, q);
+        connections.append(connection);
+
+        QObject::connect(connection, &QKnxNetIpTunnelConnection::receivedTunnelFrame, q,
+            &QKnxNetIpTunnelConnectionPool::receivedTunnelFrame);
+        QObject::connect(connection, &QKnxNetIpTunnelConnection::connected, q, [this, i]() {
+            connectionConnected(i);
+        });
+        QObject::connect(connection, &QKnxNetIpTunnelConnection::disconnected, q, [this, i]() {
+            connectionDisconnected(i);
+        });
+        QObject::connect(connection, &QKnxNetIpTunnelConnection::errorOccurred, q,
+            [this, i](QKnxNetIpEndpointConnection::Error error, const QString &errorString) {
+                Q_Q(QKnxNetIpTunnelConnectionPool);
+                emit q->errorOccurred(i, error, errorString);
+        });
+    }
+}
+
+void QKnxNetIpTunnelConnectionPoolPrivate::clearConnections()
+{
+    Q_Q(QKnxNetIpTunnelConnectionPool);
+    for (auto connection : qAsConst(connections)) {
+        connection->disconnect(q);
+        connection->deleteLater();
+    }
+    connections.clear();
+    active.clear();
+}
+
+void QKnxNetIpTunnelConnectionPoolPrivate::openConnection(int index)
+{
+    if (index >= connections.size()) {
+        opening = -1;
+        return;
+    }
+
+    opening = index;
+    auto connection = connections.at(index);
+    connection->connectToHost(remoteAddress, remotePort);
+
+    // address validation errors do not leave the disconnected state, so there is no signal
+    if (connection->state() == QKnxNetIpEndpointConnection::State::Disconnected
+        && opening == index) {
+        connectionDisconnected(index);
+    }
+}
+
+void QKnxNetIpTunnelConnectionPoolPrivate::connectionConnected(int index)
+{
+    auto connection = connections.value(index);
+    if (!connection || active.contains(connection))
+        return;
+
+    // keep the connected tunnels sorted by index, the address mapping depends on the order
+    auto it = std::find_if(active.begin(), active.end(), [&](QKnxNetIpTunnelConnection *c) {
+        return connections.indexOf(c) > index;
+    });
+    active.insert(it, connection);
+
+    Q_Q(QKnxNetIpTunnelConnectionPool);
+    emit q->connectedCountChanged(active.size());
+    if (active.size() == 1)
+        emit q->connected();
+
+    if (opening == index)
+        openConnection(index + 1);
+}
+
+void QKnxNetIpTunnelConnectionPoolPrivate::connectionDisconnected(int index)
+{
+    Q_Q(QKnxNetIpTunnelConnectionPool);
+    if (active.removeOne(connections.value(index)))
+        emit q->connectedCountChanged(active.size());
+
+    // the server refused the tunnel, do not ask for further ones
+    if (opening == index)
+        opening = -1;
+
+    if (running && opening < 0 && active.isEmpty()) {
+        running = false;
+        emit q->disconnected();
+    }
+}
+
+QKnxNetIpTunnelConnection *QKnxNetIpTunnelConnectionPoolPrivate::connectionFor(
+    const QKnxAddress &destination) const
+{
+    if (active.isEmpty())
+        return nullptr;
+    return active.at(int(qHash(destination, 0) % uint(active.size())));
+}
+
+
+// -- QKnxNetIpTunnelConnectionPool
+
+/*!
+    Creates a pool of up to four tunnel connections with the parent \a parent.
+    The tunnels bind to the local host.
+*/
+QKnxNetIpTunnelConnectionPool::QKnxNetIpTunnelConnectionPool(QObject *parent)
+    : QKnxNetIpTunnelConnectionPool(QHostAddress(QHostAddress::LocalHost), parent)
+{}
+
+/*!
+    Destroys the pool and all of its tunnel connections. Connected tunnels are
+    closed without emitting any further signals of the pool.
+*/
+QKnxNetIpTunnelConnectionPool::~QKnxNetIpTunnelConnectionPool()
+{
+    Q_D(QKnxNetIpTunnelConnectionPool);
+    for (auto connection : qAsConst(d->connections))
+        connection->disconnect(this);
+}
+
+/*!
+    Creates a pool of up to four tunnel connections with the parent \a parent.
+    The tunnels bind to \a localAddress.
+*/
+QKnxNetIpTunnelConnectionPool::QKnxNetIpTunnelConnectionPool(const QHostAddress &localAddress,
+        QObject *parent)
+    : QKnxNetIpTunnelConnectionPool(localAddress, 4, parent)
+{}
+
+/*!
+    Creates a pool of up to \a size tunnel connections with the parent
+    \a parent. The tunnels bind to \a localAddress. A \a size smaller than
+    \c 1 opens a single tunnel.
+*/
+QKnxNetIpTunnelConnectionPool::QKnxNetIpTunnelConnectionPool(const QHostAddress &localAddress,
+        int size, QObject *parent)
+    : QKnxNetIpTunnelConnectionPool(*new QKnxNetIpTunnelConnectionPoolPrivate(localAddress,
+        qMax(1, size)), parent)
+{}
+
+/*!
+    Returns the local address the tunnels bind to.
+*/
+QHostAddress QKnxNetIpTunnelConnectionPool::localAddress() const
+{
+    Q_D(const QKnxNetIpTunnelConnectionPool);
+    return d->address;
+}
+
+/*!
+    Sets the local address the tunnels bind to to \a address. The value can
+    only be changed while the pool is disconnected.
+*/
+void QKnxNetIpTunnelConnectionPool::setLocalAddress(const QHostAddress &address)
+{
+    Q_D(QKnxNetIpTunnelConnectionPool);
+    if (d->running)
+        return;
+    d->address = address;
+}
+
+/*!
+    Returns the maximum number of tunnels the pool opens. The default is \c 4.
+*/
+int QKnxNetIpTunnelConnectionPool::size() const
+{
+    Q_D(const QKnxNetIpTunnelConnectionPool);
+    return d->size;
+}
+
+/*!
+    Sets the maximum number of tunnels the pool opens to \a size. The value
+    can only be changed while the pool is disconnected.
+*/
+void QKnxNetIpTunnelConnectionPool::setSize(int size)
+{
+    Q_D(QKnxNetIpTunnelConnectionPool);
+    if (d->running || size < 1)
+        return;
+    d->size = size;
+}
+
+/*!
+    Returns the number of tunnels that are currently connected. Outgoing frames
+    are spread over this many tunnels.
+
+    \sa connectedCountChanged()
+*/
+int QKnxNetIpTunnelConnectionPool::connectedCount() const
+{
+    Q_D(const QKnxNetIpTunnelConnectionPool);
+    return d->active.size();
+}
+
+/*!
+    Returns all tunnel connections of the pool, including the ones that are not
+    connected. The connections are owned by the pool and recreated on each call
+    to \l connectToHost().
+*/
+QVector<QKnxNetIpTunnelConnection *> QKnxNetIpTunnelConnectionPool::connections() const
+{
+    Q_D(const QKnxNetIpTunnelConnectionPool);
+    return d->connections;
+}
+
+/*!
+    Returns the tunnel connection used for frames sent to \a destination, or
+    \c nullptr if no tunnel is connected.
+*/
+QKnxNetIpTunnelConnection *QKnxNetIpTunnelConnectionPool::connection(
+    const QKnxAddress &destination) const
+{
+    Q_D(const QKnxNetIpTunnelConnectionPool);
+    return d->connectionFor(destination);
+}
+
+/*!
+    Opens the tunnels to the KNXnet/IP server at \a controlEndpoint.
+*/
+void QKnxNetIpTunnelConnectionPool::connectToHost(const QKnxNetIpHpai &controlEndpoint)
+{
+    connectToHost(controlEndpoint.address(), controlEndpoint.port());
+}
+
+/*!
+    \overload
+
+    Opens the tunnels to the KNXnet/IP server at \a address and \a port. The
+    tunnels are created anew and opened one after the other, each after the
+    previous one was established. The first refused or failed tunnel ends the
+    sequence. The \l connected() signal is emitted as soon as the first tunnel
+    is established.
+
+    Nothing happens if the pool is already connected or connecting.
+*/
+void QKnxNetIpTunnelConnectionPool::connectToHost(const QHostAddress &address, quint16 port)
+{
+    Q_D(QKnxNetIpTunnelConnectionPool);
+    if (d->running)
+        return;
+
+    d->running = true;
+    d->remoteAddress = address;
+    d->remotePort = port;
+
+    d->setupConnections();
+    d->openConnection(0);
+}
+
+/*!
+    Closes all tunnels. The \l disconnected() signal is emitted once the last
+    tunnel is closed.
+*/
+void QKnxNetIpTunnelConnectionPool::disconnectFromHost()
+{
+    Q_D(QKnxNetIpTunnelConnectionPool);
+    if (!d->running)
+        return;
+
+    d->opening = -1;
+    const auto connections = d->connections;
+    for (auto connection : connections)
+        connection->disconnectFromHost();
+}
+
+/*!
+    Queues the \a frame on the tunnel selected by its destination address.
+
+    Returns \c true if the frame was queued; \c false if no tunnel is connected
+    or the selected tunnel could not queue the frame.
+
+    \sa QKnxNetIpTunnelConnection::sendTunnelFrame()
+*/
+bool QKnxNetIpTunnelConnectionPool::sendTunnelFrame(const QKnxLinkLayerFrame &frame)
+{
+    Q_D(QKnxNetIpTunnelConnectionPool);
+    if (auto connection = d->connectionFor(frame.destinationAddress()))
+        return connection->sendTunnelFrame(frame);
+    return false;
+}
+
+/*!
+    \fn void QKnxNetIpTunnelConnectionPool::connected()
+
+    This signal is emitted when the first tunnel of the pool is established.
+*/
+
+/*!
+    \fn void QKnxNetIpTunnelConnectionPool::disconnected()
+
+    This signal is emitted when the last tunnel of the pool was closed and no
+    further tunnel is being opened.
+*/
+
+/*!
+    \fn void QKnxNetIpTunnelConnectionPool::connectedCountChanged(int count)
+
+    This signal is emitted when a tunnel is established or closed, with \a count
+    being the new number of connected tunnels. Frames sent to the same
+    destination address might use another tunnel afterwards.
+*/
+
+/*!
+    \fn void QKnxNetIpTunnelConnectionPool::receivedTunnelFrame(QKnxLinkLayerFrame frame)
+
+    This signal is emitted when any of the tunnels received the \a frame.
+*/
+
+/*!
+    \fn void QKnxNetIpTunnelConnectionPool::errorOccurred(int index, QKnxNetIpEndpointConnection::Error error, QString errorString)
+
+    This signal is emitted when the tunnel at position \a index in
+    \l connections() reports the \a error with the text \a errorString.
+*/
+
+QKnxNetIpTunnelConnectionPool::QKnxNetIpTunnelConnectionPool(
+        QKnxNetIpTunnelConnectionPoolPrivate &dd, QObject *parent)
+    : QObject(dd, parent)
+{}
+
+QT_END_NAMESPACE
@@ -0,0 +1,91 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPTUNNELCONNECTIONPOOL_H
+#define QKNXNETIPTUNNELCONNECTIONPOOL_H
+
+#include <QtCore/qobject.h>
+#include <QtCore/qvector.h>
+#include <QtKnx/qknxglobal.h>
+#include <QtKnx/qknxlinklayerframe.h>
+#include <QtKnx/qknxnetiphpai.h>
+#include <QtKnx/qknxnetiptunnelconnection.h>
+#include <QtNetwork/qhostaddress.h>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxNetIpTunnelConnectionPoolPrivate;
+
+class Q_KNX_EXPORT QKnxNetIpTunnelConnectionPool final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(QKnxNetIpTunnelConnectionPool)
+    Q_DECLARE_PRIVATE(QKnxNetIpTunnelConnectionPool)
+
+public:
+    QKnxNetIpTunnelConnectionPool(QObject *parent = nullptr);
+    ~QKnxNetIpTunnelConnectionPool() override;
+
+    explicit QKnxNetIpTunnelConnectionPool(const QHostAddress &localAddress,
+        QObject *parent = nullptr);
+    QKnxNetIpTunnelConnectionPool(const QHostAddress &localAddress, int size,
+        QObject *parent = nullptr);
+
+    QHostAddress localAddress() const;
+    void setLocalAddress(const QHostAddress &address);
+
+    int size() const;
+    void setSize(int size);
+
+    int connectedCount() const;
+    QVector<QKnxNetIpTunnelConnection *> connections() const;
+    QKnxNetIpTunnelConnection *connection(const QKnxAddress &destination) const;
+
+    void connectToHost(const QKnxNetIpHpai &controlEndpoint);
+    void connectToHost(const QHostAddress &address, quint16 port);
+
+    void disconnectFromHost();
+
+    bool sendTunnelFrame(const QKnxLinkLayerFrame &frame);
+
+Q_SIGNALS:
+    void connected();
+    void disconnected();
+    void connectedCountChanged(int count);
+
+    void receivedTunnelFrame(QKnxLinkLayerFrame frame);
+    void errorOccurred(int index, QKnxNetIpEndpointConnection::Error error, QString errorString);
+
+private:
+    QKnxNetIpTunnelConnectionPool(QKnxNetIpTunnelConnectionPoolPrivate &dd, QObject *parent);
+};
+
+QT_END_NAMESPACE
+
+#endif
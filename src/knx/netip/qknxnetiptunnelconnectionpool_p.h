@@ -0,0 +1,88 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPTUNNELCONNECTIONPOOL_P_H
+#define QKNXNETIPTUNNELCONNECTIONPOOL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qvector.h>
+#include <QtKnx/qknxglobal.h>
+#include <QtKnx/qknxnetiptunnelconnection.h>
+#include <QtKnx/qknxnetiptunnelconnectionpool.h>
+#include <QtNetwork/qhostaddress.h>
+
+#include <private/qobject_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class Q_KNX_EXPORT QKnxNetIpTunnelConnectionPoolPrivate final : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QKnxNetIpTunnelConnectionPool)
+
+public:
+    QKnxNetIpTunnelConnectionPoolPrivate(const QHostAddress &addr, int count);
+    ~QKnxNetIpTunnelConnectionPoolPrivate() override = default;
+
+    void setupConnections();
+    void clearConnections();
+    void openConnection(int index);
+
+    void connectionConnected(int index);
+    void connectionDisconnected(int index);
+
+    QKnxNetIpTunnelConnection *connectionFor(const QKnxAddress &destination) const;
+
+private:
+    QHostAddress address { QHostAddress::LocalHost };
+    int size { 4 };
+
+    QHostAddress remoteAddress;
+    quint16 remotePort { 0 };
+
+    bool running { false };
+    int opening { -1 };
+
+    // all tunnels in index order, and the subset that is currently connected
+    QVector<QKnxNetIpTunnelConnection *> connections;
+    QVector<QKnxNetIpTunnelConnection *> active;
+};
+
+QT_END_NAMESPACE
+
+#endif
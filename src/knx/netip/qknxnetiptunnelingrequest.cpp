@@ -56,7 +56,7 @@ quint8 QKnxNetIpTunnelingRequest::sequenceCount() const
 QKnxLinkLayerFrame QKnxNetIpTunnelingRequest::cemi() const
 {
     auto ref = payloadRef(connectionHeaderSize());
-    return QKnxLinkLayerFrame::fromBytes(ref.bytes<QByteArray>(), 0, ref.size());
+    return QKnxLinkLayerFrame::fromBytes(ref, 0, ref.size());
 }
 
 bool QKnxNetIpTunnelingRequest::isValid() const
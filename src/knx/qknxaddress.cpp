@@ -31,6 +31,135 @@
 
 QT_BEGIN_NAMESPACE
 
+static inline ushort unicode(QChar c) { return c.unicode(); }
+static inline ushort unicode(char c) { return uchar(c); }
+
+static inline bool isSpace(ushort c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+static inline int digitValue(ushort c, int base)
+{
+    int value = base;
+    if (c >= '0' && c <= '9')
+        value = c - '0';
+    else if (c >= 'a' && c <= 'f')
+        value = c - 'a' + 10;
+    else if (c >= 'A' && c <= 'F')
+        value = c - 'A' + 10;
+    return value < base ? value : -1;
+}
+
+// Parses a single address section and advances \a it behind it. Follows the rules of
+// QString::toUShort() with base 0: a leading "0x" selects hexadecimal, a leading "0" octal and
+// anything else decimal notation. Surrounding white space is skipped.
+template <typename Char>
+static bool parseSection(const Char *&it, const Char *end, quint16 *value)
+{
+    while (it != end && isSpace(unicode(*it)))
+        ++it;
+
+    int base = 10;
+    if (it != end && unicode(*it) == '0' && (end - it) > 1) {
+        const ushort next = unicode(it[1]);
+        if (next == 'x' || next == 'X') {
+            base = 16;
+            it += 2;
+        } else if (next >= '0' && next <= '9') {
+            base = 8;
+            ++it;
+        }
+    }
+
+    uint result = 0;
+    const Char *const begin = it;
+    for (int digit; it != end && (digit = digitValue(unicode(*it), base)) >= 0; ++it) {
+        result = result * uint(base) + uint(digit);
+        if (result > 0xffff)
+            return false;
+    }
+    if (it == begin)
+        return false;
+
+    while (it != end && isSpace(unicode(*it)))
+        ++it;
+    *value = quint16(result);
+    return true;
+}
+
+template <typename Char>
+static QKnxAddress parseAddress(QKnxAddress::Type type, const Char *it, const Char *end)
+{
+    quint16 sections[3];
+    ushort separator = 0;
+    int count = 0;
+    for (;;) {
+        if (!parseSection(it, end, &sections[count++]))
+            return {};
+        if (it == end)
+            break;
+        const ushort c = unicode(*it++);
+        if (count == 3 || (c != '/' && c != '.') || (separator && c != separator))
+            return {};
+        separator = c;
+    }
+
+    if (count == 1)
+        return { type, sections[0] };
+
+    // the sections passed as quint8 below need to fit, the factories check the actual range
+    if (sections[0] > 0xff || (count == 3 && sections[2] > 0xff))
+        return {};
+
+    if (separator == '/' && type == QKnxAddress::Type::Group) {
+        if (count == 2)
+            return QKnxAddress::createGroup(quint8(sections[0]), sections[1]);
+        return QKnxAddress::createGroup(quint8(sections[0]), sections[1], quint8(sections[2]));
+    }
+    if (separator == '.' && type == QKnxAddress::Type::Individual && count == 3)
+        return QKnxAddress::createIndividual(quint8(sections[0]), sections[1], quint8(sections[2]));
+    return {};
+}
+
+// The longest formatted address is an individual address like 15.15.255.
+enum { MaxAddressLength = 9 };
+
+static inline QChar *formatNumber(QChar *out, uint value)
+{
+    if (value >= 1000)
+        *out++ = QLatin1Char(char('0' + value / 1000));
+    if (value >= 100)
+        *out++ = QLatin1Char(char('0' + value / 100 % 10));
+    if (value >= 10)
+        *out++ = QLatin1Char(char('0' + value / 10 % 10));
+    *out++ = QLatin1Char(char('0' + value % 10));
+    return out;
+}
+
+static int formatAddress(QKnxAddress::Type type, quint16 address, QKnxAddress::Notation notation,
+    QChar *buffer)
+{
+    QChar *out = buffer;
+    if (notation == QKnxAddress::Notation::ThreeLevel) {
+        if (type == QKnxAddress::Type::Group) {
+            out = formatNumber(out, (address >> 11) & 0x1f);
+            *out++ = QLatin1Char('/');
+            out = formatNumber(out, (address >> 8) & 0x07);
+            *out++ = QLatin1Char('/');
+            out = formatNumber(out, address & 0xff);
+        } else if (type == QKnxAddress::Type::Individual) {
+            out = formatNumber(out, (address >> 12) & 0x0f);
+            *out++ = QLatin1Char('.');
+            out = formatNumber(out, (address >> 8) & 0x0f);
+            *out++ = QLatin1Char('.');
+            out = formatNumber(out, address & 0xff);
+        }
+    } else if (notation == QKnxAddress::Notation::TwoLevel && type == QKnxAddress::Type::Group) {
+        out = formatNumber(out, (address >> 11) & 0x1f);
+        *out++ = QLatin1Char('/');
+        out = formatNumber(out, address & 0x07ff);
+    }
+    return int(out - buffer);
+}
+
 /*!
     \class QKnxAddress
 
@@ -127,43 +256,28 @@ QKnxAddress::QKnxAddress(QKnxAddress::Type type, quint16 address)
     and the sequential number value in the range \c 0 to \c 255.
 */
 QKnxAddress::QKnxAddress(QKnxAddress::Type type, const QString &address)
-{
-    const bool dots = address.contains(QLatin1Char('.'));
-    const bool slashes = address.contains(QLatin1Char('/'));
-    if (dots && slashes)
-        return;
+    : QKnxAddress(type, QStringView(address))
+{}
 
-    QVector<quint16> sections;
-    const auto convert = [&sections](const QVector<QStringRef> &in) -> bool {
-        for (const QStringRef &section : qAsConst(in)) {
-            bool ok = false;
-            const quint16 value = section.toUShort(&ok, 0);
-            if (!ok)
-                return false;
-            sections.append(value);
-        }
-        return in.size() == sections.size();
-    };
+/*!
+    Creates a KNX address from the string view \a address. The type of the
+    address is specified by \a type. The accepted formats are the same as for
+    the QString overload; the address is parsed in a single pass without any
+    memory allocation.
+*/
+QKnxAddress::QKnxAddress(QKnxAddress::Type type, QStringView address)
+    : QKnxAddress(parseAddress(type, address.data(), address.data() + address.size()))
+{}
 
-    if (slashes && type == QKnxAddress::Type::Group) {
-        if (!convert(address.splitRef(QLatin1Char('/'))))
-            return;
-        if (sections.count() == 2)
-            *this = QKnxAddress(type, sections[0], nullptr, sections[1]);
-        if (sections.count() == 3)
-            *this = QKnxAddress(type, sections[0], &sections[1], sections[2]);
-    }
-    if (dots && type == QKnxAddress::Type::Individual) {
-        if (convert(address.splitRef(QLatin1Char('.'))) && sections.count() == 3)
-            *this = QKnxAddress(type, sections[0], &sections[1], sections[2]);
-    }
-    if (type == QKnxAddress::Type::Group || type == QKnxAddress::Type::Individual) {
-        if (convert({ address.midRef(0) }) && sections.count() == 1) {
-            m_type = type;
-            m_address = sections[0];
-        }
-    }
-}
+/*!
+    Creates a KNX address from the Latin-1 string \a address. The type of the
+    address is specified by \a type. The accepted formats are the same as for
+    the QString overload; the address is parsed in a single pass without any
+    memory allocation.
+*/
+QKnxAddress::QKnxAddress(QKnxAddress::Type type, QLatin1String address)
+    : QKnxAddress(parseAddress(type, address.data(), address.data() + address.size()))
+{}
 
 /*!
     Creates a KNX address from the first two bytes of the \a address byte
@@ -291,8 +405,7 @@ bool QKnxAddress::isUnregistered() const
 */
 bool QKnxAddress::isValid() const
 {
-    return (m_type == QKnxAddress::Type::Group || m_type == QKnxAddress::Type::Individual)
-        && m_address >= 0;
+    return m_type == QKnxAddress::Type::Group || m_type == QKnxAddress::Type::Individual;
 }
 
 /*!
@@ -308,19 +421,25 @@ bool QKnxAddress::isValid() const
 */
 QString QKnxAddress::toString(Notation notation) const
 {
-    if (notation == QKnxAddress::Notation::ThreeLevel) {
-        if (m_type == QKnxAddress::Type::Group) {
-            return QStringLiteral("%1/%2/%3").arg((m_address >> 11) & 0x1f)
-                .arg((m_address >> 8) & 0x07).arg(m_address & 0xff);
-        }
-        if (m_type == QKnxAddress::Type::Individual) {
-            return QStringLiteral("%1.%2.%3").arg(m_address >> 12)
-                .arg((m_address >> 8) & 0x0f).arg(m_address & 0xff);
-        }
-    }
-    if (notation == QKnxAddress::Notation::TwoLevel && m_type == QKnxAddress::Type::Group)
-        return QStringLiteral("%1/%2").arg((m_address >> 11) & 0x1f).arg(m_address & 0x07ff);
-    return QString();
+    QChar buffer[MaxAddressLength];
+    const int length = formatAddress(m_type, m_address, notation, buffer);
+    return length > 0 ? QString(buffer, length) : QString();
+}
+
+/*!
+    Appends the KNX address to \a string, formatted the same way as toString()
+    would format it using \a notation. Nothing is appended if the address is
+    invalid or 2-level notation is requested for an \l Individual address.
+
+    Unlike toString(), this function does not create a temporary string and is
+    meant to be used when formatting a large number of addresses.
+*/
+void QKnxAddress::appendTo(QString &string, Notation notation) const
+{
+    QChar buffer[MaxAddressLength];
+    const int length = formatAddress(m_type, m_address, notation, buffer);
+    if (length > 0)
+        string.append(buffer, length);
 }
 
 bool QKnxAddress::operator==(const QKnxAddress &other) const
@@ -424,7 +543,9 @@ QKnxAddress::QKnxAddress(QKnxAddress::Type type, quint16 sec1, quint16 *sec2, qu
 
 uint qHash(const QKnxAddress &key, uint seed) Q_DECL_NOTHROW
 {
-    return qHash(key.bytes(), seed);
+    return qHash(key.key(), seed);
 }
 
+Q_STATIC_ASSERT(sizeof(QKnxAddress) == 4);
+
 QT_END_NAMESPACE
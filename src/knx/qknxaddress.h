@@ -34,6 +34,7 @@
 #include <QtCore/qdatastream.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qstring.h>
+#include <QtCore/qstringview.h>
 #include <QtCore/qvector.h>
 #include <QtKnx/qknxglobal.h>
 #include <QtKnx/qknxtraits.h>
@@ -60,6 +61,8 @@ public:
     QKnxAddress() = default;
     QKnxAddress(QKnxAddress::Type type, quint16 address);
     QKnxAddress(QKnxAddress::Type type, const QString &address);
+    QKnxAddress(QKnxAddress::Type type, QStringView address);
+    QKnxAddress(QKnxAddress::Type type, QLatin1String address);
     QKnxAddress(QKnxAddress::Type type, const QByteArray &address);
     QKnxAddress(QKnxAddress::Type type, const QVector<quint8> &address);
 
@@ -89,6 +92,7 @@ public:
     }
 
     QString toString(Notation notation = Notation::ThreeLevel) const;
+    void appendTo(QString &string, Notation notation = Notation::ThreeLevel) const;
 
     bool operator==(const QKnxAddress &other) const;
     bool operator!=(const QKnxAddress &other) const;
@@ -96,8 +100,16 @@ public:
 private:
     QKnxAddress(QKnxAddress::Type type, quint16 sec1, quint16 *sec2, quint16 sec3);
 
+    // type in the upper, address in the lower 16 bits; unique for every valid address
+    quint32 key() const { return quint32(m_type) << 16 | m_address; }
+
+    friend class QKnxGroupAddressSet;
+    template <typename T> friend class QKnxAddressMap;
+    friend Q_KNX_EXPORT uint qHash(const QKnxAddress &key, uint seed) Q_DECL_NOTHROW;
+
 private:
-    qint32 m_address = -1;
+    // packed into 4 bytes, an invalid address has an invalid type and the address set to 0
+    quint16 m_address = 0;
     QKnxAddress::Type m_type = static_cast<QKnxAddress::Type>(0xff);
 };
 
@@ -106,6 +118,7 @@ Q_KNX_EXPORT Q_DECL_PURE_FUNCTION uint qHash(const QKnxAddress &key, uint seed =
 Q_KNX_EXPORT QDebug operator<<(QDebug debug, const QKnxAddress &address);
 Q_KNX_EXPORT QDataStream &operator<<(QDataStream &stream, const QKnxAddress &address);
 
+Q_DECLARE_TYPEINFO(QKnxAddress, Q_MOVABLE_TYPE);
 Q_DECLARE_TYPEINFO(QKnxAddress::Type, Q_PRIMITIVE_TYPE);
 Q_DECLARE_TYPEINFO(QKnxAddress::Notation, Q_PRIMITIVE_TYPE);
 
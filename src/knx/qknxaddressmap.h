@@ -0,0 +1,215 @@
+/******************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXADDRESSMAP_H
+#define QKNXADDRESSMAP_H
+
+#include <QtCore/qvector.h>
+#include <QtKnx/qknxaddress.h>
+#include <QtKnx/qknxglobal.h>
+
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+template <typename T> class QKnxAddressMap final
+{
+public:
+    QKnxAddressMap() = default;
+
+    bool isEmpty() const { return m_size == 0; }
+    int size() const { return m_size; }
+    int capacity() const { return m_slots.size() / 2; }
+
+    void reserve(int size)
+    {
+        if (size > capacity())
+            rehash(size);
+    }
+
+    void clear()
+    {
+        m_slots.clear();
+        m_size = 0;
+        m_shift = 32;
+    }
+
+    bool contains(const QKnxAddress &key) const { return indexOf(key.key()) >= 0; }
+
+    const T *find(const QKnxAddress &key) const
+    {
+        const int index = indexOf(key.key());
+        return index >= 0 ? &m_slots.at(index).value : nullptr;
+    }
+
+    T *find(const QKnxAddress &key)
+    {
+        const int index = indexOf(key.key());
+        return index >= 0 ? &m_slots[index].value : nullptr;
+    }
+
+    T value(const QKnxAddress &key, const T &defaultValue = T()) const
+    {
+        const int index = indexOf(key.key());
+        return index >= 0 ? m_slots.at(index).value : defaultValue;
+    }
+
+    void insert(const QKnxAddress &key, const T &value) { operator[](key) = value; }
+
+    T &operator[](const QKnxAddress &key)
+    {
+        if (m_size >= capacity())
+            rehash(qMax(2 * m_size, 8));
+
+        Slot *table = m_slots.data();
+        const int mask = m_slots.size() - 1;
+        int index = bucket(key.key());
+        while (table[index].key != key.key()) {
+            if (table[index].key == EmptyKey) {
+                table[index].key = key.key();
+                ++m_size;
+                break;
+            }
+            index = (index + 1) & mask;
+        }
+        return table[index].value;
+    }
+
+    bool remove(const QKnxAddress &key)
+    {
+        int index = indexOf(key.key());
+        if (index < 0)
+            return false;
+
+        // backward shift deletion, moves following entries of the probe sequence into the gap
+        Slot *table = m_slots.data();
+        const int mask = m_slots.size() - 1;
+        for (int next = (index + 1) & mask; table[next].key != EmptyKey; next = (next + 1) & mask) {
+            const int home = bucket(table[next].key);
+            if (((next - home) & mask) >= ((next - index) & mask)) {
+                table[index] = std::move(table[next]);
+                index = next;
+            }
+        }
+        table[index] = Slot();
+        --m_size;
+        return true;
+    }
+
+    T take(const QKnxAddress &key)
+    {
+        T *value = find(key);
+        if (!value)
+            return T();
+        T result = std::move(*value);
+        remove(key);
+        return result;
+    }
+
+    QVector<QKnxAddress> keys() const
+    {
+        QVector<QKnxAddress> keys;
+        keys.reserve(m_size);
+        for (const Slot &slot : m_slots) {
+            if (slot.key != EmptyKey)
+                keys.append({ QKnxAddress::Type(slot.key >> 16), quint16(slot.key) });
+        }
+        return keys;
+    }
+
+    QVector<T> values() const
+    {
+        QVector<T> values;
+        values.reserve(m_size);
+        for (const Slot &slot : m_slots) {
+            if (slot.key != EmptyKey)
+                values.append(slot.value);
+        }
+        return values;
+    }
+
+private:
+    // QKnxAddress::key() never returns this value, even for invalid addresses
+    enum : quint32 { EmptyKey = 0xffffffff };
+
+    struct Slot
+    {
+        quint32 key { EmptyKey };
+        T value {};
+    };
+
+    // Fibonacci hashing, spreads neighbouring addresses over the whole table
+    int bucket(quint32 key) const { return int((key * 0x9e3779b9u) >> m_shift); }
+
+    int indexOf(quint32 key) const
+    {
+        if (m_size == 0)
+            return -1;
+
+        const Slot *table = m_slots.constData();
+        const int mask = m_slots.size() - 1;
+        for (int index = bucket(key); table[index].key != EmptyKey; index = (index + 1) & mask) {
+            if (table[index].key == key)
+                return index;
+        }
+        return -1;
+    }
+
+    // keeps the load factor at or below one half, which keeps the probe sequences short
+    void rehash(int size)
+    {
+        int shift = 31;
+        while ((1 << (32 - shift)) < 2 * size)
+            --shift;
+
+        QVector<Slot> old(1 << (32 - shift));
+        qSwap(old, m_slots);
+        m_shift = shift;
+
+        Slot *table = m_slots.data();
+        const int mask = m_slots.size() - 1;
+        for (const Slot &slot : qAsConst(old)) {
+            if (slot.key == EmptyKey)
+                continue;
+            int index = bucket(slot.key);
+            while (table[index].key != EmptyKey)
+                index = (index + 1) & mask;
+            table[index] = slot;
+        }
+    }
+
+private:
+    QVector<Slot> m_slots;
+    int m_size { 0 };
+    int m_shift { 32 };
+};
+
+QT_END_NAMESPACE
+
+#endif
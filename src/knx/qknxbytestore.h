@@ -34,6 +34,7 @@
 #include <QtCore/qdatastream.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qstring.h>
+#include <QtCore/qvarlengtharray.h>
 #include <QtCore/qvector.h>
 #include <QtKnx/qknxglobal.h>
 #include <QtKnx/qknxbytestoreref.h>
@@ -53,7 +54,10 @@ public:
 
     void resize(quint16 size, const quint8 value = 0)
     {
-        m_bytes.resize(size, value);
+        const int oldSize = m_bytes.size();
+        m_bytes.resize(size);
+        if (size > oldSize)
+            std::fill(std::next(std::begin(m_bytes), oldSize), std::end(m_bytes), value);
     }
 
     quint8 byte(quint16 index) const
@@ -110,13 +114,13 @@ public:
         static_assert(is_type<T, QByteArray, QVector<quint8>, std::deque<quint8>,
             std::vector<quint8>, std::array<quint8, S>>::value, "Type not supported.");
 
-        m_bytes.resize(sourceBytes.size());
+        m_bytes.resize(int(sourceBytes.size()));
         std::copy(std::begin(sourceBytes), std::end(sourceBytes), std::begin(m_bytes));
     }
 
     void setBytes(QByteArray::const_iterator sourceBegin, QByteArray::const_iterator sourceEnd)
     {
-        m_bytes.resize(std::distance(sourceBegin, sourceEnd));
+        m_bytes.resize(int(std::distance(sourceBegin, sourceEnd)));
         std::copy(sourceBegin, sourceEnd, std::begin(m_bytes));
     }
 
@@ -125,7 +129,7 @@ public:
         static_assert(is_type<typename std::iterator_traits<Iterator>::value_type, quint8>::value,
             "Type not supported.");
 
-        m_bytes.resize(std::distance(sourceBegin, sourceEnd));
+        m_bytes.resize(int(std::distance(sourceBegin, sourceEnd)));
         std::copy(sourceBegin, sourceEnd, std::begin(m_bytes));
     }
 
@@ -144,7 +148,7 @@ public:
 
         quint16 tmpSize = size();
         if (pos < tmpSize) {
-            m_bytes.resize(tmpSize + bytesToInsert.size());
+            m_bytes.resize(tmpSize + int(bytesToInsert.size()));
             std::move_backward(std::next(std::begin(m_bytes), pos),
                 std::prev(std::end(m_bytes), bytesToInsert.size()), std::end(m_bytes));
         } else {
@@ -182,7 +186,9 @@ protected:
     const quint8 *data() const { return m_bytes.data(); }
 
 private:
-    std::vector<quint8> m_bytes;
+    // Almost all KNX structures, including standard frame cEMI payloads, fit into the inline
+    // buffer. Only larger ones, e.g. extended frames, fall back to the heap.
+    QVarLengthArray<quint8, 64> m_bytes;
 };
 
 QT_END_NAMESPACE
@@ -28,11 +28,22 @@
 ******************************************************************************/
 
 #include "qknxgroupaddressinfos.h"
-#include "qknxgroupaddresses.h"
-#include "qknxprojectroot.h"
+#include "qknxgroupaddressreader.h"
 
 #include "qzipreader_p.h"
 
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qendian.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qstringlist.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 // -- KnxProjectInfo
@@ -50,119 +61,482 @@ struct KnxProjectInfo final
 };
 
 
-// -- QKnxGroupAddressInfosPrivate
+// -- KnxProjectPart
 
-class QKnxGroupAddressInfosPrivate final : public QSharedData
+struct KnxProjectPart final
 {
-public:
-    bool parseData(const QByteArray &data);
-    bool readProject(const QKnxProject &project);
-    QVector<QKnxGroupAddressInfo> readRange(const QKnxGroupRange &range, const QString &install);
+    QString entry; // path of the *0.xml file inside the project archive
+    QVector<QKnxGroupAddressReader::Project> projects;
+    QHash<QString, QString> names;
 
-    QString projectFile;
     QString errorString;
-    QHash<QString, KnxProjectInfo> projects;
-
     QKnxGroupAddressInfos::Status status = QKnxGroupAddressInfos::Status::NoError;
 };
 
 /*!
     \internal
+
+    Streams the group address information out of \a reader into \a part. Only
+    the elements leading to group addresses are looked at, the rest of the
+    project is skipped without building the project object model.
 */
-bool QKnxGroupAddressInfosPrivate::parseData(const QByteArray &data)
+static bool readProjectPart(QXmlStreamReader *reader, KnxProjectPart *part)
 {
-    if (data.isEmpty()) {
-        status = QKnxGroupAddressInfos::Status::FileError;
-        errorString = QKnxGroupAddressInfos::tr("Could not read project file.");
+    if (reader->hasError() || !reader->readNextStartElement()) {
+        part->errorString = reader->errorString();
+        part->status = QKnxGroupAddressInfos::Status::ParseError;
         return false;
     }
 
-    QXmlStreamReader reader(data);
-    if (reader.hasError() || !reader.readNextStartElement()) {
-        errorString = reader.errorString();
-        status = QKnxGroupAddressInfos::Status::ParseError;
+    if (reader->name() != QStringLiteral("KNX")) {
+        part->status = QKnxGroupAddressInfos::Status::ParseError;
+        part->errorString = QKnxGroupAddressInfos::tr("Not a valid KNX project file.");
         return false;
     }
 
-    if (reader.name() != QStringLiteral("KNX")) {
-        status = QKnxGroupAddressInfos::Status::ParseError;
-        errorString = QKnxGroupAddressInfos::tr("Not a valid KNX project file.");
+    if (!QKnxGroupAddressReader::readProjects(reader, &part->projects, true)) {
+        part->errorString = reader->errorString();
+        part->status = QKnxGroupAddressInfos::Status::ParseError;
         return false;
     }
 
-    QKnxProjectRoot root;
-    if (!root.parseElement(&reader, true)) {
-        errorString = reader.errorString();
-        status = QKnxGroupAddressInfos::Status::ParseError;
+    if (part->projects.size() < 1) {
+        part->status = QKnxGroupAddressInfos::Status::ProjectError;
+        part->errorString =
+            QKnxGroupAddressInfos::tr("The project file did not contain a KNX project.");
         return false;
     }
+    return true;
+}
 
-    if (root.Project.size() < 1) {
-        status = QKnxGroupAddressInfos::Status::ProjectError;
-        errorString = QKnxGroupAddressInfos::tr("The project file did not contain a KNX project.");
+/*!
+    \internal
+*/
+static bool readProjectDevice(QIODevice *device, KnxProjectPart *part)
+{
+    if (!device || device->atEnd()) {
+        part->status = QKnxGroupAddressInfos::Status::FileError;
+        part->errorString = QKnxGroupAddressInfos::tr("Could not read project file.");
         return false;
     }
 
-    for (const auto &project : qAsConst(root.Project)) {
-        if (readProject(project))
-            continue;
-        projects.clear();
-        return false; // early return on error
-    }
-    return true;
+    QXmlStreamReader reader(device);
+    return readProjectPart(&reader, part);
 }
 
 /*!
     \internal
+
+    Reads the entry of \a part from \a zip, followed by the project names of
+    the matching \c project.xml file. Both entries are inflated while they are
+    parsed, so neither of them is held in memory as a whole. A missing or
+    broken \c project.xml file is not an error, the projects just stay
+    unnamed.
 */
-bool QKnxGroupAddressInfosPrivate::readProject(const QKnxProject &project)
+static void readArchivePart(const QZipReader &zip, KnxProjectPart *part)
 {
-    if (projects.contains(project.Id)) {
-        status = QKnxGroupAddressInfos::Status::ProjectError;
-        errorString = QKnxGroupAddressInfos::tr("Project '%1' exists more then once.")
-            .arg(project.Id);
-        return false;
+    QScopedPointer<QIODevice> entry(zip.openEntry(part->entry));
+    if (!readProjectDevice(entry.data(), part))
+        return;
+
+    entry.reset(zip.openEntry(QString(part->entry).replace(QStringLiteral("0.xml"),
+        QStringLiteral("project.xml"))));
+    if (!entry)
+        return;
+
+    QXmlStreamReader reader(entry.data());
+    if (reader.hasError() || !reader.readNextStartElement()
+        || reader.name() != QStringLiteral("KNX")) {
+        return;
     }
 
-    if (project.Installations.size() > 0) {
-        KnxProjectInfo info;
-        for (const auto &install : qAsConst(project.Installations)) {
-            if (info.installations.contains(install.Name)) {
-                status = QKnxGroupAddressInfos::Status::ProjectError;
-                errorString = QKnxGroupAddressInfos::tr("Installation '%1' exists more then once.")
-                    .arg(install.Name.isEmpty() ? QStringLiteral("<empty>") : install.Name);
-                return false;
+    QHash<QString, QString> names;
+    if (QKnxGroupAddressReader::readProjectNames(&reader, &names))
+        part->names = names;
+}
+
+// -- KnxArchivePartReader
+
+// Reads one part of a project archive on a worker thread. Every reader opens the archive on
+// its own, so no QIODevice or QZipReader is shared between threads.
+class KnxArchivePartReader final : public QRunnable
+{
+public:
+    KnxArchivePartReader(const QString &archive, KnxProjectPart *part)
+        : m_archive(archive)
+        , m_part(part)
+    {}
+
+    void run() override
+    {
+        QZipReader zip(m_archive);
+        readArchivePart(zip, m_part);
+    }
+
+private:
+    const QString m_archive;
+    KnxProjectPart *m_part;
+};
+
+
+// -- KnxProjectCache
+
+// Binary image of the group address information of a project file, all values little endian.
+// The header is followed by the string table, the project, installation and info records and
+// the UTF-16 string pool. Records refer to strings by their index into the string table, so
+// names repeated throughout a project (e.g. the installation) are stored and loaded only once.
+namespace KnxProjectCache
+{
+    enum : quint32 { Magic = 0x43474b51 }; // "QKGC"
+    enum : quint16 { Version = 1 };
+
+    enum : int
+    {
+        HashSize = 20, // SHA-1 of the project file
+        HeaderSize = 64,
+        StringSize = 8, // pool offset, length
+        ProjectSize = 16, // id, name, first installation, installation count
+        InstallationSize = 12, // name, first info, info count
+        InfoSize = 16 // name, description, address + reserved, datapoint type
+    };
+
+    struct Key final
+    {
+        qint64 size = -1;
+        qint64 lastModified = 0;
+        QByteArray hash;
+    };
+
+    /*!
+        \internal
+
+        Returns the key a cache for the project \a file needs to match. The
+        file is read once to compute its hash and then rewound.
+    */
+    static Key key(QFile *file)
+    {
+        Key key;
+        const QFileInfo info(*file);
+        key.size = info.size();
+        key.lastModified = info.lastModified().toMSecsSinceEpoch();
+
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        if (hash.addData(file))
+            key.hash = hash.result();
+        file->seek(0);
+        return key;
+    }
+
+    template <typename T> static void append(QByteArray *data, T value)
+    {
+        char bytes[sizeof(T)];
+        qToLittleEndian<T>(value, bytes);
+        data->append(bytes, int(sizeof(T)));
+    }
+
+    /*!
+        \internal
+
+        Writes \a projects to \a cacheFile, keyed with \a key. The file is
+        replaced atomically, so a concurrent reader never sees a partial cache.
+    */
+    static bool write(const QString &cacheFile, const Key &key,
+        const QHash<QString, KnxProjectInfo> &projects)
+    {
+        if (key.hash.size() != HashSize)
+            return false;
+
+        QVector<QString> strings;
+        QHash<QString, quint32> stringIds;
+        const auto stringId = [&](const QString &string) -> quint32 {
+            const auto it = stringIds.constFind(string);
+            if (it != stringIds.constEnd())
+                return it.value();
+            strings.append(string);
+            return stringIds.insert(string, quint32(strings.size() - 1)).value();
+        };
+
+        QByteArray projectRecords, installationRecords, infoRecords;
+        quint32 installationCount = 0, infoCount = 0;
+
+        auto ids = projects.keys();
+        std::sort(ids.begin(), ids.end()); // stable output for the same project file
+        for (const auto &id : qAsConst(ids)) {
+            const auto &project = *projects.constFind(id);
+            auto names = project.installations.keys();
+            std::sort(names.begin(), names.end());
+
+            append<quint32>(&projectRecords, stringId(id));
+            append<quint32>(&projectRecords, stringId(project.name));
+            append<quint32>(&projectRecords, installationCount);
+            append<quint32>(&projectRecords, quint32(names.size()));
+            installationCount += quint32(names.size());
+
+            for (const auto &name : qAsConst(names)) {
+                const auto &infos = *project.installations.constFind(name);
+                append<quint32>(&installationRecords, stringId(name));
+                append<quint32>(&installationRecords, infoCount);
+                append<quint32>(&installationRecords, quint32(infos.size()));
+                infoCount += quint32(infos.size());
+
+                for (const auto &info : infos) {
+                    const auto address = info.address();
+                    append<quint32>(&infoRecords, stringId(info.name()));
+                    append<quint32>(&infoRecords, stringId(info.description()));
+                    append<quint16>(&infoRecords, address.isValid()
+                        ? QKnxUtils::QUint16::fromBytes(address.bytes()) : quint16(0));
+                    append<quint16>(&infoRecords, 0);
+                    append<quint32>(&infoRecords, quint32(info.datapointType()));
+                }
             }
-            QVector<QKnxGroupAddressInfo> addressInfos;
-            for (const auto &addresses : qAsConst(install.GroupAddresses)) {
-                for (const auto &range : qAsConst(addresses.GroupRanges))
-                    addressInfos.append(readRange(range, install.Name));
+        }
+
+        QByteArray stringRecords, pool;
+        stringRecords.reserve(strings.size() * StringSize);
+        for (const auto &string : qAsConst(strings)) {
+            append<quint32>(&stringRecords, quint32(pool.size() / 2));
+            append<quint32>(&stringRecords, quint32(string.size()));
+            for (const QChar c : string)
+                append<quint16>(&pool, c.unicode());
+        }
+
+        QByteArray header;
+        header.reserve(HeaderSize);
+        append<quint32>(&header, Magic);
+        append<quint16>(&header, Version);
+        append<quint16>(&header, 0);
+        append<qint64>(&header, key.size);
+        append<qint64>(&header, key.lastModified);
+        header.append(key.hash);
+        append<quint32>(&header, quint32(strings.size()));
+        append<quint32>(&header, quint32(ids.size()));
+        append<quint32>(&header, installationCount);
+        append<quint32>(&header, infoCount);
+        append<quint32>(&header, quint32(pool.size() / 2));
+        Q_ASSERT(header.size() == HeaderSize);
+
+        QSaveFile file(cacheFile);
+        if (!file.open(QIODevice::WriteOnly))
+            return false;
+        file.write(header);
+        file.write(stringRecords);
+        file.write(projectRecords);
+        file.write(installationRecords);
+        file.write(infoRecords);
+        file.write(pool);
+        return file.commit();
+    }
+
+    /*!
+        \internal
+
+        Reads the projects stored in \a cacheFile into \a projects. Returns
+        \c false and leaves \a projects untouched if there is no cache, if it
+        was written for a project file not matching \a key, or if it is
+        malformed.
+    */
+    static bool read(const QString &cacheFile, const Key &key,
+        QHash<QString, KnxProjectInfo> *projects)
+    {
+        if (key.hash.size() != HashSize)
+            return false;
+
+        QFile file(cacheFile);
+        if (!file.open(QIODevice::ReadOnly))
+            return false;
+
+        const qint64 size = file.size();
+        if (size < HeaderSize)
+            return false;
+
+        QByteArray buffer;
+        const uchar *data = file.map(0, size);
+        if (!data) {
+            buffer = file.readAll();
+            if (buffer.size() != size)
+                return false;
+            data = reinterpret_cast<const uchar *>(buffer.constData());
+        }
+
+        const auto u16 = [data](quint64 pos) { return qFromLittleEndian<quint16>(data + pos); };
+        const auto u32 = [data](quint64 pos) { return qFromLittleEndian<quint32>(data + pos); };
+
+        if (u32(0) != Magic || u16(4) != Version
+            || qFromLittleEndian<qint64>(data + 8) != key.size
+            || qFromLittleEndian<qint64>(data + 16) != key.lastModified
+            || memcmp(data + 24, key.hash.constData(), HashSize) != 0) {
+            return false;
+        }
+
+        const quint32 stringCount = u32(44);
+        const quint32 projectCount = u32(48);
+        const quint32 installationCount = u32(52);
+        const quint32 infoCount = u32(56);
+        const quint32 poolSize = u32(60);
+
+        const quint64 strings = HeaderSize;
+        const quint64 projectRecords = strings + quint64(stringCount) * StringSize;
+        const quint64 installationRecords = projectRecords + quint64(projectCount) * ProjectSize;
+        const quint64 infoRecords = installationRecords
+            + quint64(installationCount) * InstallationSize;
+        const quint64 pool = infoRecords + quint64(infoCount) * InfoSize;
+        if (pool + quint64(poolSize) * 2 != quint64(size))
+            return false;
+
+        QVector<QString> stringTable(int(stringCount));
+        for (quint32 i = 0; i < stringCount; ++i) {
+            const quint32 offset = u32(strings + i * StringSize);
+            const quint32 length = u32(strings + i * StringSize + 4);
+            if (quint64(offset) + length > poolSize)
+                return false;
+
+            QString value(int(length), Qt::Uninitialized);
+            auto out = value.data();
+            for (quint32 j = 0; j < length; ++j)
+                out[j] = QChar(u16(pool + (quint64(offset) + j) * 2));
+            stringTable[int(i)] = value;
+        }
+
+        const auto string = [&](quint64 pos, QString *value) {
+            const quint32 id = u32(pos);
+            if (id >= stringCount)
+                return false;
+            *value = stringTable.at(int(id));
+            return true;
+        };
+
+        QHash<QString, KnxProjectInfo> result;
+        result.reserve(int(projectCount));
+        for (quint32 i = 0; i < projectCount; ++i) {
+            const quint64 record = projectRecords + quint64(i) * ProjectSize;
+            const quint32 firstInstallation = u32(record + 8);
+            const quint32 installations = u32(record + 12);
+            if (quint64(firstInstallation) + installations > installationCount)
+                return false;
+
+            QString id;
+            KnxProjectInfo project;
+            if (!string(record, &id) || !string(record + 4, &project.name) || result.contains(id))
+                return false;
+
+            for (quint32 j = firstInstallation; j < firstInstallation + installations; ++j) {
+                const quint64 installation = installationRecords + quint64(j) * InstallationSize;
+                const quint32 firstInfo = u32(installation + 4);
+                const quint32 count = u32(installation + 8);
+                if (quint64(firstInfo) + count > infoCount)
+                    return false;
+
+                QString name;
+                if (!string(installation, &name) || project.installations.contains(name))
+                    return false;
+
+                QVector<QKnxGroupAddressInfo> infos;
+                infos.reserve(int(count));
+                for (quint32 k = firstInfo; k < firstInfo + count; ++k) {
+                    const quint64 info = infoRecords + quint64(k) * InfoSize;
+                    QString infoName, description;
+                    if (!string(info, &infoName) || !string(info + 4, &description))
+                        return false;
+                    infos.append({ name, infoName, u16(info + 8),
+                        QKnxDatapointType::Type(u32(info + 12)), description });
+                }
+                project.installations.insert(name, infos);
             }
-            info.installations.insert(install.Name, addressInfos);
+            result.insert(id, project);
         }
-        projects.insert(project.Id, info);
-    } else {
-        projects.insert(project.Id, {}); // projects can have empty installations
+
+        *projects = result;
+        return true;
     }
+}
 
-    return status == QKnxGroupAddressInfos::Status::NoError;
+
+// -- QKnxGroupAddressInfosPrivate
+
+class QKnxGroupAddressInfosPrivate final : public QSharedData
+{
+public:
+    bool parseFile(QFile *file);
+    bool parseDevice(QIODevice *device);
+    bool mergePart(const KnxProjectPart &part);
+    bool readProject(const QKnxGroupAddressReader::Project &project);
+
+    QString projectFile;
+    QString cacheFile;
+    QString errorString;
+    QHash<QString, KnxProjectInfo> projects;
+
+    QKnxGroupAddressInfos::Status status = QKnxGroupAddressInfos::Status::NoError;
+};
+
+/*!
+    \internal
+
+    Parses the project file directly from \a device, without reading all of
+    it into memory first.
+*/
+bool QKnxGroupAddressInfosPrivate::parseDevice(QIODevice *device)
+{
+    KnxProjectPart part;
+    readProjectDevice(device, &part);
+    return mergePart(part);
+}
+
+/*!
+    \internal
+
+    Adds the projects read into \a part, including their names. Fails if
+    reading the part failed or if a project or installation exists more than
+    once; all projects are cleared in that case.
+*/
+bool QKnxGroupAddressInfosPrivate::mergePart(const KnxProjectPart &part)
+{
+    if (part.status != QKnxGroupAddressInfos::Status::NoError) {
+        status = part.status;
+        errorString = part.errorString;
+        projects.clear();
+        return false;
+    }
+
+    for (const auto &project : qAsConst(part.projects)) {
+        if (readProject(project))
+            continue;
+        projects.clear();
+        return false; // early return on error
+    }
+
+    for (auto it = part.names.cbegin(); it != part.names.cend(); ++it) {
+        if (projects.contains(it.key()))
+            projects[it.key()].name = it.value();
+    }
+    return true;
 }
 
 /*!
     \internal
 */
-QVector<QKnxGroupAddressInfo>
-    QKnxGroupAddressInfosPrivate::readRange(const QKnxGroupRange &range, const QString &install)
+bool QKnxGroupAddressInfosPrivate::readProject(const QKnxGroupAddressReader::Project &project)
 {
-    QVector<QKnxGroupAddressInfo> addressInfos;
-    for (const auto &groupRange : qAsConst(range.GroupRange))
-        addressInfos.append(readRange(groupRange, install));
+    if (projects.contains(project.id)) {
+        status = QKnxGroupAddressInfos::Status::ProjectError;
+        errorString = QKnxGroupAddressInfos::tr("Project '%1' exists more then once.")
+            .arg(project.id);
+        return false;
+    }
 
-    for (const auto &address : qAsConst(range.GroupAddress)) {
-        addressInfos.append({ install, address.Name, quint16(address.Address),
-            address.DatapointType, address.Description });
+    KnxProjectInfo info;
+    for (const auto &install : qAsConst(project.installations)) {
+        if (info.installations.contains(install.name)) {
+            status = QKnxGroupAddressInfos::Status::ProjectError;
+            errorString = QKnxGroupAddressInfos::tr("Installation '%1' exists more then once.")
+                .arg(install.name.isEmpty() ? QStringLiteral("<empty>") : install.name);
+            return false;
+        }
+        info.installations.insert(install.name, install.infos);
     }
-    return addressInfos;
+    projects.insert(project.id, info); // projects can have empty installations
+
+    return status == QKnxGroupAddressInfos::Status::NoError;
 }
 
 
@@ -253,8 +627,63 @@ static bool isZipFile(QFile *file)
     return quint32((tmp[0]) + (tmp[1] << 8) + (tmp[2] << 16) + (tmp[3] << 24)) == 0x04034b50;
 }
 
+/*!
+    \internal
+
+    Parses the opened project \a file, which is either a KNX project XML file
+    or a KNX project archive.
+*/
+bool QKnxGroupAddressInfosPrivate::parseFile(QFile *file)
+{
+    if (!isZipFile(file))
+        return parseDevice(file);
+
+    // let the zip reader open the archive on its own, so it can memory map it
+    file->close();
+    QZipReader zipReader(projectFile);
+
+    QStringList entries;
+    const auto fileNames = zipReader.fileNames();
+    for (const auto &fileName : fileNames) {
+        if (fileName.endsWith(QStringLiteral("0.xml")))
+            entries.append(fileName);
+    }
+    entries.sort(); // merge the parts in a deterministic order
+    entries.removeDuplicates();
+
+    if (entries.isEmpty())
+        return parseDevice(nullptr);
+
+    QVector<KnxProjectPart> parts(entries.size());
+    for (int i = 0; i < entries.size(); ++i)
+        parts[i].entry = entries.at(i);
+
+    if (parts.size() == 1) {
+        readArchivePart(zipReader, &parts[0]);
+    } else {
+        // inflate and parse the parts concurrently, each worker opens its own zip reader
+        QThreadPool pool;
+        pool.setMaxThreadCount(qMin(parts.size(), QThread::idealThreadCount()));
+        for (auto &part : parts)
+            pool.start(new KnxArchivePartReader(projectFile, &part));
+        pool.waitForDone();
+    }
+
+    for (const auto &part : qAsConst(parts)) {
+        if (!mergePart(part))
+            return false;
+    }
+    return true;
+}
+
 /*!
     Clears all existing information and parses the KNX project file.
+
+    If a cache file is set, the information is read from the cache instead as
+    long as it was written for the current content of the project file. After
+    parsing the project file, the cache is rewritten.
+
+    \sa setCacheFile()
 */
 bool QKnxGroupAddressInfos::parse()
 {
@@ -269,42 +698,49 @@ bool QKnxGroupAddressInfos::parse()
         return false;
     }
 
-    if (!isZipFile(&file))
-        return d_ptr->parseData(file.readAll());
-
-    QSet<QString> files;
-    QZipReader zipReader(&file);
-    const auto fileInfos = zipReader.fileInfoList();
-    for (const auto &fileInfo : qAsConst(fileInfos)) {
-        if (fileInfo.filePath.endsWith(QStringLiteral("0.xml")))
-            files.insert(fileInfo.filePath);
+    KnxProjectCache::Key key;
+    if (!d_ptr->cacheFile.isEmpty()) {
+        key = KnxProjectCache::key(&file);
+        if (KnxProjectCache::read(d_ptr->cacheFile, key, &d_ptr->projects))
+            return true;
     }
 
-    if (files.isEmpty())
-        return d_ptr->parseData({});
+    if (!d_ptr->parseFile(&file))
+        return false;
 
-    for (auto file : qAsConst(files)) {
-        if (d_ptr->parseData(zipReader.fileData(file))) {
-            const auto data = zipReader.fileData(file.replace(QStringLiteral("0.xml"),
-                QStringLiteral("project.xml")));
+    // failing to write the cache is not an error, the next parse just has to read the project
+    if (!d_ptr->cacheFile.isEmpty())
+        KnxProjectCache::write(d_ptr->cacheFile, key, d_ptr->projects);
+    return true;
+}
 
-            QXmlStreamReader r(data);
-            if (r.hasError() || !r.readNextStartElement() || r.name() != QStringLiteral("KNX"))
-                continue;
+/*!
+    Returns the file the group address information is cached in, or an empty
+    string if no cache is used.
 
-            QKnxProjectRoot root;
-            if (!root.parseElement(&r, true))
-                continue;
-            for (const auto &project : qAsConst(root.Project)) {
-                if (d_ptr->projects.contains(project.Id))
-                    d_ptr->projects[project.Id].name = project.ProjectInformation.value(0).Name;
-            }
-        } else {
-            d_ptr->projects.clear();
-            return false;
-        }
-    }
-    return true;
+    \sa setCacheFile()
+*/
+QString QKnxGroupAddressInfos::cacheFile() const
+{
+    return d_ptr->cacheFile;
+}
+
+/*!
+    Sets the file the group address information is cached in to \a cacheFile.
+    Caching is disabled by default, an empty \a cacheFile disables it again.
+
+    With a cache file set, parse() writes the information read from the
+    project file to a compact binary cache. Subsequent calls of parse(), also
+    by other processes, load this cache instead of parsing the project file
+    again. The cache is only used if the size, modification time and SHA-1 hash
+    of the project file still match the ones it was written for; otherwise the
+    project file is parsed and the cache is replaced.
+
+    The cache file is kept when calling clear() or setProjectFile().
+*/
+void QKnxGroupAddressInfos::setCacheFile(const QString &cacheFile)
+{
+    d_ptr->cacheFile = cacheFile;
 }
 
 /*!
@@ -568,6 +1004,7 @@ bool QKnxGroupAddressInfos::operator==(const QKnxGroupAddressInfos &other) const
 {
     return d_ptr == other.d_ptr || [&]() -> bool {
         return d_ptr->projectFile == other.d_ptr->projectFile
+            && d_ptr->cacheFile == other.d_ptr->cacheFile
             && d_ptr->errorString == other.d_ptr->errorString
             && d_ptr->projects == other.d_ptr->projects
             && d_ptr->status == other.d_ptr->status;
@@ -58,6 +58,9 @@ public:
     QString projectFile() const;
     void setProjectFile(const QString &projectFile);
 
+    QString cacheFile() const;
+    void setCacheFile(const QString &cacheFile);
+
     bool parse();
     void clear();
 
@@ -0,0 +1,170 @@
+/******************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxgroupaddressset.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QKnxGroupAddressSet
+
+    \inmodule QtKnx
+    \brief The QKnxGroupAddressSet class represents a set of KNX \l {QKnxAddress::Group}
+    {group} addresses.
+
+    The set is backed by a bit array covering the whole 16-bit group address
+    space, so contains() costs a single bit test independent of the number of
+    addresses in the set. Memory for the bit array, 8 KiB, is only allocated
+    once the first address is inserted. The class is implicitly shared.
+
+    The set is meant for group address filter tables and subscription lookups.
+    Addresses of a different type than \l QKnxAddress::Type::Group are never
+    part of the set.
+*/
+
+/*!
+    \fn QKnxGroupAddressSet::QKnxGroupAddressSet()
+
+    Constructs an empty group address set.
+*/
+
+/*!
+    Constructs a group address set containing the group addresses of the
+    initializer list \a addresses.
+*/
+QKnxGroupAddressSet::QKnxGroupAddressSet(std::initializer_list<QKnxAddress> addresses)
+{
+    for (const QKnxAddress &address : addresses)
+        insert(address);
+}
+
+/*!
+    Constructs a group address set containing the group addresses of
+    \a addresses.
+*/
+QKnxGroupAddressSet::QKnxGroupAddressSet(const QVector<QKnxAddress> &addresses)
+{
+    for (const QKnxAddress &address : addresses)
+        insert(address);
+}
+
+/*!
+    \fn bool QKnxGroupAddressSet::isEmpty() const
+
+    Returns \c true if the set contains no addresses; \c false otherwise.
+*/
+
+/*!
+    \fn int QKnxGroupAddressSet::size() const
+
+    Returns the number of addresses in the set.
+*/
+
+/*!
+    Removes all addresses from the set and frees the bit array.
+*/
+void QKnxGroupAddressSet::clear()
+{
+    m_bits.clear();
+    m_count = 0;
+}
+
+/*!
+    Inserts the group \a address into the set. Returns \c true if the address
+    was added; \c false if it is already part of the set or is not a valid
+    group address.
+*/
+bool QKnxGroupAddressSet::insert(const QKnxAddress &address)
+{
+    if (address.m_type != QKnxAddress::Type::Group || contains(address))
+        return false;
+
+    if (m_bits.isEmpty())
+        m_bits.resize(0x10000);
+    m_bits.setBit(address.m_address);
+    ++m_count;
+    return true;
+}
+
+/*!
+    Removes the group \a address from the set. Returns \c true if the address
+    was part of the set; \c false otherwise.
+*/
+bool QKnxGroupAddressSet::remove(const QKnxAddress &address)
+{
+    if (!contains(address))
+        return false;
+
+    m_bits.clearBit(address.m_address);
+    --m_count;
+    return true;
+}
+
+/*!
+    \fn bool QKnxGroupAddressSet::contains(const QKnxAddress &address) const
+
+    Returns \c true if the set contains the group \a address; \c false
+    otherwise.
+*/
+
+/*!
+    Returns the addresses of the set in ascending order.
+*/
+QVector<QKnxAddress> QKnxGroupAddressSet::toVector() const
+{
+    QVector<QKnxAddress> addresses;
+    addresses.reserve(m_count);
+    for (int i = 0; addresses.size() < m_count; ++i) {
+        if (m_bits.testBit(i))
+            addresses.append({ QKnxAddress::Type::Group, quint16(i) });
+    }
+    return addresses;
+}
+
+/*!
+    Returns \c true if \a other contains the same addresses as this set;
+    \c false otherwise.
+*/
+bool QKnxGroupAddressSet::operator==(const QKnxGroupAddressSet &other) const
+{
+    if (m_count != other.m_count)
+        return false;
+    return m_count == 0 || m_bits == other.m_bits;
+}
+
+/*!
+    Returns \c true if \a other does not contain the same addresses as this
+    set; \c false otherwise.
+*/
+bool QKnxGroupAddressSet::operator!=(const QKnxGroupAddressSet &other) const
+{
+    return !operator==(other);
+}
+
+QT_END_NAMESPACE
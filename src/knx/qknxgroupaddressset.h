@@ -0,0 +1,74 @@
+/******************************************************************************
+**
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXGROUPADDRESSSET_H
+#define QKNXGROUPADDRESSSET_H
+
+#include <QtCore/qbitarray.h>
+#include <QtCore/qvector.h>
+#include <QtKnx/qknxaddress.h>
+#include <QtKnx/qknxglobal.h>
+
+#include <initializer_list>
+
+QT_BEGIN_NAMESPACE
+
+class Q_KNX_EXPORT QKnxGroupAddressSet final
+{
+public:
+    QKnxGroupAddressSet() = default;
+    QKnxGroupAddressSet(std::initializer_list<QKnxAddress> addresses);
+    explicit QKnxGroupAddressSet(const QVector<QKnxAddress> &addresses);
+
+    bool isEmpty() const { return m_count == 0; }
+    int size() const { return m_count; }
+    void clear();
+
+    bool insert(const QKnxAddress &address);
+    bool remove(const QKnxAddress &address);
+
+    bool contains(const QKnxAddress &address) const
+    {
+        return address.m_type == QKnxAddress::Type::Group && !m_bits.isEmpty()
+            && m_bits.testBit(address.m_address);
+    }
+
+    QVector<QKnxAddress> toVector() const;
+
+    bool operator==(const QKnxGroupAddressSet &other) const;
+    bool operator!=(const QKnxGroupAddressSet &other) const;
+
+private:
+    QBitArray m_bits;
+    int m_count = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -31,6 +31,54 @@
 
 QT_BEGIN_NAMESPACE
 
+namespace QKnxPrivate
+{
+    // Offsets of the fixed fields inside the service information, i.e. the cEMI frame without
+    // the message code. All of them follow the additional info, so they are derived from its
+    // length byte and every field can be read or written in place.
+    struct LinkLayerFields final
+    {
+        explicit LinkLayerFields(const QKnxLinkLayerPayload &payload)
+        {
+            const quint8 size = payload.byte(0);
+            additionalInfosSize = (size < 0xff ? size : 0u); // 0xff is reserved for future use
+        }
+
+        quint16 controlField() const { return additionalInfosSize + 1; }
+        quint16 extendedControlField() const { return additionalInfosSize + 2; }
+        quint16 sourceAddress() const { return additionalInfosSize + 3; }
+        quint16 destinationAddress() const { return additionalInfosSize + 5; }
+        quint16 length() const { return additionalInfosSize + 7; }
+        quint16 tpdu() const { return additionalInfosSize + 8; }
+
+        quint8 additionalInfosSize { 0 };
+    };
+
+    static QKnxAddress address(QKnxAddress::Type type, const QKnxLinkLayerPayload &payload,
+        quint16 index)
+    {
+        if (payload.size() < index + 2)
+            return {};
+        return { type, quint16(quint16(payload.byte(index)) << 8 | payload.byte(index + 1)) };
+    }
+}
+
+class QKnxLinkLayerFramePrivate final : public QSharedData
+{
+public:
+    QKnxLinkLayerFramePrivate() = default;
+    ~QKnxLinkLayerFramePrivate() = default;
+
+    QKnxLinkLayerFrame::MessageCode m_code = QKnxLinkLayerFrame::MessageCode::Unknown;
+    QKnx::MediumType m_mediumType = QKnx::MediumType::Unknown;
+    QKnxLinkLayerPayload m_serviceInformation;
+};
+
+// Shared by all default constructed frames, so creating empty frames (e.g. the slots of a ring
+// buffer or an invalid return value) does not allocate. Detaches on the first modification.
+Q_GLOBAL_STATIC_WITH_ARGS(QSharedDataPointer<QKnxLinkLayerFramePrivate>, sharedNullFrame,
+    (new QKnxLinkLayerFramePrivate))
+
 // List of Message code for Tunneling from 3.8.4 paragraph 2.2.1
 
 /*!
@@ -89,6 +137,22 @@ QT_BEGIN_NAMESPACE
     \value DataIndividualIndication                   T_Data_Individual.ind
 */
 
+/*!
+    Constructs an empty LinkLayer frame with an unknown message code and
+    medium type.
+*/
+QKnxLinkLayerFrame::QKnxLinkLayerFrame()
+    // frames constructed during static destruction can no longer share the null frame
+    : d_ptr(sharedNullFrame.isDestroyed() ? new QKnxLinkLayerFramePrivate
+        : const_cast<QKnxLinkLayerFramePrivate *>(sharedNullFrame()->constData()))
+{}
+
+/*!
+    Destroys the LinkLayer frame and frees its data if it is no longer shared.
+*/
+QKnxLinkLayerFrame::~QKnxLinkLayerFrame()
+{}
+
 /*!
     Constructs a LinkLayer frame starting with \a messageCode.
 
@@ -96,26 +160,32 @@ QT_BEGIN_NAMESPACE
 */
 QKnxLinkLayerFrame::QKnxLinkLayerFrame(QKnx::MediumType mediumType,
     QKnxLinkLayerFrame::MessageCode messageCode)
-    : m_code(messageCode)
-    , m_mediumType(mediumType)
-{}
+    : d_ptr(new QKnxLinkLayerFramePrivate)
+{
+    d_ptr->m_code = messageCode;
+    d_ptr->m_mediumType = mediumType;
+}
 
 /*!
     Constructs a LinkLayer frame starting with \a messageCode and with a \l QKnxLinkLayerPayload \a payload.
 */
 QKnxLinkLayerFrame::QKnxLinkLayerFrame(QKnx::MediumType mediumType,
     QKnxLinkLayerFrame::MessageCode messageCode, const QKnxLinkLayerPayload &payload)
-    : m_code(messageCode)
-    , m_mediumType(mediumType)
-    , m_serviceInformation(payload)
-{}
+    : d_ptr(new QKnxLinkLayerFramePrivate)
+{
+    d_ptr->m_code = messageCode;
+    d_ptr->m_mediumType = mediumType;
+    d_ptr->m_serviceInformation = payload;
+}
 
 /*!
     Constructs an empty LinkLayer frame. The MediumType is set.
 */
 QKnxLinkLayerFrame::QKnxLinkLayerFrame(QKnx::MediumType mediumType)
-    : m_mediumType(mediumType)
-{}
+    : d_ptr(new QKnxLinkLayerFramePrivate)
+{
+    d_ptr->m_mediumType = mediumType;
+}
 
 /*!
   Returns true if the message code is valid.
@@ -129,13 +199,14 @@ bool QKnxLinkLayerFrame::isValid() const
     return false;
 
     // Tpdu is valid
-    if (! tpdu().isValid())
+    const auto tpdu = this->tpdu();
+    if (!tpdu.isValid())
         return false;
 
     // For the moment we only check for netIp Tunnel
     // TP and PL send L_Data_Standard and L_Data_Extended
     // TODO: Make the check more general (maybe other MediumType could use the following check)
-    if (m_mediumType == QKnx::MediumType::NetIP) {
+    if (d_ptr->m_mediumType == QKnx::MediumType::NetIP) {
         // TODO: Make sure all constraints from 3.3.2 paragraph 2.2 L_Data is checked here
 
         //Extended control field destination address type corresponds to the destination address
@@ -156,10 +227,10 @@ bool QKnxLinkLayerFrame::isValid() const
         // TODO: check NPDU/ TPDU size, several cases need to be taken into account:
         // 1; Information-Length (max. value is 255); number of TPDU octets, TPCI octet not included!
         if (controlField().frameType() == QKnxControlField::FrameType::Extended
-            && tpdu().size() > 256)
+            && tpdu.size() > 256)
             return false;
         // Low Priority is Mandatory for long frame 3.3.2 paragraph 2.2.3
-        if (tpdu().size() > 16 && controlField().priority() != QKnxControlField::Priority::Low)
+        if (tpdu.size() > 16 && controlField().priority() != QKnxControlField::Priority::Low)
             return false;
         // 2; Check presence of Pl/RF medium information in the additional info -> size always needs
         //    to be greater then 15 bytes because both need additional information.
@@ -169,7 +240,7 @@ bool QKnxLinkLayerFrame::isValid() const
         // 4; 03_03_02 Data Link Layer General v01.02.02 AS.pdf page 12 paragraph 2.2.5
         // control field frame type standard -> max. length value is 15
         if (controlField().frameType() == QKnxControlField::FrameType::Standard
-            && tpdu().byte(0) > 15)
+            && tpdu.byte(0) > 15)
             return false;
         //  control field frame type extended -> max. length value is 255
         return true;
@@ -192,7 +263,7 @@ bool QKnxLinkLayerFrame::isMessageCodeValid() const
     // TODO: some message code could be valide for other MediumType as well.
     // Adapt the function when other Medium type get implemented.
 
-    switch (m_code) {
+    switch (d_ptr->m_code) {
     case MessageCode::BusmonitorIndication:
     case MessageCode::DataRequest:
     case MessageCode::DataConfirmation:
@@ -202,9 +273,9 @@ bool QKnxLinkLayerFrame::isMessageCodeValid() const
     case MessageCode::RawConfirmation:
     case MessageCode::ResetRequest:
          // For the moment the QKnxLinkLayerFrameFactory is not setting the MediumType
-        if (m_mediumType == QKnx::MediumType::Unknown)
-            return (guessMediumType(m_code) == QKnx::MediumType::NetIP);
-        return (m_mediumType == QKnx::MediumType::NetIP);
+        if (d_ptr->m_mediumType == QKnx::MediumType::Unknown)
+            return (guessMediumType(d_ptr->m_code) == QKnx::MediumType::NetIP);
+        return (d_ptr->m_mediumType == QKnx::MediumType::NetIP);
     case MessageCode::PollDataRequest:
     case MessageCode::PollDataConfirmation:
     case MessageCode::DataConnectedRequest:
@@ -219,54 +290,52 @@ bool QKnxLinkLayerFrame::isMessageCodeValid() const
 
 QKnxControlField QKnxLinkLayerFrame::controlField() const
 {
-    return QKnxControlField { serviceInformationRef(additionalInfosSize() + 1).byte(0) };
+    const QKnxPrivate::LinkLayerFields fields(d_ptr->m_serviceInformation);
+    return QKnxControlField { d_ptr->m_serviceInformation.byte(fields.controlField()) };
 }
 
 void QKnxLinkLayerFrame::setControlField(const QKnxControlField &controlField)
 {
-    auto payload = serviceInformation();
-    payload.setByte(additionalInfosSize() + 1, controlField.bytes());
-    setServiceInformation(payload);
+    const QKnxPrivate::LinkLayerFields fields(d_ptr->m_serviceInformation);
+    d_ptr->m_serviceInformation.setByte(fields.controlField(), controlField.bytes());
 }
 
 QKnxExtendedControlField QKnxLinkLayerFrame::extendedControlField() const
 {
-    return QKnxExtendedControlField { serviceInformationRef(additionalInfosSize() + 1).byte(1) };
+    const QKnxPrivate::LinkLayerFields fields(d_ptr->m_serviceInformation);
+    return QKnxExtendedControlField {
+        d_ptr->m_serviceInformation.byte(fields.extendedControlField())
+    };
 }
 
 void QKnxLinkLayerFrame::setExtendedControlField(const QKnxExtendedControlField &controlFieldEx)
 {
-    auto payload = serviceInformation();
-    payload.setByte(additionalInfosSize() + 2, controlFieldEx.bytes());
-    setServiceInformation(payload);
+    const QKnxPrivate::LinkLayerFields fields(d_ptr->m_serviceInformation);
+    d_ptr->m_serviceInformation.setByte(fields.extendedControlField(), controlFieldEx.bytes());
 }
 
 quint8 QKnxLinkLayerFrame::additionalInfosSize() const
 {
-    auto size = serviceInformationRef().byte(0);
-    return (size < 0xff ? size : 0u); // 0xff is reserved for future use
+    return QKnxPrivate::LinkLayerFields(d_ptr->m_serviceInformation).additionalInfosSize;
 }
 
 void QKnxLinkLayerFrame::addAdditionalInfo(const QKnxAdditionalInfo &info)
 {
-    auto payload = serviceInformation();
-
-    quint8 size = payload.byte(0);
+    quint8 size = d_ptr->m_serviceInformation.byte(0);
     if (size + info.size() > 0xfe)
         return; // maximum size would be exceeded, 0xff is reserved for future use
 
     quint8 index = 1;
     if (size > 0) {
         while (index < size) {
-            if (QKnxAdditionalInfo::Type(payload.byte(index)) >= info.type())
+            if (QKnxAdditionalInfo::Type(d_ptr->m_serviceInformation.byte(index)) >= info.type())
                 break;
-            index += payload.byte(index + 1) + 2; // type + size => 2
+            index += d_ptr->m_serviceInformation.byte(index + 1) + 2; // type + size => 2
         }
     }
 
-    payload.insertBytes((index > size ? size + 1 : index), info.bytes());
-    payload.setByte(0, size + info.size());
-    setServiceInformation(payload);
+    d_ptr->m_serviceInformation.insertBytes((index > size ? size + 1 : index), info.bytes());
+    d_ptr->m_serviceInformation.setByte(0, size + info.size());
 }
 
 void QKnxLinkLayerFrame::removeAdditionalInfo(QKnxAdditionalInfo::Type type)
@@ -326,28 +395,31 @@ void QKnxLinkLayerFrame::clearAdditionalInfos()
 
 const QKnxAddress QKnxLinkLayerFrame::sourceAddress() const
 {
-    return { QKnxAddress::Type::Individual, serviceInformationRef(additionalInfosSize() + 1)
-        .bytes(2, 2) };
+    const QKnxPrivate::LinkLayerFields fields(d_ptr->m_serviceInformation);
+    return QKnxPrivate::address(QKnxAddress::Type::Individual, d_ptr->m_serviceInformation,
+        fields.sourceAddress());
 }
 
 void QKnxLinkLayerFrame::setSourceAddress(const QKnxAddress &source)
 {
-    auto payload = serviceInformation();
-    payload.replaceBytes(additionalInfosSize() + 3, source.bytes());
-    setServiceInformation(payload);
+    const QKnxPrivate::LinkLayerFields fields(d_ptr->m_serviceInformation);
+    d_ptr->m_serviceInformation.replaceBytes(fields.sourceAddress(), source.bytes());
 }
 
 const QKnxAddress QKnxLinkLayerFrame::destinationAddress() const
 {
-    return { extendedControlField().destinationAddressType(),
-        serviceInformationRef(additionalInfosSize() + 1).bytes(4, 2) };
+    const QKnxPrivate::LinkLayerFields fields(d_ptr->m_serviceInformation);
+    const QKnxExtendedControlField extendedControlField {
+        d_ptr->m_serviceInformation.byte(fields.extendedControlField())
+    };
+    return QKnxPrivate::address(extendedControlField.destinationAddressType(),
+        d_ptr->m_serviceInformation, fields.destinationAddress());
 }
 
 void QKnxLinkLayerFrame::setDestinationAddress(const QKnxAddress &destination)
 {
-    auto payload = serviceInformation();
-    payload.replaceBytes(additionalInfosSize() + 5, destination.bytes());
-    setServiceInformation(payload);
+    const QKnxPrivate::LinkLayerFields fields(d_ptr->m_serviceInformation);
+    d_ptr->m_serviceInformation.replaceBytes(fields.destinationAddress(), destination.bytes());
 }
 
 QKnxTpdu QKnxLinkLayerFrame::tpdu() const
@@ -355,33 +427,73 @@ QKnxTpdu QKnxLinkLayerFrame::tpdu() const
     // TODO: In RF-Frames the length field is set to 0x00, figure out how this fits in here.
     // See 03_06_03 EMI_IMI, paragraph 4.1.5.3.1 Implementation and usage, page 75, Note 1,2,3
 
-    // length field + ctrl + extCtrl + 2 * KNX address -> 7 bytes
-    const quint8 tpduOffset = additionalInfosSize() + 7 + 1/* bytes */;
-    return QKnxTpdu::fromBytes(serviceInformationRef().bytes<QVector<quint8>>(),
-        tpduOffset, (size() - 1) - tpduOffset);
+    auto tpdu = QKnxTpdu { QKnxTpdu::TransportControlField::Invalid,
+        QKnxTpdu::ApplicationControlField::Invalid };
+
+    // the TPDU is copied straight out of the service information, no intermediate buffer
+    const QKnxPrivate::LinkLayerFields fields(d_ptr->m_serviceInformation);
+    if (fields.tpdu() >= d_ptr->m_serviceInformation.size())
+        return tpdu;
+
+    const quint8 *begin = d_ptr->m_serviceInformation.ref(fields.tpdu()).bytes();
+    tpdu.setBytes(begin, begin + (d_ptr->m_serviceInformation.size() - fields.tpdu()));
+    return tpdu;
 }
 
 void QKnxLinkLayerFrame::setTpdu(const QKnxTpdu &tpdu)
 {
-    auto info = serviceInformation();
-    info.resize(additionalInfosSize() + 7); // length field + ctrl + extCtrl + 2 * KNX address
-    info.setByte(additionalInfosSize() + 7, tpdu.dataSize());
-    info.appendBytes(tpdu.bytes());
-    setServiceInformation(info);
+    const QKnxPrivate::LinkLayerFields fields(d_ptr->m_serviceInformation);
+    d_ptr->m_serviceInformation.resize(fields.tpdu() + tpdu.size());
+    d_ptr->m_serviceInformation.setByte(fields.length(), tpdu.dataSize());
+    d_ptr->m_serviceInformation.replaceBytes(fields.tpdu(), tpdu.bytes());
 }
 
+/*!
+    Constructs a copy of \a other.
+
+    The copy shares the frame data with \a other until one of them is
+    modified, so passing frames by value does not copy any bytes.
+*/
 QKnxLinkLayerFrame::QKnxLinkLayerFrame(const QKnxLinkLayerFrame &other)
-{
-    m_code = other.messageCode();
-    m_serviceInformation = other.serviceInformation();
+    : d_ptr(other.d_ptr)
+{}
+
+/*!
+    Move-constructs a frame, making it point at the same object that \a other
+    was pointing to.
+*/
+QKnxLinkLayerFrame::QKnxLinkLayerFrame(QKnxLinkLayerFrame &&other) Q_DECL_NOTHROW
+    : d_ptr(std::move(other.d_ptr))
+{}
 
+/*!
+    Assigns \a other to this frame and returns a reference to this frame.
+*/
+QKnxLinkLayerFrame &QKnxLinkLayerFrame::operator=(const QKnxLinkLayerFrame &other)
+{
+    d_ptr = other.d_ptr;
+    return *this;
 }
+
+/*!
+    \fn QKnxLinkLayerFrame &QKnxLinkLayerFrame::operator=(QKnxLinkLayerFrame &&other)
+
+    Move-assigns \a other to this frame and returns a reference to this frame.
+*/
+
+/*!
+    \fn void QKnxLinkLayerFrame::swap(QKnxLinkLayerFrame &other)
+
+    Swaps \a other with this frame. This operation is very fast and never
+    fails.
+*/
+
 /*!
     Returns the number of bytes of the LinkLayer frame.
 */
 quint16 QKnxLinkLayerFrame::size() const
 {
-    return m_serviceInformation.size() + 1 /* message code */;
+    return d_ptr->m_serviceInformation.size() + 1 /* message code */;
 }
 
 /*!
@@ -390,7 +502,7 @@ quint16 QKnxLinkLayerFrame::size() const
 */
 QKnxLinkLayerPayload QKnxLinkLayerFrame::serviceInformation() const
 {
-    return m_serviceInformation;
+    return d_ptr->m_serviceInformation;
 }
 
 /*!
@@ -399,7 +511,7 @@ QKnxLinkLayerPayload QKnxLinkLayerFrame::serviceInformation() const
 */
 QKnxLinkLayerPayloadRef QKnxLinkLayerFrame::serviceInformationRef(quint16 index) const
 {
-    return m_serviceInformation.ref(index);
+    return d_ptr->m_serviceInformation.ref(index);
 }
 
 
@@ -409,12 +521,12 @@ QKnxLinkLayerPayloadRef QKnxLinkLayerFrame::serviceInformationRef(quint16 index)
 QString QKnxLinkLayerFrame::toString() const
 {
     QString tmp;
-    for (quint8 byte : m_serviceInformation.ref())
+    for (quint8 byte : d_ptr->m_serviceInformation.ref())
         tmp += QStringLiteral("0x%1, ").arg(byte, 2, 16, QLatin1Char('0'));
     tmp.chop(2);
 
     return QStringLiteral("Message code: { 0x%1 }, Service information: { 0x%2 }")
-        .arg(quint8(m_code), 2, 16, QLatin1Char('0')).arg(tmp);
+        .arg(quint8(d_ptr->m_code), 2, 16, QLatin1Char('0')).arg(tmp);
 }
 
 /*!
@@ -422,7 +534,18 @@ QString QKnxLinkLayerFrame::toString() const
 */
 void QKnxLinkLayerFrame::setServiceInformation(const QKnxLinkLayerPayload &serviceInformation)
 {
-    m_serviceInformation = serviceInformation;
+    d_ptr->m_serviceInformation = serviceInformation;
+}
+
+/*!
+    \internal
+
+    Returns the service information for in place modification, detaches the
+    frame data if it is shared.
+*/
+QKnxLinkLayerPayload &QKnxLinkLayerFrame::mutableServiceInformation()
+{
+    return d_ptr->m_serviceInformation;
 }
 
 /*!
@@ -430,7 +553,7 @@ void QKnxLinkLayerFrame::setServiceInformation(const QKnxLinkLayerPayload &servi
 */
 QKnxLinkLayerFrame::MessageCode QKnxLinkLayerFrame::messageCode() const
 {
-    return m_code;
+    return d_ptr->m_code;
 }
 
 /*!
@@ -438,7 +561,7 @@ QKnxLinkLayerFrame::MessageCode QKnxLinkLayerFrame::messageCode() const
 */
 void QKnxLinkLayerFrame::setMessageCode(QKnxLinkLayerFrame::MessageCode code)
 {
-    m_code = code;
+    d_ptr->m_code = code;
 }
 
 /*!
@@ -446,7 +569,7 @@ void QKnxLinkLayerFrame::setMessageCode(QKnxLinkLayerFrame::MessageCode code)
 */
 QKnx::MediumType QKnxLinkLayerFrame::mediumType() const
 {
-    return m_mediumType;
+    return d_ptr->m_mediumType;
 }
 
 /*!
@@ -454,7 +577,7 @@ QKnx::MediumType QKnxLinkLayerFrame::mediumType() const
 */
 void QKnxLinkLayerFrame::setMediumType(QKnx::MediumType type)
 {
-    m_mediumType = type;
+    d_ptr->m_mediumType = type;
 }
 
 QT_END_NAMESPACE
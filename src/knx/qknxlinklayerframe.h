@@ -30,6 +30,8 @@
 #ifndef QKNXLINKLAYERFRAME_H
 #define QKNXLINKLAYERFRAME_H
 
+#include <QtCore/qshareddata.h>
+
 #include <QtKnx/qknxadditionalinfo.h>
 #include <QtKnx/qknxaddress.h>
 #include <QtKnx/qknxcontrolfield.h>
@@ -44,9 +46,13 @@ QT_BEGIN_NAMESPACE
 using QKnxLinkLayerPayload = QKnxNetIpPayload;// TODO remove the QKnxNetIpPayLoad dependency
 using QKnxLinkLayerPayloadRef = QKnxByteStoreRef;
 
+class QKnxLinkLayerFrameView;
+class QKnxLinkLayerFramePrivate;
+
 class Q_KNX_EXPORT QKnxLinkLayerFrame final
 {
     Q_GADGET
+    friend class QKnxLinkLayerFrameView;
 
 public:
     // Table 1 - Overview EMI message codes and default destination (v01.03.03 AS.pdf)
@@ -81,12 +87,22 @@ public:
     void setMediumType(QKnx::MediumType mediumType);
 
 
-    QKnxLinkLayerFrame() = default;
-    ~QKnxLinkLayerFrame() = default;
+    QKnxLinkLayerFrame();
+    ~QKnxLinkLayerFrame();
 
     explicit QKnxLinkLayerFrame(QKnx::MediumType mediumType);
     QKnxLinkLayerFrame(QKnx::MediumType mediumType, QKnxLinkLayerFrame::MessageCode messageCode);
+
     QKnxLinkLayerFrame(const QKnxLinkLayerFrame &other);
+    QKnxLinkLayerFrame(QKnxLinkLayerFrame &&other) Q_DECL_NOTHROW;
+    QKnxLinkLayerFrame &operator=(const QKnxLinkLayerFrame &other);
+    QKnxLinkLayerFrame &operator=(QKnxLinkLayerFrame &&other) Q_DECL_NOTHROW
+    {
+        swap(other);
+        return *this;
+    }
+
+    void swap(QKnxLinkLayerFrame &other) Q_DECL_NOTHROW { d_ptr.swap(other.d_ptr); }
 
     quint16 size() const;
     QString toString() const;
@@ -101,8 +117,8 @@ public:
         static_assert(is_type<T, QByteArray, QVector<quint8>, std::deque<quint8>,
             std::vector<quint8>>::value, "Type not supported.");
 
-        T t(m_serviceInformation.size() + 1, quint8(m_code));
-        auto ref = m_serviceInformation.ref();
+        const auto ref = serviceInformationRef();
+        T t(ref.size() + 1, quint8(messageCode()));
         std::copy(std::begin(ref), std::end(ref), std::next(std::begin(t), 1));
 
         return t;
@@ -118,15 +134,15 @@ public:
         if (type.size() < 1)
             return {};
 
-        QKnxLinkLayerPayload payload;
-        auto begin = std::next(std::begin(type), index);
-        payload.setBytes(std::next(begin, 1), std::next(begin, size));
-
         MessageCode code = MessageCode(QKnxUtils::QUint8::fromBytes(type, index));
         if (mediumType == QKnx::MediumType::Unknown)
             mediumType = guessMediumType(code);
 
-        return QKnxLinkLayerFrame(mediumType, code, payload);
+        // copy the bytes straight into the frame, avoids a temporary payload
+        QKnxLinkLayerFrame frame(mediumType, code);
+        auto begin = std::next(std::begin(type), index);
+        frame.mutableServiceInformation().setBytes(std::next(begin, 1), std::next(begin, size));
+        return frame;
     }
 
     // Parts of the LinkLayer frame alway there (regardless of the MessageCode/Frame Type)
@@ -181,10 +197,9 @@ protected:
     void setServiceInformation(const QKnxLinkLayerPayload &serviceInformation);
 
 private:
-    // TODO: introduce d pointer
-    MessageCode m_code = MessageCode::Unknown;
-    QKnx::MediumType m_mediumType = QKnx::MediumType::Unknown;
-    QKnxLinkLayerPayload m_serviceInformation;
+    QKnxLinkLayerPayload &mutableServiceInformation();
+
+    QSharedDataPointer<QKnxLinkLayerFramePrivate> d_ptr;
 
     // TODO: Move into .cpp file once ::fromBytes is there as well.
     static QKnx::MediumType guessMediumType(MessageCode messageCode)
@@ -215,6 +230,7 @@ private:
 
     }
 };
+Q_DECLARE_SHARED(QKnxLinkLayerFrame)
 
 QT_END_NAMESPACE
 
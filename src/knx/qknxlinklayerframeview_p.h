@@ -0,0 +1,143 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXLINKLAYERFRAMEVIEW_P_H
+#define QKNXLINKLAYERFRAMEVIEW_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtKnx/qknxaddress.h>
+#include <QtKnx/qknxcontrolfield.h>
+#include <QtKnx/qknxextendedcontrolfield.h>
+#include <QtKnx/qknxglobal.h>
+#include <QtKnx/qknxlinklayerframe.h>
+
+QT_BEGIN_NAMESPACE
+
+// Non-owning view over the bytes of a cEMI link layer frame. The view does not copy the bytes it
+// points to, so it must not outlive the buffer it was created from. Use toFrame() to get a
+// QKnxLinkLayerFrame that owns its data.
+class QKnxLinkLayerFrameView final
+{
+public:
+    QKnxLinkLayerFrameView() = default;
+    QKnxLinkLayerFrameView(const quint8 *data, quint16 size)
+        : m_data(data)
+        , m_size(data ? size : 0)
+    {}
+
+    const quint8 *data() const { return m_data; }
+    quint16 size() const { return m_size; }
+    bool isEmpty() const { return m_size == 0; }
+
+    quint8 byte(quint16 index) const
+    {
+        return (index < m_size ? m_data[index] : quint8(0));
+    }
+
+    QKnxLinkLayerFrame::MessageCode messageCode() const
+    {
+        return QKnxLinkLayerFrame::MessageCode(byte(0));
+    }
+
+    quint8 additionalInfosSize() const
+    {
+        auto size = byte(1);
+        return (size < 0xff ? size : 0u); // 0xff is reserved for future use
+    }
+
+    QKnxControlField controlField() const
+    {
+        return QKnxControlField { byte(additionalInfosSize() + 2) };
+    }
+
+    QKnxExtendedControlField extendedControlField() const
+    {
+        return QKnxExtendedControlField { byte(additionalInfosSize() + 3) };
+    }
+
+    QKnxAddress sourceAddress() const
+    {
+        return { QKnxAddress::Type::Individual, word(additionalInfosSize() + 4) };
+    }
+
+    QKnxAddress destinationAddress() const
+    {
+        return { extendedControlField().destinationAddressType(),
+            word(additionalInfosSize() + 6) };
+    }
+
+    // message code + length field + ctrl + extCtrl + 2 * KNX address + length -> 9 bytes
+    quint16 tpduOffset() const { return additionalInfosSize() + 9; }
+    const quint8 *tpduData() const
+    {
+        return (tpduOffset() < m_size ? m_data + tpduOffset() : nullptr);
+    }
+    quint16 tpduSize() const
+    {
+        return (tpduOffset() < m_size ? m_size - tpduOffset() : 0);
+    }
+
+    QKnxLinkLayerFrame toFrame(QKnx::MediumType mediumType = QKnx::MediumType::Unknown) const
+    {
+        if (m_size < 1)
+            return {};
+
+        if (mediumType == QKnx::MediumType::Unknown)
+            mediumType = QKnxLinkLayerFrame::guessMediumType(messageCode());
+        QKnxLinkLayerFrame frame(mediumType, messageCode());
+        frame.mutableServiceInformation().setBytes(m_data + 1, m_data + m_size);
+        return frame;
+    }
+
+private:
+    quint16 word(quint16 index) const
+    {
+        return quint16(quint16(byte(index)) << 8 | byte(index + 1));
+    }
+
+private:
+    const quint8 *m_data = nullptr;
+    quint16 m_size = 0;
+};
+
+Q_DECLARE_TYPEINFO(QKnxLinkLayerFrameView, Q_PRIMITIVE_TYPE);
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,122 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXSPSCRINGBUFFER_P_H
+#define QKNXSPSCRINGBUFFER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qatomic.h>
+#include <QtKnx/qknxglobal.h>
+
+#include <memory>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+// Bounded lock-free queue for exactly one producer and one consumer thread. push() may only
+// be called from the producer, pop() only from the consumer. The capacity is rounded up to
+// the next power of two.
+template <typename T> class QKnxSpscRingBuffer final
+{
+    Q_DISABLE_COPY(QKnxSpscRingBuffer)
+
+public:
+    explicit QKnxSpscRingBuffer(int capacity = 1024)
+    {
+        quint32 size = 1;
+        while (size < quint32(qMax(capacity, 1)))
+            size <<= 1;
+        m_mask = size - 1;
+        m_buffer.reset(new T[size]);
+    }
+
+    int capacity() const { return int(m_mask + 1); }
+
+    int size() const
+    {
+        const quint32 tail = m_tail.value.loadAcquire();
+        return int(m_head.value.loadAcquire() - tail);
+    }
+
+    bool isEmpty() const
+    {
+        return m_head.value.loadAcquire() == m_tail.value.loadAcquire();
+    }
+
+    bool push(const T &value)
+    {
+        const quint32 head = m_head.value.load();
+        if (head - m_tail.value.loadAcquire() > m_mask)
+            return false;
+
+        m_buffer[head & m_mask] = value;
+        m_head.value.storeRelease(head + 1);
+        return true;
+    }
+
+    bool pop(T *value)
+    {
+        const quint32 tail = m_tail.value.load();
+        if (tail == m_head.value.loadAcquire())
+            return false;
+
+        T &slot = m_buffer[tail & m_mask];
+        *value = std::move(slot);
+        slot = T();
+        m_tail.value.storeRelease(tail + 1);
+        return true;
+    }
+
+private:
+    // producer and consumer index on separate cache lines, they are written by different threads
+    struct Index
+    {
+        QAtomicInteger<quint32> value { 0 };
+        char padding[64 - sizeof(QAtomicInteger<quint32>)];
+    };
+    Index m_head;
+    Index m_tail;
+
+    quint32 m_mask { 0 };
+    std::unique_ptr<T[]> m_buffer;
+};
+
+QT_END_NAMESPACE
+
+#endif
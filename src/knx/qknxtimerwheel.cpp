@@ -0,0 +1,227 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include "qknxtimerwheel_p.h"
+
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qcoreevent.h>
+#include <QtCore/qthreadstorage.h>
+
+QT_BEGIN_NAMESPACE
+
+// -- QKnxWheelTimer
+
+QKnxWheelTimer::~QKnxWheelTimer()
+{
+    stop();
+}
+
+void QKnxWheelTimer::start()
+{
+    start(m_interval);
+}
+
+void QKnxWheelTimer::start(int msec)
+{
+    stop();
+    m_interval = qMax(0, msec);
+    QKnxTimerWheel::instance()->add(this, m_interval);
+}
+
+void QKnxWheelTimer::stop()
+{
+    if (m_wheel)
+        m_wheel->remove(this);
+}
+
+
+// -- QKnxTimerWheel
+
+Q_GLOBAL_STATIC(QThreadStorage<QKnxTimerWheel *>, timerWheels)
+
+QKnxTimerWheel::~QKnxTimerWheel()
+{
+    for (auto &head : m_slots) {
+        while (auto timer = head) {
+            unlink(timer);
+            timer->m_wheel = nullptr;
+        }
+    }
+    m_count = 0;
+}
+
+QKnxTimerWheel *QKnxTimerWheel::instance()
+{
+    auto wheels = timerWheels();
+    if (!wheels->hasLocalData())
+        wheels->setLocalData(new QKnxTimerWheel);
+    return wheels->localData();
+}
+
+void QKnxTimerWheel::timerEvent(QTimerEvent *event)
+{
+    if (event->timerId() != m_timer.timerId()) {
+        QObject::timerEvent(event);
+        return;
+    }
+
+    m_timer.stop();
+    m_scheduledTick = -1;
+
+    // catch up with all ticks passed since the last event, the event loop might have been busy;
+    // empty slots are skipped using the occupancy bitmap
+    const qint64 now = m_clock.elapsed() / Resolution;
+    while (m_count > 0) {
+        const qint64 next = nextOccupiedTick();
+        if (next < 0 || next > now)
+            break;
+        m_tick = next;
+        expire(int(m_tick % SlotCount));
+    }
+    m_tick = qMax(m_tick, now);
+
+    // a callback can start or stop any timer, including the ones that expired with it
+    while (auto timer = m_slots[SlotCount]) {
+        remove(timer);
+        if (timer->m_callback)
+            timer->m_callback();
+    }
+
+    if (m_count > 0)
+        scheduleAt(nextOccupiedTick());
+}
+
+void QKnxTimerWheel::add(QKnxWheelTimer *timer, int msec)
+{
+    if (!m_clock.isValid())
+        m_clock.start();
+
+    // without pending timers no ticks were processed, start counting from now
+    if (m_count == 0)
+        m_tick = m_clock.elapsed() / Resolution;
+
+    // the due tick is computed from the current time, not from the last processed tick
+    const qint64 due = (m_clock.elapsed() + msec + Resolution - 1) / Resolution;
+    const qint64 ticks = qMax(qint64(1), due - m_tick);
+
+    timer->m_wheel = this;
+    timer->m_rounds = int((ticks - 1) / SlotCount);
+    link(timer, int((m_tick + ticks) % SlotCount));
+    ++m_count;
+
+    scheduleAt(m_tick + (ticks - 1) % SlotCount + 1);
+}
+
+void QKnxTimerWheel::remove(QKnxWheelTimer *timer)
+{
+    unlink(timer);
+    timer->m_wheel = nullptr;
+
+    if (--m_count == 0) {
+        m_timer.stop();
+        m_scheduledTick = -1;
+    }
+}
+
+void QKnxTimerWheel::link(QKnxWheelTimer *timer, int slot)
+{
+    if (slot < SlotCount)
+        m_occupied[slot / 64] |= quint64(1) << (slot % 64);
+
+    timer->m_slot = slot;
+    timer->m_prev = nullptr;
+    timer->m_next = m_slots[slot];
+    if (timer->m_next)
+        timer->m_next->m_prev = timer;
+    m_slots[slot] = timer;
+}
+
+void QKnxTimerWheel::unlink(QKnxWheelTimer *timer)
+{
+    if (timer->m_prev)
+        timer->m_prev->m_next = timer->m_next;
+    else
+        m_slots[timer->m_slot] = timer->m_next;
+    if (timer->m_next)
+        timer->m_next->m_prev = timer->m_prev;
+
+    const int slot = timer->m_slot;
+    if (slot < SlotCount && !m_slots[slot])
+        m_occupied[slot / 64] &= ~(quint64(1) << (slot % 64));
+
+    timer->m_prev = timer->m_next = nullptr;
+    timer->m_slot = -1;
+}
+
+void QKnxTimerWheel::expire(int slot)
+{
+    auto timer = m_slots[slot];
+    while (timer) {
+        auto next = timer->m_next;
+        if (timer->m_rounds > 0) {
+            --timer->m_rounds;
+        } else {
+            unlink(timer);
+            link(timer, SlotCount);
+        }
+        timer = next;
+    }
+}
+
+qint64 QKnxTimerWheel::nextOccupiedTick() const
+{
+    // search the bitmap word by word, starting right after the current tick and wrapping around
+    // to the bits before it in the first word
+    const int start = int((m_tick + 1) % SlotCount);
+    for (int i = 0; i <= OccupancyWords; ++i) {
+        const int word = (start / 64 + i) % OccupancyWords;
+        quint64 bits = m_occupied[word];
+        if (i == 0)
+            bits &= ~quint64(0) << (start % 64);
+        else if (i == OccupancyWords)
+            bits &= ~(~quint64(0) << (start % 64));
+        if (bits) {
+            const int slot = word * 64 + int(qCountTrailingZeroBits(bits));
+            return m_tick + 1 + (slot - start + SlotCount) % SlotCount;
+        }
+    }
+    return -1;
+}
+
+void QKnxTimerWheel::scheduleAt(qint64 tick)
+{
+    if (m_scheduledTick >= 0 && m_scheduledTick <= tick)
+        return;
+
+    m_scheduledTick = tick;
+    const qint64 delay = qMax(qint64(0), tick * Resolution - m_clock.elapsed());
+    m_timer.start(int(delay), Qt::PreciseTimer, this);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,138 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXTIMERWHEEL_P_H
+#define QKNXTIMERWHEEL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qbasictimer.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qobject.h>
+#include <QtKnx/qknxglobal.h>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+class QKnxTimerWheel;
+
+// Single shot timer driven by the timer wheel of the thread it is started in. Unlike QTimer it
+// does not allocate, does not register an OS timer and costs O(1) to start and stop. It must be
+// started and stopped from the same thread.
+class Q_KNX_EXPORT QKnxWheelTimer final
+{
+    Q_DISABLE_COPY(QKnxWheelTimer)
+
+public:
+    QKnxWheelTimer() = default;
+    ~QKnxWheelTimer();
+
+    void setCallback(const std::function<void()> &callback) { m_callback = callback; }
+
+    int interval() const { return m_interval; }
+    void setInterval(int msec) { m_interval = qMax(0, msec); }
+
+    bool isActive() const { return m_wheel != nullptr; }
+
+    void start();
+    void start(int msec);
+    void stop();
+
+private:
+    friend class QKnxTimerWheel;
+
+    std::function<void()> m_callback;
+    int m_interval { 0 };
+
+    QKnxTimerWheel *m_wheel { nullptr };
+    QKnxWheelTimer *m_prev { nullptr };
+    QKnxWheelTimer *m_next { nullptr };
+    int m_slot { -1 };
+    int m_rounds { 0 };
+};
+
+// Hashed timer wheel, one per thread. Timers are kept in intrusive lists, one per slot; a slot
+// is visited every SlotCount ticks and a timer fires on the visit its remaining rounds reach
+// zero. A bitmap marks the occupied slots, so a single QBasicTimer is only armed for the next
+// slot that holds a timer and idle ticks cost nothing.
+class Q_KNX_EXPORT QKnxTimerWheel final : public QObject
+{
+public:
+    ~QKnxTimerWheel() override;
+
+    static QKnxTimerWheel *instance();
+
+    int activeTimerCount() const { return m_count; }
+
+    static constexpr const int Resolution = 10; // msec per tick
+    static constexpr const int SlotCount = 512;
+
+protected:
+    void timerEvent(QTimerEvent *event) override;
+
+private:
+    QKnxTimerWheel() = default;
+    friend class QKnxWheelTimer;
+
+    void add(QKnxWheelTimer *timer, int msec);
+    void remove(QKnxWheelTimer *timer);
+
+    void link(QKnxWheelTimer *timer, int slot);
+    void unlink(QKnxWheelTimer *timer);
+
+    void expire(int slot);
+    qint64 nextOccupiedTick() const;
+    void scheduleAt(qint64 tick);
+
+private:
+    // the additional last slot holds expired timers until their callback was invoked
+    QKnxWheelTimer *m_slots[SlotCount + 1] {};
+    static constexpr const int OccupancyWords = SlotCount / 64;
+    quint64 m_occupied[OccupancyWords] {};
+    int m_count { 0 };
+
+    QElapsedTimer m_clock;
+    qint64 m_tick { 0 };
+    qint64 m_scheduledTick { -1 };
+    QBasicTimer m_timer;
+};
+
+QT_END_NAMESPACE
+
+#endif
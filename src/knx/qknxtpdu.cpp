@@ -30,6 +30,8 @@
 #include "qknxtpdu.h"
 #include "qknxutils.h"
 
+#include <QtCore/qvarlengtharray.h>
+
 QT_BEGIN_NAMESPACE
 
 /*!
@@ -188,99 +190,109 @@ static bool isBitSet(quint8 byteToTest, quint8 bit)
     return (byteToTest & (quint8(1) << bit)) != 0;
 };
 
+// Decodes the TPCI from the first octet, see 03_03_04 Transport Layer Paragraph 2.
+static constexpr qint16 decodeTpci(int octet6)
+{
+    return ((octet6 & 0xc2) == 0xc2) ? qint16(octet6 & 0xc3) // T_ACK/ T_NACK, no APCI, mask out
+                                                            // the sequence number
+        : ((octet6 & 0xc0) == 0x80) ? qint16(octet6)        // T_CONNECT/ T_DISCONNECT
+        : ((octet6 & 0xc0) == 0x40) ? qint16(octet6 & 0xc0) // T_DATA_CONNECTED, mask out the APCI
+                                                            // and the sequence number
+        : qint16(octet6 & 0xfc);                            // mask out the APCI
+}
+
+// Decodes the APCI from the lower two bits of the first octet and the second octet. The four bit
+// APCI only uses the upper two bits of the second octet, the ten bit APCI uses all of them.
+static constexpr quint16 decodeApci(int apciHigh, int octet7, bool connected)
+{
+    return (apciHigh == 0x01)
+        // it's one of the A_ADC (connection oriented) or A_IndividualAddress services
+        ? quint16((apciHigh << 8) | (connected ? (octet7 & 0xc0) : octet7))
+        : quint16((apciHigh << 8) | (((octet7 & 0xc0) == 0xc0) ? octet7 : (octet7 & 0xc0)));
+}
+
+// Table entry for the index [connected:1][octet6 & 0x03:2][octet7:8].
+static constexpr quint16 decodeApciEntry(int index)
+{
+    return decodeApci((index >> 8) & 0x03, index & 0xff, (index & 0x400) != 0);
+}
+
+#define QKNX_TABLE_4(F, i) F(i), F(i + 1), F(i + 2), F(i + 3)
+#define QKNX_TABLE_16(F, i) QKNX_TABLE_4(F, i), QKNX_TABLE_4(F, i + 4), \
+    QKNX_TABLE_4(F, i + 8), QKNX_TABLE_4(F, i + 12)
+#define QKNX_TABLE_64(F, i) QKNX_TABLE_16(F, i), QKNX_TABLE_16(F, i + 16), \
+    QKNX_TABLE_16(F, i + 32), QKNX_TABLE_16(F, i + 48)
+#define QKNX_TABLE_256(F, i) QKNX_TABLE_64(F, i), QKNX_TABLE_64(F, i + 64), \
+    QKNX_TABLE_64(F, i + 128), QKNX_TABLE_64(F, i + 192)
+#define QKNX_TABLE_1024(F, i) QKNX_TABLE_256(F, i), QKNX_TABLE_256(F, i + 256), \
+    QKNX_TABLE_256(F, i + 512), QKNX_TABLE_256(F, i + 768)
+
+static const constexpr qint16 TpciTable[256] = { QKNX_TABLE_256(decodeTpci, 0) };
+static const constexpr quint16 ApciTable[2048] = {
+    QKNX_TABLE_1024(decodeApciEntry, 0), QKNX_TABLE_1024(decodeApciEntry, 1024)
+};
+
+#undef QKNX_TABLE_1024
+#undef QKNX_TABLE_256
+#undef QKNX_TABLE_64
+#undef QKNX_TABLE_16
+#undef QKNX_TABLE_4
+
 class QKnxTpduPrivate final : public QSharedData
 {
 public:
     QKnxTpduPrivate() = default;
     ~QKnxTpduPrivate() = default;
 
-    QVector<quint8> m_tpduBytes;
+    // A standard frame TPDU, [TPCI|APCI][APCI|data] followed by up to 14 bytes of data, fits
+    // into the inline buffer. Only extended frames need to allocate.
+    QVarLengthArray<quint8, 16> m_tpduBytes;
     qint32 m_apci = -1;
     qint16 m_tpci = -1;
-    void setApci();
-    void setTpci();
+    void decode();
+    void resize(int size);
     void setByte(quint16 index, quint8 byte);
     void appendBytes(const QVector<quint8> &bytesToAppend);
 };
 
-void QKnxTpduPrivate::setByte(quint16 index, quint8 byte)
+void QKnxTpduPrivate::resize(int size)
 {
-    if (m_tpduBytes.size() <= index)
-        m_tpduBytes.resize(index + 1);
-    m_tpduBytes[index] = byte;
+    const int oldSize = m_tpduBytes.size();
+    m_tpduBytes.resize(size);
+    if (size > oldSize)
+        std::fill(std::next(std::begin(m_tpduBytes), oldSize), std::end(m_tpduBytes), 0);
 }
 
-void QKnxTpduPrivate::setApci()
+void QKnxTpduPrivate::setByte(quint16 index, quint8 byte)
 {
-    std::bitset<8> apciHigh = m_tpduBytes[0] & 0x03; // mask out all bits except the first two
-    std::bitset<8> apciLow = m_tpduBytes[1] & 0xc0;  // mask out all bits except the last two
-
-    const auto fourBitsApci = [&apciHigh, &apciLow]() {
-        QVector<quint8> apciBytes = { { quint8(apciHigh.to_ulong()), quint8(apciLow.to_ulong()) } };
-        return (QKnxUtils::QUint16::fromBytes(apciBytes));
-    };
-    const auto tenBitsApci = [apciHigh](quint8 octet7) {
-        QVector<quint8> apciBytes = { { quint8(apciHigh.to_ulong()), octet7 } };
-        return (QKnxUtils::QUint16::fromBytes(apciBytes));
-    };
-    if ((apciHigh[0] == 0 && apciHigh[1] == 0) || (apciHigh[0] == 1 && apciHigh[1] == 1)) {
-        std::bitset<8> octet7 = m_tpduBytes[1];
-        if (octet7[7] == 1 && octet7[6] == 1) {
-            m_apci  = qint32(tenBitsApci(m_tpduBytes[1]));
-            return;
-        }
-        m_apci = qint32(fourBitsApci());
-        return;
-    }
-    if (apciHigh[1] == 0 && apciHigh[0] == 1) {
-        // connection oriented, it's one of the A_ADC service
-        if (m_tpci > 0) {
-            m_apci = qint32(fourBitsApci());
-            return;
-        }
-        m_apci = qint32(tenBitsApci(m_tpduBytes[1]));
-        return;
-    }
-    // it's one of the A_Memory Service (only the 2 last bits of octet 6 are needed for the APCI)
-    if (apciLow[7] == 0 || apciLow[6] == 0) {
-        m_apci = qint32(fourBitsApci());
-        return;
-    }
-    m_apci = qint32(m_tpduBytes[1]);
-    return;
+    if (m_tpduBytes.size() <= index)
+        resize(index + 1);
+    m_tpduBytes[index] = byte;
 }
 
-void QKnxTpduPrivate::setTpci()
+void QKnxTpduPrivate::decode()
 {
     if (m_tpduBytes.size() < 1) {
         m_tpci = -1;
+        m_apci = -1;
         return;
     }
-    if (isBitSet(m_tpduBytes[0], 7) && isBitSet(m_tpduBytes[0], 6) && isBitSet(m_tpduBytes[0], 1)) { // T_ACK/ T_NACK
-        m_tpci = qint16(m_tpduBytes[0] & 0xc3); // no APCI, mask out sequence number
-        return;
-    }
-    if (isBitSet(m_tpduBytes[0], 7) && (!isBitSet(m_tpduBytes[0], 6))) {// T_CONNECT/ T_DISCONNECT
-        m_tpci = qint16(m_tpduBytes[0]); // no APCI, no sequence number
-        return;
-    }
-    if (isBitSet(m_tpduBytes[0], 6) && (!isBitSet(m_tpduBytes[0], 7))) {// T_DATA_CONNECTED, mask out the APCI
-        m_tpci = qint16((m_tpduBytes[0] & 0xfc) & 0xc3); // mask out the APCI and the sequence number
+
+    const quint8 octet6 = m_tpduBytes[0];
+    m_tpci = TpciTable[octet6];
+
+    if (m_tpduBytes.size() < 2) {
+        m_apci = -1;
         return;
     }
-    m_tpci = qint16(m_tpduBytes[0] & 0xfc); // mask out the APCI
-    return;
+    m_apci = ApciTable[(m_tpci > 0 ? 0x400 : 0) | ((octet6 & 0x03) << 8) | m_tpduBytes[1]];
 }
 
 void QKnxTpduPrivate::appendBytes(const QVector<quint8> &bytesToAppend)
 {
-    quint16 pos = quint16(m_tpduBytes.size());
     if (bytesToAppend.size() <= 0)
         return;
-    m_tpduBytes.resize(pos + quint16(bytesToAppend.size()));
-
-    std::copy(std::begin(bytesToAppend), std::end(bytesToAppend),
-        std::next(std::begin(m_tpduBytes), pos));
+    m_tpduBytes.append(bytesToAppend.constData(), bytesToAppend.size());
 }
 
 quint16 QKnxTpdu::size() const
@@ -296,21 +308,22 @@ quint8 QKnxTpdu::byte(quint16 index) const
 
 QVector<quint8> QKnxTpdu::bytes() const
 {
-    return d_ptr->m_tpduBytes;
+    return bytes(0, size());
 }
 QVector<quint8> QKnxTpdu::bytes(quint16 start, quint16 count) const
 {
     if (size() < start + count)
         return {};
-    return d_ptr->m_tpduBytes.mid(start, count);
+    QVector<quint8> bytes(count);
+    std::copy_n(std::next(d_ptr->m_tpduBytes.constData(), start), count, std::begin(bytes));
+    return bytes;
 }
 
 void QKnxTpdu::setBytes(QVector<quint8>::const_iterator begin, QVector<quint8>::const_iterator end)
 {
-    d_ptr->m_tpduBytes.resize(std::distance(begin, end));
+    d_ptr->m_tpduBytes.resize(int(std::distance(begin, end)));
     std::copy(begin, end, std::begin(d_ptr->m_tpduBytes));
-    d_ptr->setTpci();
-    d_ptr->setApci();
+    d_ptr->decode();
 }
 
 QString QKnxTpdu::toString() const
@@ -340,7 +353,7 @@ void QKnxTpdu::setTransportControlField(TransportControlField tpci)
     d_ptr->m_tpci = qint16(tpci);
 
     if (size() < 1)
-        d_ptr->m_tpduBytes.resize(1);
+        d_ptr->resize(1);
 
     switch (tpci ) {
     case TransportControlField::DataBroadcast:
@@ -387,10 +400,9 @@ void QKnxTpdu::setApplicationControlField(ApplicationControlField apci)
         d_ptr->m_apci = qint32(apci);
 
     if (size() < 2)
-        d_ptr->m_tpduBytes.resize(2);
-    auto tmp = QKnxUtils::QUint16::bytes(quint16(apci));
-    d_ptr->setByte(0, (byte(0) & 0xfc) | tmp[0]);
-    d_ptr->setByte(1, (byte(1) & 0x3f) | tmp[1]);
+        d_ptr->resize(2);
+    d_ptr->setByte(0, (byte(0) & 0xfc) | quint8(quint16(apci) >> 8));
+    d_ptr->setByte(1, (byte(1) & 0x3f) | quint8(apci));
 }
 
 QKnxTpdu::QKnxTpdu()
@@ -595,7 +607,7 @@ QVector<quint8> QKnxTpdu::data() const
     case ApplicationControlField::DeviceDescriptorRead:
     case ApplicationControlField::DeviceDescriptorResponse:
     case ApplicationControlField::Restart: // 6 bits from an optimized TPDU
-        dataApci = QKnxUtils::QUint8::bytes<QVector<quint8>>(quint8(byte(1) & 0x3f));
+        dataApci.append(quint8(byte(1) & 0x3f));
     default:
         break;
     }
@@ -619,10 +631,10 @@ void QKnxTpdu::setData(const QVector<quint8> &data)
     }
 
     auto apci = applicationControlField();
-    auto apciBytes = QKnxUtils::QUint16::bytes<QVector<quint8>>(quint16(apci));
+    const auto apciLow = quint8(apci);
 
-    d_ptr->m_tpduBytes.resize(2); // always resize to minimum size
-    d_ptr->setByte(1, apciBytes[1]); // and clear the possible 6 bits of the upper APCI byteToTest
+    d_ptr->resize(2); // always resize to minimum size
+    d_ptr->setByte(1, apciLow); // and clear the possible 6 bits of the upper APCI byteToTest
 
     if (data.isEmpty())
         return; // no data, bytes got cleared before
@@ -642,7 +654,7 @@ void QKnxTpdu::setData(const QVector<quint8> &data)
     case ApplicationControlField::DeviceDescriptorRead:
     case ApplicationControlField::DeviceDescriptorResponse:
     case ApplicationControlField::Restart:
-        d_ptr->setByte(1, apciBytes[1] | quint8(data[0]));
+        d_ptr->setByte(1, apciLow | quint8(data[0]));
         remainingData = data.mid(1); Q_FALLTHROUGH();
 
     default:
@@ -41,9 +41,8 @@
 // We mean it.
 //
 
-#include <QtCore/qhash.h>
-
 #include <QtKnx/qknxaddress.h>
+#include <QtKnx/qknxaddressmap.h>
 #include <QtKnx/qknxglobal.h>
 
 #include <private/qknxtransportlayerstatemachine_p.h>
@@ -57,7 +56,7 @@ class Q_KNX_EXPORT QKnxTransportLayerPrivate : public QObjectPrivate
 
 public:
     QKnxLinkLayerDevice *m_lld = { nullptr };
-    QHash<QKnxAddress, QKnxTransportLayerStateMachine*> m_connections;
+    QKnxAddressMap<QKnxTransportLayerStateMachine*> m_connections;
 };
 
 QT_END_NAMESPACE
@@ -39,15 +39,13 @@ QKnxTransportLayerStateMachine::QKnxTransportLayerStateMachine(QObject *parent)
     : QObject(parent)
 {
     connectionTimeoutTimer.setInterval(6000);
-    connectionTimeoutTimer.setSingleShot(true);
-    connect(&connectionTimeoutTimer, &QTimer::timeout, this, [&]() {
+    connectionTimeoutTimer.setCallback([&]() {
         qCDebug(QT_KNX_TL_STM) << "Connection timeout.";
         processEvent(Event::Event16);
     });
 
     acknowledgmentTimeoutTimer.setInterval(3000);
-    acknowledgmentTimeoutTimer.setSingleShot(true);
-    connect(&acknowledgmentTimeoutTimer, &QTimer::timeout, this, [&]() {
+    acknowledgmentTimeoutTimer.setCallback([&]() {
         qCDebug(QT_KNX_TL_STM) << "Acknowledgment timeout.";
         qCDebug(QT_KNX_TL_STM) << "Repetition count:" << repCount;
         processEvent(repCount < 3 ? Event::Event17 : Event::Event18);
@@ -43,8 +43,8 @@
 
 #include <QtCore/qloggingcategory.h>
 #include <QtCore/qobject.h>
-#include <QtCore/qtimer.h>
 
+#include <QtKnx/private/qknxtimerwheel_p.h>
 #include <QtKnx/private/qknxtransportlayerstate_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -107,8 +107,8 @@ private:
     void doActionA15();
 
 private:
-    QTimer connectionTimeoutTimer;
-    QTimer acknowledgmentTimeoutTimer;
+    QKnxWheelTimer connectionTimeoutTimer;
+    QKnxWheelTimer acknowledgmentTimeoutTimer;
 
     quint64 repCount { 0 };
     quint8 seqNoSend { 0 }, seqNoRcv { 0 };
@@ -4,6 +4,7 @@ SUBDIRS += cmake \
     qknxaddress \
     qknxnetipconfigdib \
     qknxnetipconnectionheader \
+    qknxnetipconnectionstatistics \
     qknxnetipconnectionstaterequest \
     qknxnetipconnectionstateresponse \
     qknxnetipconnectrequest \
@@ -21,6 +22,7 @@ SUBDIRS += cmake \
     qknxnetiphpai \
     qknxnetipknxaddressesdib \
     qknxnetipmanufacturerdib \
+    qknxnetiprouter \
     qknxnetiproutingbusy \
     qknxnetiproutingindication \
     qknxnetiproutinglostmessage \
@@ -28,6 +30,9 @@ SUBDIRS += cmake \
     qknxnetipsearchresponse \
     qknxnetipservicefamiliesdib \
     qknxnetipstructure \
+    qknxnetipthreadedtunnelconnection \
+    qknxnetiptunnelconnection \
+    qknxnetiptunnelconnectionpool \
     qknxnetiptunnelingacknowledge \
     qknxnetiptunnelingrequest \
     qknxtunnelframe \
@@ -38,5 +43,9 @@ SUBDIRS += cmake \
     qknxdatapointtype \
     qknxproject \
     qknxtransportlayerstatemachine \
+    qknxtimerwheel \
     qknxgroupaddressinfo \
-    qknxbytearray
+    qknxbytearray \
+    qknxgroupaddressset \
+    qknxaddressmap \
+    qzipreader
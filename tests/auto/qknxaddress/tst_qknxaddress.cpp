@@ -387,6 +387,65 @@ private slots:
         QTEST(address.bytes<QVector<quint8>>(), "bytes");
     }
 
+    void testConstructorFromStringView()
+    {
+        QKnxAddress address(QKnxAddress::Type::Group, QStringView(u"0x1f/07/0xff"));
+        QCOMPARE(address.type(), QKnxAddress::Type::Group);
+        QCOMPARE(address.toString(), QStringLiteral("31/7/255"));
+
+        address = QKnxAddress(QKnxAddress::Type::Group, QLatin1String(" 1 / 2000 "));
+        QCOMPARE(address.type(), QKnxAddress::Type::Group);
+        QCOMPARE(address.toString(QKnxAddress::Notation::TwoLevel), QStringLiteral("1/2000"));
+
+        address = QKnxAddress(QKnxAddress::Type::Individual, QLatin1String("1.1.10"));
+        QCOMPARE(address.type(), QKnxAddress::Type::Individual);
+        QCOMPARE(address.toString(), QStringLiteral("1.1.10"));
+
+        const QString text = QStringLiteral("1.1.10/2/3");
+        address = QKnxAddress(QKnxAddress::Type::Individual, QStringView(text).left(6));
+        QCOMPARE(address.toString(), QStringLiteral("1.1.10"));
+
+        const char *invalid[] = { "0x", "08", "1/2/", "0x10000", "1/2/3/4", "256/1/1", "1.1",
+            "1/1.1" };
+        for (const char *data : invalid) {
+            QCOMPARE(QKnxAddress(QKnxAddress::Type::Group, QLatin1String(data)).isValid(), false);
+            QCOMPARE(QKnxAddress(QKnxAddress::Type::Individual, QLatin1String(data)).isValid(),
+                false);
+        }
+    }
+
+    void testAppendTo()
+    {
+        QString string = QStringLiteral("address: ");
+        QKnxAddress::createGroup(1, 2, 3).appendTo(string);
+        QCOMPARE(string, QStringLiteral("address: 1/2/3"));
+
+        string.clear();
+        QKnxAddress::createGroup(31, 2047).appendTo(string, QKnxAddress::Notation::TwoLevel);
+        QCOMPARE(string, QStringLiteral("31/2047"));
+
+        string.clear();
+        QKnxAddress::createIndividual(15, 15, 255).appendTo(string);
+        QKnxAddress::createIndividual(15, 15, 255).appendTo(string,
+            QKnxAddress::Notation::TwoLevel);
+        QKnxAddress().appendTo(string);
+        QCOMPARE(string, QStringLiteral("15.15.255"));
+
+        for (int i = 0; i <= 0xffff; ++i) {
+            const QKnxAddress group(QKnxAddress::Type::Group, quint16(i));
+            string.clear();
+            group.appendTo(string, QKnxAddress::Notation::TwoLevel);
+            QCOMPARE(QKnxAddress(QKnxAddress::Type::Group, string), group);
+            string.clear();
+            group.appendTo(string);
+            QCOMPARE(QKnxAddress(QKnxAddress::Type::Group, string), group);
+
+            const QKnxAddress individual(QKnxAddress::Type::Individual, quint16(i));
+            QCOMPARE(QKnxAddress(QKnxAddress::Type::Individual, individual.toString()),
+                individual);
+        }
+    }
+
     void testConstructorFromQByteArray_data()
     {
         QTEST_COLUMNS
@@ -0,0 +1,7 @@
+TARGET = tst_qknxaddressmap
+
+QT = core testlib knx
+CONFIG += testcase c++11
+
+CONFIG -= app_bundle
+SOURCES += tst_qknxaddressmap.cpp
@@ -0,0 +1,124 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+#include <QtCore/qhash.h>
+#include <QtKnx/qknxaddressmap.h>
+#include <QtTest/qtest.h>
+
+#include <algorithm>
+
+class tst_QKnxAddressMap : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testDefaultConstructor()
+    {
+        QKnxAddressMap<int> map;
+        QCOMPARE(map.isEmpty(), true);
+        QCOMPARE(map.size(), 0);
+        QCOMPARE(map.contains(QKnxAddress::Group::Broadcast), false);
+        QVERIFY(!map.find(QKnxAddress::Group::Broadcast));
+        QCOMPARE(map.value(QKnxAddress::Group::Broadcast, 42), 42);
+        QCOMPARE(map.remove(QKnxAddress::Group::Broadcast), false);
+    }
+
+    void testTypeIsPartOfTheKey()
+    {
+        QKnxAddressMap<QString> map;
+        map.insert({ QKnxAddress::Type::Group, 0x1101 }, QStringLiteral("group"));
+        map.insert({ QKnxAddress::Type::Individual, 0x1101 }, QStringLiteral("individual"));
+        map[QKnxAddress()] = QStringLiteral("invalid");
+
+        QCOMPARE(map.size(), 3);
+        QCOMPARE(map.value({ QKnxAddress::Type::Group, 0x1101 }), QStringLiteral("group"));
+        QCOMPARE(map.value({ QKnxAddress::Type::Individual, 0x1101 }),
+            QStringLiteral("individual"));
+        QCOMPARE(map.value(QKnxAddress()), QStringLiteral("invalid"));
+
+        QCOMPARE(map.take({ QKnxAddress::Type::Group, 0x1101 }), QStringLiteral("group"));
+        QCOMPARE(map.contains({ QKnxAddress::Type::Group, 0x1101 }), false);
+        QCOMPARE(map.contains({ QKnxAddress::Type::Individual, 0x1101 }), true);
+    }
+
+    void testCompareWithHash()
+    {
+        QKnxAddressMap<int> map;
+        QHash<QKnxAddress, int> hash;
+
+        quint32 random = 1;
+        for (int i = 0; i < 100000; ++i) {
+            random = random * 1103515245 + 12345;
+            const QKnxAddress key((random & 0x100) ? QKnxAddress::Type::Group
+                : QKnxAddress::Type::Individual, quint16((random >> 16) % 4096));
+            switch ((random >> 9) % 4) {
+            case 0:
+            case 1:
+                map.insert(key, i);
+                hash.insert(key, i);
+                break;
+            case 2:
+                QCOMPARE(map.remove(key), hash.remove(key) > 0);
+                break;
+            default:
+                QCOMPARE(map.value(key, -1), hash.value(key, -1));
+                break;
+            }
+            QCOMPARE(map.size(), hash.size());
+        }
+
+        auto keys = map.keys();
+        auto expected = hash.keys().toVector();
+        const auto lessThan = [](const QKnxAddress &a, const QKnxAddress &b) {
+            return qMakePair(a.type(), a.toString()) < qMakePair(b.type(), b.toString());
+        };
+        std::sort(keys.begin(), keys.end(), lessThan);
+        std::sort(expected.begin(), expected.end(), lessThan);
+        QCOMPARE(keys, expected);
+    }
+
+    void testImplicitSharing()
+    {
+        QKnxAddressMap<int> map;
+        map.reserve(100);
+        QVERIFY(map.capacity() >= 100);
+        map.insert(QKnxAddress::Group::Broadcast, 1);
+
+        QKnxAddressMap<int> copy = map;
+        *copy.find(QKnxAddress::Group::Broadcast) = 2;
+        QCOMPARE(map.value(QKnxAddress::Group::Broadcast), 1);
+        QCOMPARE(copy.value(QKnxAddress::Group::Broadcast), 2);
+
+        copy.clear();
+        QCOMPARE(copy.isEmpty(), true);
+        QCOMPARE(map.size(), 1);
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_QKnxAddressMap)
+
+#include "tst_qknxaddressmap.moc"
@@ -46,6 +46,7 @@
 #include <QtKnx/qknxchar.h>
 #include <QtKnx/qknxcharstring.h>
 #include <QtKnx/qknxdatapointtype.h>
+#include <QtKnx/qknxdatapointtypecodec.h>
 #include <QtKnx/qknxdatapointtypefactory.h>
 #include <QtKnx/qknxdatetime.h>
 #include <QtKnx/qknxelectricalenergy.h>
@@ -58,6 +59,8 @@
 #include <QtKnx/qknxutils.h>
 #include <QtTest/qtest.h>
 
+#include <cmath>
+
 class tst_QKnxDatapointType : public QObject
 {
     Q_OBJECT
@@ -74,6 +77,7 @@ private slots:
     void dpt7_2ByteUnsignedValue();
     void dpt8_2ByteSignedValue();
     void dpt9_2ByteFloat();
+    void dpt9_2ByteFloatExhaustive();
     void dpt10_TimeOfDay();
     void dpt11_Date();
     void dpt12_4ByteUnsignedValue();
@@ -92,6 +96,7 @@ private slots:
     void dpt27_32BitSet();
     void dpt28_StringUtf8();
     void dpt29_ElectricalEnergy();
+    void datapointTypeCodec();
 };
 
 void tst_QKnxDatapointType::datapointType()
@@ -115,6 +120,24 @@ void tst_QKnxDatapointType::datapointType()
     QCOMPARE(type.mainType(), 232);
     QCOMPARE(type.subType(), 600);
     QCOMPARE(type.type(), QKnxDatapointType::Type::DptColourRGB);
+
+    QCOMPARE(QKnxDatapointType::toType("DPT-1"), QKnxDatapointType::Type::Dpt1_1Bit);
+    QCOMPARE(QKnxDatapointType::toType("dpt-10"), QKnxDatapointType::Type::Dpt10_TimeOfDay);
+    QCOMPARE(QKnxDatapointType::toType("DPST-1-1"), QKnxDatapointType::Type::DptSwitch);
+    QCOMPARE(QKnxDatapointType::toType("dpst-232-600"), QKnxDatapointType::Type::DptColourRGB);
+    QCOMPARE(QKnxDatapointType::toType("1.019"), QKnxDatapointType::Type::DptWindowDoor);
+    QCOMPARE(QKnxDatapointType::toType("10-1"), QKnxDatapointType::Type::DptTimeOfDay);
+    QCOMPARE(QKnxDatapointType::toType("00001.00001"), QKnxDatapointType::Type::DptSwitch);
+
+    QCOMPARE(QKnxDatapointType::toType(""), QKnxDatapointType::Type::Unknown);
+    QCOMPARE(QKnxDatapointType::toType("DPT-"), QKnxDatapointType::Type::Unknown);
+    QCOMPARE(QKnxDatapointType::toType("DPT-1-1"), QKnxDatapointType::Type::Unknown);
+    QCOMPARE(QKnxDatapointType::toType("DPST-1"), QKnxDatapointType::Type::Unknown);
+    QCOMPARE(QKnxDatapointType::toType("DPST-1-"), QKnxDatapointType::Type::Unknown);
+    QCOMPARE(QKnxDatapointType::toType("DPST-1-1 "), QKnxDatapointType::Type::Unknown);
+    QCOMPARE(QKnxDatapointType::toType("1:1"), QKnxDatapointType::Type::Unknown);
+    QCOMPARE(QKnxDatapointType::toType("DPT-123456"), QKnxDatapointType::Type::Unknown);
+    QCOMPARE(QKnxDatapointType::toType("1.123456"), QKnxDatapointType::Type::Unknown);
 }
 
 void tst_QKnxDatapointType::dpt1_1Bit()
@@ -183,6 +206,30 @@ void tst_QKnxDatapointType::dpt1_1Bit()
     dpt.reset(factory.createType(QKnxDatapointType::Type::Dpt1_1Bit));
     QCOMPARE(dpt->type(), QKnxDatapointType::Type::Dpt1_1Bit);
 
+    dpt.reset(factory.createType(QKnxDatapointType::Type::DptWindowDoor));
+    QCOMPARE(dpt->type(), QKnxDatapointType::Type::DptWindowDoor);
+    QCOMPARE(factory.createType(QKnxDatapointType::Type::Unknown), nullptr);
+    dpt.reset(factory.createType(1, 999)); // falls back to the base type
+    QCOMPARE(dpt->type(), QKnxDatapointType::Type::Dpt1_1Bit);
+    QCOMPARE(factory.createType(65000, 1), nullptr);
+
+    // numbers outside the 16 bit range must not alias a registered type
+    QCOMPARE(factory.containsSubType(0x10001, 1), false);
+    QCOMPARE(factory.containsSubType(1, 0x10001), false);
+    QCOMPARE(factory.createType(0x10001, 1), nullptr);
+    QVERIFY(factory.subTypes(0x10001).isEmpty());
+
+    alignas(QKnxDatapointType) char storage[sizeof(QKnxDatapointType)];
+    auto inPlace = factory.createType(QKnxDatapointType::Type::DptSwitch, storage,
+        sizeof(storage));
+    QVERIFY(inPlace != nullptr);
+    QCOMPARE(static_cast<void *>(inPlace), static_cast<void *>(storage));
+    QCOMPARE(inPlace->type(), QKnxDatapointType::Type::DptSwitch);
+    QVERIFY(dynamic_cast<QKnxSwitch *> (inPlace) != nullptr);
+    inPlace->~QKnxDatapointType();
+
+    QCOMPARE(factory.createType(QKnxDatapointType::Type::DptSwitch, storage, 1), nullptr);
+
     QKnxWindowDoor dptWindowDoor;
     QCOMPARE(dptWindowDoor.size(), 1);
     QCOMPARE(dptWindowDoor.mainType(), 1);
@@ -565,6 +612,56 @@ void tst_QKnxDatapointType::dpt9_2ByteFloat()
     // TODO: Extend the auto-test.
 }
 
+void tst_QKnxDatapointType::dpt9_2ByteFloatExhaustive()
+{
+    QVector<quint8> raw(2 * 0x10000);
+    for (int i = 0; i < 0x10000; ++i) {
+        raw[2 * i] = quint8(i >> 8);
+        raw[2 * i + 1] = quint8(i);
+    }
+    QVector<float> values(0x10000);
+    QKnxDatapointTypeCodec::Dpt9::decode(raw.constData(), values.size(), values.data());
+
+    QKnx2ByteFloat dpt;
+    QVector<quint8> encoded(raw.size());
+    QVERIFY(QKnxDatapointTypeCodec::Dpt9::encode(values.constData(), values.size(),
+        encoded.data()));
+    for (int i = 0; i < 0x10000; ++i) {
+        const float value = values[i];
+
+        // the decoded value is the float nearest to 0.01 * M * 2^E
+        const qint32 mantissa = qint32(i & 0x07ff) - ((i & 0x8000) ? 2048 : 0);
+        const double exact = double(mantissa * (1 << ((i >> 11) & 0x0f))) / 100.;
+        QVERIFY(qAbs(exact - value) <= qAbs(exact - std::nextafter(value, 1e9f)));
+        QVERIFY(qAbs(exact - value) <= qAbs(exact - std::nextafter(value, -1e9f)));
+
+        // every value encodes to an equal one, through both the codec and the datapoint type
+        float decoded;
+        QKnxDatapointTypeCodec::Dpt9::decode(encoded.constData() + 2 * i, 1, &decoded);
+        QCOMPARE(qFloatDistance(decoded, value), quint32(0));
+
+        QVERIFY(dpt.setValue(value));
+        QCOMPARE(qFloatDistance(dpt.value(), value), quint32(0));
+        QCOMPARE(dpt.bytes<QVector<quint8>>(), encoded.mid(2 * i, 2));
+    }
+
+    // values exactly between two mantissas round away from zero, at the exponent boundaries
+    // the smallest exponent that fits is used
+    const auto encode = [](float value) {
+        quint8 raw[2];
+        QKnxDatapointTypeCodec::Dpt9::encode(&value, 1, raw);
+        return quint16(raw[0] << 8 | raw[1]);
+    };
+    QCOMPARE(encode(20.47f), quint16(0x07ff));
+    QCOMPARE(encode(20.48f), quint16(0x0c00));
+    QCOMPARE(encode(-20.48f), quint16(0x8000));
+    QCOMPARE(encode(20.75f), quint16(0x0c0e)); // 1037.5 * 2^1
+    QCOMPARE(encode(-20.75f), quint16(0x8bf2));
+    QCOMPARE(encode(-0.25f), quint16(0x87e7));
+    QCOMPARE(encode(0.f), quint16(0x0000));
+    QCOMPARE(encode(-0.f), quint16(0x0000));
+}
+
 void tst_QKnxDatapointType::dpt10_TimeOfDay()
 {
     QKnxTime time;
@@ -2091,6 +2188,91 @@ void tst_QKnxDatapointType::dpt29_ElectricalEnergy()
     QCOMPARE(dpt2.value(), qint64(2147483647));
 }
 
+void tst_QKnxDatapointType::datapointTypeCodec()
+{
+    // the counts are chosen so that both the vectorized and the remaining values are covered
+
+    const QByteArray dpt5 = QByteArray::fromHex("00017f80feff0a");
+    QVector<double> scaled(dpt5.size());
+    QKnxDatapointTypeCodec::Dpt5::decode(reinterpret_cast<const quint8 *>(dpt5.constData()),
+        dpt5.size(), scaled.data(), 100. / 255);
+    QKnxScaling scaling;
+    for (int i = 0; i < dpt5.size(); ++i) {
+        QVERIFY(scaling.setBytes(dpt5.mid(i, 1), 0, 1));
+        QCOMPARE(scaled[i], scaling.value());
+    }
+    QByteArray raw(dpt5.size(), 0);
+    QKnxDatapointTypeCodec::Dpt5::encode(scaled.constData(), scaled.size(),
+        reinterpret_cast<quint8 *>(raw.data()), 100. / 255);
+    QCOMPARE(raw, dpt5);
+
+    // out of range values are clamped instead of wrapping around
+    const QVector<double> outOfRange({ -1., -100., 100.5, 101., 1000., 256. * 100. / 255 });
+    raw.fill(0x55, outOfRange.size());
+    QKnxDatapointTypeCodec::Dpt5::encode(outOfRange.constData(), outOfRange.size(),
+        reinterpret_cast<quint8 *>(raw.data()), 100. / 255);
+    QCOMPARE(raw, QByteArray::fromHex("0000ffffffff"));
+
+    const QByteArray dpt7 = QByteArray::fromHex("000000010100ff00fffe1234abcd8000ffff5555");
+    QVector<quint16> unsigned16(dpt7.size() / 2);
+    QKnxDatapointTypeCodec::Dpt7::decode(reinterpret_cast<const quint8 *>(dpt7.constData()),
+        unsigned16.size(), unsigned16.data());
+    QCOMPARE(unsigned16, QVector<quint16>({ 0x0000, 0x0001, 0x0100, 0xff00, 0xfffe, 0x1234,
+        0xabcd, 0x8000, 0xffff, 0x5555 }));
+    raw.fill(0, dpt7.size());
+    QKnxDatapointTypeCodec::Dpt7::encode(unsigned16.constData(), unsigned16.size(),
+        reinterpret_cast<quint8 *>(raw.data()));
+    QCOMPARE(raw, dpt7);
+
+    QVector<quint8> dpt9(2 * 0x10001);
+    for (int i = 0; i < 0x10001; ++i) {
+        dpt9[2 * i] = quint8(i >> 8);
+        dpt9[2 * i + 1] = quint8(i);
+    }
+    QVector<float> floats(dpt9.size() / 2);
+    QKnxDatapointTypeCodec::Dpt9::decode(dpt9.constData(), floats.size(), floats.data());
+    QKnx2ByteFloat twoByteFloat;
+    for (int i = 0; i < floats.size(); i += 97) {
+        QVERIFY(twoByteFloat.setBytes(dpt9.mid(2 * i, 2), 0, 2));
+        QCOMPARE(floats[i], twoByteFloat.value());
+    }
+    QCOMPARE(floats[0x0000], 0.f);
+    QCOMPARE(floats[0x0c1a], 21.f);
+    QCOMPARE(floats[0x8a24], -30.f);
+
+    const QVector<float> values16 = { 0.f, 21.5f, -30.f, 670433.28f, -671088.64f, 1e9f, 0.01f };
+    raw.fill(0, 2 * values16.size());
+    QCOMPARE(QKnxDatapointTypeCodec::Dpt9::encode(values16.constData(), values16.size(),
+        reinterpret_cast<quint8 *>(raw.data())), false); // 1e9 is out of range
+    QCOMPARE(raw, QByteArray::fromHex("00000c338a247ffef8007fff0001"));
+
+    const QByteArray dpt12 = QByteArray::fromHex("0000000100000100ffffffff12345678deadbeef");
+    QVector<quint32> unsigned32(dpt12.size() / 4);
+    QKnxDatapointTypeCodec::Dpt12::decode(reinterpret_cast<const quint8 *>(dpt12.constData()),
+        unsigned32.size(), unsigned32.data());
+    QCOMPARE(unsigned32, QVector<quint32>({ 0x00000001, 0x00000100, 0xffffffff, 0x12345678,
+        0xdeadbeef }));
+    raw.fill(0, dpt12.size());
+    QKnxDatapointTypeCodec::Dpt12::encode(unsigned32.constData(), unsigned32.size(),
+        reinterpret_cast<quint8 *>(raw.data()));
+    QCOMPARE(raw, dpt12);
+
+    QVector<qint32> signed32(dpt12.size() / 4);
+    QKnxDatapointTypeCodec::Dpt13::decode(reinterpret_cast<const quint8 *>(dpt12.constData()),
+        signed32.size(), signed32.data());
+    QCOMPARE(signed32, QVector<qint32>({ 1, 256, -1, 0x12345678, qint32(0xdeadbeef) }));
+
+    const QVector<float> values32 = { 0.f, 1.f, -1.5f, 3.4e38f, 1e-38f };
+    raw.fill(0, 4 * values32.size());
+    QKnxDatapointTypeCodec::Dpt14::encode(values32.constData(), values32.size(),
+        reinterpret_cast<quint8 *>(raw.data()));
+    QCOMPARE(raw.left(12), QByteArray::fromHex("000000003f800000bfc00000"));
+    QVector<float> floats32(values32.size());
+    QKnxDatapointTypeCodec::Dpt14::decode(reinterpret_cast<const quint8 *>(raw.constData()),
+        floats32.size(), floats32.data());
+    QCOMPARE(floats32, values32);
+}
+
 QTEST_MAIN(tst_QKnxDatapointType)
 
 #include "tst_qknxdatapointtype.moc"
@@ -28,8 +28,12 @@
 ******************************************************************************/
 
 #include <QtCore/qdebug.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtCore/qtemporaryfile.h>
 #include <QtKnx/qknxgroupaddressinfos.h>
 #include <QtKnx/qknxgroupaddressinfo.h>
+#include <QtKnx/private/qzipwriter_p.h>
 #include <QtTest/qtest.h>
 
 static QString s_msg;
@@ -46,6 +50,9 @@ private slots:
     void groupAddressInfo();
     void groupAddressInfosFromXml();
     void groupAddressInfosFromZip();
+    void groupAddressInfosSkipsUnrelatedElements();
+    void groupAddressInfosFromMultiPartZip();
+    void groupAddressInfosCache();
 
 private:
     QVector<QKnxGroupAddressInfo> initGroupAddressInfos(const QString &install = {});
@@ -342,6 +349,205 @@ void tst_QKnxGroupAddressInfos::groupAddressInfosFromZip()
     QCOMPARE(infos.infoCount(QString("P-03D9"), ""), 0);
 }
 
+void tst_QKnxGroupAddressInfos::groupAddressInfosSkipsUnrelatedElements()
+{
+    const auto projectXml = [](const QByteArray &address) {
+        return QByteArray("<?xml version=\"1.0\" encoding=\"utf-8\"?>"
+            "<KNX xmlns=\"http://knx.org/xml/project/13\">"
+            "<Project Id=\"P-0001\"><Installations><Installation Name=\"Home\">"
+            "<Topology><Area Id=\"P-0001-0_A-1\" Address=\"1\" Name=\"Area\" Puid=\"1\">"
+            "<Line Id=\"P-0001-0_L-1\" Address=\"1\" Name=\"Line\" Puid=\"2\">"
+            "<DeviceInstance Id=\"P-0001-0_DI-1\" Puid=\"3\"><ComObjectInstanceRefs/>"
+            "</DeviceInstance></Line></Area></Topology>"
+            "<Buildings><BuildingPart Id=\"P-0001-0_BP-1\" Name=\"House\" Puid=\"4\"/>"
+            "</Buildings>"
+            "<GroupAddresses><GroupRanges>"
+            "<GroupRange Id=\"P-0001-0_GR-1\" RangeStart=\"2048\" RangeEnd=\"4095\" "
+                "Name=\"Lights\" Puid=\"5\">"
+            "<GroupAddress Id=\"P-0001-0_GA-1\" Address=\"2048\" Name=\"Hall\" "
+                "DatapointType=\"DPST-1-1\" Puid=\"6\"/>"
+            "<GroupRange Id=\"P-0001-0_GR-2\" RangeStart=\"2304\" RangeEnd=\"2559\" "
+                "Name=\"Dimming\" Puid=\"7\">")
+            + address
+            + QByteArray("</GroupRange></GroupRange></GroupRanges></GroupAddresses>"
+            "</Installation></Installations></Project></KNX>");
+    };
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.write(projectXml("<GroupAddress Id=\"P-0001-0_GA-2\" Address=\"2305\" "
+        "Name=\"Kitchen\" Description=\"Dimmer\" DatapointType=\"DPST-3-7\" Puid=\"8\"/>"));
+    file.close();
+
+    QKnxGroupAddressInfos infos(file.fileName());
+    QCOMPARE(infos.parse(), true);
+    QCOMPARE(infos.status(), QKnxGroupAddressInfos::Status::NoError);
+    QCOMPARE(infos.projectIds(), QVector<QString>({ QString("P-0001") }));
+    QCOMPARE(infos.installations(QString("P-0001")), QVector<QString>({ QString("Home") }));
+
+    const auto entries = infos.addressInfos(QString("P-0001"), QString("Home"));
+    QCOMPARE(entries.size(), 2);
+    QCOMPARE(entries.at(0).name(), QString("Kitchen")); // nested range first
+    QCOMPARE(entries.at(0).address(), QKnxAddress(QKnxAddress::Type::Group, 2305));
+    QCOMPARE(entries.at(0).description(), QString("Dimmer"));
+    QCOMPARE(entries.at(1).name(), QString("Hall"));
+    QCOMPARE(entries.at(1).address(), QKnxAddress(QKnxAddress::Type::Group, 2048));
+
+    QTemporaryFile broken;
+    QVERIFY(broken.open());
+    broken.write(projectXml("<GroupAddress Id=\"P-0001-0_GA-2\" Name=\"Kitchen\" "
+        "Puid=\"8\"/>")); // missing required Address attribute
+    broken.close();
+
+    infos.setProjectFile(broken.fileName());
+    QCOMPARE(infos.parse(), false);
+    QCOMPARE(infos.status(), QKnxGroupAddressInfos::Status::ParseError);
+    QCOMPARE(infos.projectIds(), QVector<QString>());
+}
+
+static QByteArray projectPart(const QByteArray &id, int address)
+{
+    return QByteArray("<?xml version=\"1.0\" encoding=\"utf-8\"?>"
+        "<KNX xmlns=\"http://knx.org/xml/project/13\"><Project Id=\"") + id
+        + QByteArray("\"><Installations><Installation Name=\"\"><GroupAddresses><GroupRanges>"
+        "<GroupRange Id=\"") + id + QByteArray("-0_GR-1\" RangeStart=\"0\" RangeEnd=\"65535\" "
+        "Name=\"All\" Puid=\"1\"><GroupAddress Id=\"") + id + QByteArray("-0_GA-1\" Address=\"")
+        + QByteArray::number(address) + QByteArray("\" Name=\"") + id + QByteArray("\" "
+        "DatapointType=\"DPST-1-1\" Puid=\"2\"/></GroupRange></GroupRanges></GroupAddresses>"
+        "</Installation></Installations></Project></KNX>");
+}
+
+static QByteArray projectNames(const QByteArray &id, const QByteArray &name)
+{
+    return QByteArray("<?xml version=\"1.0\" encoding=\"utf-8\"?>"
+        "<KNX xmlns=\"http://knx.org/xml/project/13\"><Project Id=\"") + id
+        + QByteArray("\"><ProjectInformation Name=\"") + name
+        + QByteArray("\"/></Project></KNX>");
+}
+
+void tst_QKnxGroupAddressInfos::groupAddressInfosFromMultiPartZip()
+{
+    const QVector<QByteArray> ids = { "P-0001", "P-0002", "P-0003", "P-0004", "P-0005" };
+
+    QTemporaryFile archive;
+    QVERIFY(archive.open());
+    {
+        QZipWriter writer(&archive);
+        for (int i = ids.size() - 1; i >= 0; --i) {
+            const auto dir = QString::fromLatin1(ids.at(i));
+            writer.addFile(dir + QStringLiteral("/0.xml"), projectPart(ids.at(i), i + 1));
+            writer.addFile(dir + QStringLiteral("/project.xml"),
+                projectNames(ids.at(i), "Name " + ids.at(i)));
+        }
+        writer.close();
+    }
+    archive.close();
+
+    QKnxGroupAddressInfos infos(archive.fileName());
+    QCOMPARE(infos.parse(), true);
+    QCOMPARE(infos.status(), QKnxGroupAddressInfos::Status::NoError);
+    QCOMPARE(infos.projectIds().size(), ids.size());
+
+    for (int i = 0; i < ids.size(); ++i) {
+        const auto id = QString::fromLatin1(ids.at(i));
+        QCOMPARE(infos.projectName(id), QStringLiteral("Name ") + id);
+
+        const auto entries = infos.addressInfos(id, QString());
+        QCOMPARE(entries.size(), 1);
+        QCOMPARE(entries.first().name(), id);
+        QCOMPARE(entries.first().address(), QKnxAddress(QKnxAddress::Type::Group, i + 1));
+    }
+
+    QTemporaryFile duplicate;
+    QVERIFY(duplicate.open());
+    {
+        QZipWriter writer(&duplicate);
+        writer.addFile(QStringLiteral("P-0001/0.xml"), projectPart("P-0001", 1));
+        writer.addFile(QStringLiteral("P-0002/0.xml"), projectPart("P-0001", 2));
+        writer.close();
+    }
+    duplicate.close();
+
+    infos.setProjectFile(duplicate.fileName());
+    QCOMPARE(infos.parse(), false);
+    QCOMPARE(infos.status(), QKnxGroupAddressInfos::Status::ProjectError);
+    QCOMPARE(infos.errorString(), QString("Project 'P-0001' exists more then once."));
+    QCOMPARE(infos.projectIds(), QVector<QString>());
+
+    QTemporaryFile broken;
+    QVERIFY(broken.open());
+    {
+        QZipWriter writer(&broken);
+        writer.addFile(QStringLiteral("P-0001/0.xml"), projectPart("P-0001", 1));
+        writer.addFile(QStringLiteral("P-0002/0.xml"), QByteArray("<KNX><Project Id="));
+        writer.close();
+    }
+    broken.close();
+
+    infos.setProjectFile(broken.fileName());
+    QCOMPARE(infos.parse(), false);
+    QCOMPARE(infos.status(), QKnxGroupAddressInfos::Status::ParseError);
+    QCOMPARE(infos.projectIds(), QVector<QString>()); // the first, valid part is dropped too
+}
+
+void tst_QKnxGroupAddressInfos::groupAddressInfosCache()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const auto projectFile = dir.filePath(QStringLiteral("project.knxproj"));
+    const auto cacheFile = dir.filePath(QStringLiteral("project.cache"));
+    QVERIFY(QFile::copy(QStringLiteral(":/data/qt.io.knxproj"), projectFile));
+    QVERIFY(QFile::setPermissions(projectFile, QFile::ReadOwner | QFile::WriteOwner));
+
+    QKnxGroupAddressInfos parsed(projectFile);
+    QCOMPARE(parsed.cacheFile(), QString());
+    parsed.setCacheFile(cacheFile);
+    QCOMPARE(parsed.cacheFile(), cacheFile);
+    QCOMPARE(parsed.parse(), true);
+    QVERIFY(QFile::exists(cacheFile));
+
+    // a second instance loads the cache written by the first one
+    QKnxGroupAddressInfos cached(projectFile);
+    cached.setCacheFile(cacheFile);
+    QCOMPARE(cached.parse(), true);
+    QCOMPARE(cached.status(), QKnxGroupAddressInfos::Status::NoError);
+    QCOMPARE(cached.projectIds(), parsed.projectIds());
+    QCOMPARE(cached.projectName(QString("P-03D9")), QString("qt.io.test"));
+    QCOMPARE(cached.installations(QString("P-03D9")), parsed.installations(QString("P-03D9")));
+    QCOMPARE(cached.addressInfos(QString("P-03D9")).size(), 95);
+    QVERIFY(cached.addressInfos(QString("P-03D9")) == parsed.addressInfos(QString("P-03D9")));
+    QVERIFY(cached == parsed);
+
+    // a corrupt cache falls back to parsing and gets replaced
+    {
+        QFile file(cacheFile);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write("QKGC broken");
+    }
+    QCOMPARE(cached.parse(), true);
+    QVERIFY(cached == parsed);
+    QVERIFY(QFileInfo(cacheFile).size() > 64);
+
+    // a changed project file invalidates the cache
+    {
+        QFile source(QStringLiteral(":/data/0.xml"));
+        QVERIFY(source.open(QIODevice::ReadOnly));
+        QFile file(projectFile);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(source.readAll());
+    }
+    QCOMPARE(cached.parse(), true);
+    QCOMPARE(cached.projectIds().size(), 2);
+    QCOMPARE(cached.infoCount(QString("P-03D8"), QString("First")), 95);
+    QCOMPARE(cached.installations(QString("P-03D9")).size(), 2);
+
+    QKnxGroupAddressInfos reparsed(projectFile);
+    QCOMPARE(reparsed.parse(), true);
+    reparsed.setCacheFile(cacheFile);
+    QVERIFY(cached == reparsed);
+}
+
 QTEST_MAIN(tst_QKnxGroupAddressInfos)
 
 #include "tst_qknxgroupaddressinfo.moc"
@@ -0,0 +1,109 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+#include <QtKnx/qknxgroupaddressset.h>
+#include <QtTest/qtest.h>
+
+class tst_QKnxGroupAddressSet : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testDefaultConstructor()
+    {
+        QKnxGroupAddressSet set;
+        QCOMPARE(set.isEmpty(), true);
+        QCOMPARE(set.size(), 0);
+        QCOMPARE(set.contains(QKnxAddress::Group::Broadcast), false);
+        QCOMPARE(set.contains(QKnxAddress()), false);
+        QCOMPARE(set.toVector(), QVector<QKnxAddress>());
+    }
+
+    void testInsertRemove()
+    {
+        const QKnxAddress group = QKnxAddress::createGroup(1, 2, 3);
+        const QKnxAddress individual = QKnxAddress::createIndividual(1, 2, 3);
+
+        QKnxGroupAddressSet set;
+        QCOMPARE(set.insert(group), true);
+        QCOMPARE(set.insert(group), false);
+        QCOMPARE(set.insert(individual), false);
+        QCOMPARE(set.insert(QKnxAddress()), false);
+        QCOMPARE(set.size(), 1);
+
+        QCOMPARE(set.contains(group), true);
+        QCOMPARE(set.contains(individual), false);
+        QCOMPARE(set.contains(QKnxAddress::createGroup(1, 2, 4)), false);
+
+        QCOMPARE(set.remove(individual), false);
+        QCOMPARE(set.remove(group), true);
+        QCOMPARE(set.remove(group), false);
+        QCOMPARE(set.contains(group), false);
+        QCOMPARE(set.isEmpty(), true);
+    }
+
+    void testWholeAddressSpace()
+    {
+        QKnxGroupAddressSet set;
+        for (int i = 0; i <= 0xffff; i += 3)
+            QCOMPARE(set.insert({ QKnxAddress::Type::Group, quint16(i) }), true);
+        QCOMPARE(set.size(), 0x10000 / 3 + 1);
+
+        for (int i = 0; i <= 0xffff; ++i) {
+            QCOMPARE(set.contains({ QKnxAddress::Type::Group, quint16(i) }), i % 3 == 0);
+            QCOMPARE(set.contains({ QKnxAddress::Type::Individual, quint16(i) }), false);
+        }
+
+        const auto addresses = set.toVector();
+        QCOMPARE(addresses.size(), set.size());
+        QCOMPARE(addresses.first(), QKnxAddress::Group::Broadcast);
+        QCOMPARE(addresses.last(), QKnxAddress(QKnxAddress::Type::Group, 0xffff));
+        QCOMPARE(QKnxGroupAddressSet(addresses), set);
+
+        set.clear();
+        QCOMPARE(set.isEmpty(), true);
+        QCOMPARE(set.contains(QKnxAddress::Group::Broadcast), false);
+    }
+
+    void testComparison()
+    {
+        QKnxGroupAddressSet set { QKnxAddress::createGroup(1, 1), QKnxAddress::createGroup(2, 2) };
+        QKnxGroupAddressSet copy = set;
+        QCOMPARE(copy == set, true);
+
+        copy.remove(QKnxAddress::createGroup(2, 2));
+        QCOMPARE(copy != set, true);
+        QCOMPARE(set.size(), 2);
+
+        copy.remove(QKnxAddress::createGroup(1, 1));
+        QCOMPARE(copy == QKnxGroupAddressSet(), true);
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_QKnxGroupAddressSet)
+
+#include "tst_qknxgroupaddressset.moc"
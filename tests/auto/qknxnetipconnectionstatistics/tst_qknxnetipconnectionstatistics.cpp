@@ -0,0 +1,140 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+#include <QtCore/qthread.h>
+#include <QtKnx/qknxnetipconnectionstatistics.h>
+#include <QtKnx/private/qknxnetipconnectionstatistics_p.h>
+#include <QtTest/qtest.h>
+
+class tst_QKnxNetIpConnectionStatistics : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testEmpty()
+    {
+        QKnxNetIpConnectionStatistics statistics;
+        QCOMPARE(statistics.framesSent(), quint64(0));
+        QCOMPARE(statistics.framesReceived(), quint64(0));
+        QCOMPARE(statistics.retransmissions(), quint64(0));
+
+        const auto histogram = QKnxNetIpLatencyRecorder().snapshot();
+        QVERIFY(histogram.isEmpty());
+        QCOMPARE(histogram.minimum(), qint64(0));
+        QCOMPARE(histogram.maximum(), qint64(0));
+        QCOMPARE(histogram.mean(), qint64(0));
+        QCOMPARE(histogram.percentile(99.0), qint64(0));
+        QCOMPARE(histogram.buckets().size(), QKnxNetIpLatencyHistogram::bucketCount());
+    }
+
+    void testBuckets()
+    {
+        // buckets are contiguous and every value maps into its own bucket
+        QCOMPARE(QKnxNetIpLatencyHistogram::bucketLowerBound(0), qint64(0));
+        for (int i = 1; i < QKnxNetIpLatencyHistogram::bucketCount(); ++i) {
+            QCOMPARE(QKnxNetIpLatencyHistogram::bucketLowerBound(i),
+                QKnxNetIpLatencyHistogram::bucketUpperBound(i - 1) + 1);
+        }
+        QCOMPARE(QKnxNetIpLatencyHistogram::bucketUpperBound(
+            QKnxNetIpLatencyHistogram::bucketCount() - 1), qint64(0xffffffff));
+
+        for (qint64 value : { 0, 1, 7, 8, 9, 15, 16, 17, 1000, 123456, 4000000 }) {
+            const int index = QKnxNetIpLatencyHistogram::bucketIndex(value);
+            QVERIFY(QKnxNetIpLatencyHistogram::bucketLowerBound(index) <= value);
+            QVERIFY(QKnxNetIpLatencyHistogram::bucketUpperBound(index) >= value);
+
+            // the relative width of a bucket stays within 12.5 percent
+            const qint64 width = QKnxNetIpLatencyHistogram::bucketUpperBound(index)
+                - QKnxNetIpLatencyHistogram::bucketLowerBound(index) + 1;
+            QVERIFY(width * 8 <= qMax(qint64(8), value));
+        }
+
+        QCOMPARE(QKnxNetIpLatencyHistogram::bucketIndex(-5), 0);
+        QCOMPARE(QKnxNetIpLatencyHistogram::bucketIndex(Q_INT64_C(1) << 40),
+            QKnxNetIpLatencyHistogram::bucketCount() - 1);
+    }
+
+    void testRecord()
+    {
+        QKnxNetIpLatencyRecorder recorder;
+        for (int i = 1; i <= 100; ++i)
+            recorder.record(i * 100);
+
+        const auto histogram = recorder.snapshot();
+        QCOMPARE(histogram.count(), quint64(100));
+        QCOMPARE(histogram.minimum(), qint64(100));
+        QCOMPARE(histogram.maximum(), qint64(10000));
+        QCOMPARE(histogram.mean(), qint64(5050));
+
+        auto near = [](qint64 value, qint64 expected) {
+            return value >= expected && value <= expected + expected / 8;
+        };
+        QVERIFY(near(histogram.percentile(50.0), 5000));
+        QVERIFY(near(histogram.percentile(90.0), 9000));
+        QCOMPARE(histogram.percentile(100.0), qint64(10000));
+        QCOMPARE(histogram.percentile(0.0), qint64(100));
+    }
+
+    void testConcurrentRead()
+    {
+        QKnxNetIpConnectionStatisticsRecorder recorder;
+
+        // the reader only sees growing counters while the recorder keeps writing
+        QAtomicInt done { 0 };
+        QAtomicInt consistent { 1 };
+        QThread reader;
+        connect(&reader, &QThread::started, [&]() {
+            quint64 last = 0;
+            while (!done.loadAcquire()) {
+                const auto statistics = recorder.snapshot();
+                if (statistics.framesSent() < last)
+                    consistent.storeRelease(0);
+                last = statistics.framesSent();
+            }
+            reader.quit();
+        });
+        reader.start();
+
+        for (int i = 0; i < 100000; ++i) {
+            recorder.frameSent(i % 10 == 0);
+            recorder.acknowledgeLatency.record(i % 1000);
+        }
+        done.storeRelease(1);
+        QVERIFY(reader.wait(5000));
+        QCOMPARE(consistent.loadAcquire(), 1);
+
+        const auto statistics = recorder.snapshot();
+        QCOMPARE(statistics.framesSent(), quint64(100000));
+        QCOMPARE(statistics.retransmissions(), quint64(10000));
+        QCOMPARE(statistics.acknowledgeLatency().count(), quint64(100000));
+        QCOMPARE(statistics.acknowledgeLatency().maximum(), qint64(999));
+    }
+};
+
+QTEST_MAIN(tst_QKnxNetIpConnectionStatistics)
+
+#include "tst_qknxnetipconnectionstatistics.moc"
@@ -0,0 +1,162 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#include <QtCore/qdebug.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtKnx/qknxlinklayerframe.h>
+#include <QtKnx/qknxnetiprouter.h>
+#include <QtNetwork/qudpsocket.h>
+#include <QtTest/qsignalspy.h>
+#include <QtTest/qtest.h>
+
+#include "qknxnetipmockserver.h"
+
+class tst_QKnxNetIpRouter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testDefaultConstructor()
+    {
+        QKnxNetIpRouter router;
+        QCOMPARE(router.state(), QKnxNetIpRouter::State::NotRunning);
+        QCOMPARE(router.error(), QKnxNetIpRouter::Error::None);
+        QCOMPARE(router.multicastAddress(), QHostAddress(QStringLiteral("224.0.23.12")));
+        QCOMPARE(router.multicastPort(), quint16(3671));
+        QCOMPARE(router.maximumSendRate(), 50);
+        QCOMPARE(router.sendQueueSize(), 0);
+        QCOMPARE(router.maximumSendQueueSize(), 256);
+        router.setMaximumSendQueueSize(0);
+        QCOMPARE(router.maximumSendQueueSize(), 256);
+        QCOMPARE(router.droppedFrameCount(), quint32(0));
+        QCOMPARE(router.lostMessageCount(), quint32(0));
+        QCOMPARE(router.sendRoutingIndication(createFrame(0)), false);
+    }
+
+    void testNotIPv4()
+    {
+        QKnxNetIpRouter router(QHostAddress::LocalHostIPv6);
+        QSignalSpy spy(&router, &QKnxNetIpRouter::errorOccurred);
+        router.start();
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(router.error(), QKnxNetIpRouter::Error::NotIPv4);
+        QCOMPARE(router.state(), QKnxNetIpRouter::State::NotRunning);
+    }
+
+    void testMulticastLoopback()
+    {
+        QKnxNetIpRouter sender, receiver;
+        if (!startRouter(&sender) || !startRouter(&receiver))
+            QSKIP("Could not join the multicast group, skipping test.");
+
+        QVector<QKnxLinkLayerFrame> received;
+        connect(&receiver, &QKnxNetIpRouter::receivedRoutingIndication,
+            [&received](const QKnxLinkLayerFrame &frame) { received.append(frame); });
+
+        // 10 frames at 50 telegrams per second need at least 9 * 20 ms
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < 10; ++i)
+            QVERIFY(sender.sendRoutingIndication(createFrame(quint8(i))));
+        QVERIFY(sender.sendQueueSize() > 0);
+
+        QTRY_COMPARE_WITH_TIMEOUT(received.count(), 10, 5000);
+        QVERIFY(timer.elapsed() >= 9 * 20);
+        QCOMPARE(sender.sendQueueSize(), 0);
+
+        for (int i = 0; i < received.count(); ++i)
+            QCOMPARE(received.at(i).bytes(), createFrame(quint8(i)).bytes());
+    }
+
+    void testSendQueueOverflow()
+    {
+        QKnxNetIpRouter router;
+        if (!startRouter(&router))
+            QSKIP("Could not join the multicast group, skipping test.");
+
+        QSignalSpy dropped(&router, &QKnxNetIpRouter::frameDropped);
+        router.setMaximumSendQueueSize(2);
+        router.setMaximumSendRate(1);
+
+        // frames leave the queue from the event loop only, so the third one overflows it
+        QVERIFY(router.sendRoutingIndication(createFrame(0)));
+        QVERIFY(router.sendRoutingIndication(createFrame(1)));
+        QVERIFY(!router.sendRoutingIndication(createFrame(2)));
+        QCOMPARE(router.sendQueueSize(), 2);
+        QCOMPARE(dropped.count(), 1);
+        QCOMPARE(router.droppedFrameCount(), quint32(1));
+
+        router.stop();
+        QCOMPARE(router.sendQueueSize(), 0);
+        QCOMPARE(dropped.count(), 3);
+        QCOMPARE(router.droppedFrameCount(), quint32(3));
+    }
+
+    void testRoutingBusyAndLostMessage()
+    {
+        QKnxNetIpRouter router;
+        if (!startRouter(&router))
+            QSKIP("Could not join the multicast group, skipping test.");
+
+        QVector<int> busy, lost;
+        connect(&router, &QKnxNetIpRouter::routingBusyReceived,
+            [&busy](QKnxNetIp::DeviceState, int waitTime) { busy.append(waitTime); });
+        connect(&router, &QKnxNetIpRouter::lostMessageReceived,
+            [&lost](QKnxNetIp::DeviceState, int count) { lost.append(count); });
+
+        QUdpSocket socket;
+        socket.setSocketOption(QUdpSocket::MulticastLoopbackOption, 1);
+        socket.writeDatagram(QByteArray::fromHex("06100532000c060000640000"),
+            router.multicastAddress(), router.multicastPort());
+        socket.writeDatagram(QByteArray::fromHex("06100531000a04000005"),
+            router.multicastAddress(), router.multicastPort());
+
+        QTRY_COMPARE_WITH_TIMEOUT(busy.count(), 1, 5000);
+        QCOMPARE(busy.first(), 100);
+
+        QTRY_COMPARE_WITH_TIMEOUT(lost.count(), 1, 5000);
+        QCOMPARE(lost.first(), 5);
+        QCOMPARE(router.lostMessageCount(), quint32(5));
+    }
+
+private:
+    static bool startRouter(QKnxNetIpRouter *router)
+    {
+        router->setMulticastPort(36710);
+        router->setMulticastLoopback(true);
+
+        QSignalSpy spy(router, &QKnxNetIpRouter::stateChanged);
+        router->start();
+        while (router->state() == QKnxNetIpRouter::State::Starting && spy.wait(1000)) {}
+        return router->state() == QKnxNetIpRouter::State::Running;
+    }
+};
+
+QTEST_MAIN(tst_QKnxNetIpRouter)
+
+#include "tst_qknxnetiprouter.moc"
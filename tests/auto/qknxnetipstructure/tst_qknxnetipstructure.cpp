@@ -277,6 +277,34 @@ private slots:
         QCOMPARE(test.payload().bytes<QByteArray>(), ba);
     }
 
+    void testInlineBufferOverflow()
+    {
+        QKnxNetIpPayload payload;
+        payload.setBytes(QByteArray::fromHex("00112233"));
+
+        payload.resize(8);
+        QCOMPARE(payload.bytes<QByteArray>(), QByteArray::fromHex("0011223300000000"));
+
+        QByteArray ba(60, 0x05);
+        payload.appendBytes(ba);
+        QCOMPARE(payload.size(), quint16(68));
+        QCOMPARE(payload.bytes<QByteArray>(), QByteArray::fromHex("0011223300000000") + ba);
+
+        payload.insertBytes(2, QByteArray::fromHex("aabb"));
+        QCOMPARE(payload.size(), quint16(70));
+        QCOMPARE(payload.bytes<QByteArray>(), QByteArray::fromHex("0011aabb223300000000")
+            + ba);
+
+        payload.resize(300, 0xff);
+        QCOMPARE(payload.size(), quint16(300));
+        QCOMPARE(payload.byte(69), quint8(0x05));
+        QCOMPARE(payload.byte(70), quint8(0xff));
+        QCOMPARE(payload.byte(299), quint8(0xff));
+
+        payload.resize(4);
+        QCOMPARE(payload.bytes<QByteArray>(), QByteArray::fromHex("0011aabb"));
+    }
+
     void testToString()
     {
         TestStructure test;
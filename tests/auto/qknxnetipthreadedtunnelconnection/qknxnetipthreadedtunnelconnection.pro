@@ -0,0 +1,9 @@
+TARGET = tst_qknxnetipthreadedtunnelconnection
+
+QT = core network testlib knx knx-private
+CONFIG += testcase c++11
+
+CONFIG -= app_bundle
+INCLUDEPATH += ../shared
+HEADERS += ../shared/qknxnetipmockserver.h
+SOURCES += tst_qknxnetipthreadedtunnelconnection.cpp
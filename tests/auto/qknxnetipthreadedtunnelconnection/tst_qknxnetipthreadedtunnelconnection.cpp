@@ -0,0 +1,230 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+#include <QtCore/qdebug.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthread.h>
+#include <QtKnx/qknxlinklayerframe.h>
+#include <QtKnx/qknxnetipthreadedtunnelconnection.h>
+#include <QtKnx/private/qknxspscringbuffer_p.h>
+#include <QtTest/qsignalspy.h>
+#include <QtTest/qtest.h>
+
+#include "qknxnetipmockserver.h"
+
+class tst_QKnxNetIpThreadedTunnelConnection : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testRingBuffer()
+    {
+        QKnxSpscRingBuffer<int> ring(5);
+        QCOMPARE(ring.capacity(), 8);
+        QVERIFY(ring.isEmpty());
+
+        for (int i = 0; i < 8; ++i)
+            QVERIFY(ring.push(i));
+        QVERIFY(!ring.push(8));
+        QCOMPARE(ring.size(), 8);
+
+        int value = -1;
+        for (int i = 0; i < 8; ++i) {
+            QVERIFY(ring.pop(&value));
+            QCOMPARE(value, i);
+        }
+        QVERIFY(!ring.pop(&value));
+        QVERIFY(ring.isEmpty());
+    }
+
+    void testRingBufferThreads()
+    {
+        const int count = 100000;
+        QKnxSpscRingBuffer<int> ring(64);
+
+        QScopedPointer<QThread> producer(QThread::create([&ring]() {
+            for (int i = 0; i < count; ++i) {
+                while (!ring.push(i))
+                    QThread::yieldCurrentThread();
+            }
+        }));
+        producer->start();
+
+        int expected = 0, value = -1;
+        while (expected < count) {
+            if (!ring.pop(&value)) {
+                QThread::yieldCurrentThread();
+                continue;
+            }
+            QCOMPARE(value, expected++);
+        }
+        QVERIFY(producer->wait(5000));
+        QVERIFY(ring.isEmpty());
+    }
+
+    void testDefaultConstructor()
+    {
+        QKnxNetIpThreadedTunnelConnection tunnel;
+        QCOMPARE(tunnel.state(), QKnxNetIpEndpointConnection::Disconnected);
+        QCOMPARE(tunnel.natAware(), false);
+        QCOMPARE(tunnel.autoReconnect(), false);
+        QCOMPARE(tunnel.maximumSendQueueSize(), 64);
+        QCOMPARE(tunnel.maximumReconnectAttempts(), 10);
+        QCOMPARE(tunnel.reconnectInterval(), quint32(1000));
+        QCOMPARE(tunnel.maximumReconnectInterval(), quint32(60000));
+        QCOMPARE(tunnel.droppedFrameCount(), quint32(0));
+        QVERIFY(tunnel.queueCapacity() > 0);
+        QCOMPARE(tunnel.sendTunnelFrame(createFrame(0)), false);
+    }
+
+    void testNotIPv4()
+    {
+        QKnxNetIpThreadedTunnelConnection tunnel;
+        QSignalSpy errors(&tunnel, &QKnxNetIpThreadedTunnelConnection::errorOccurred);
+        tunnel.connectToHost(QHostAddress::LocalHostIPv6, 3671);
+
+        QTRY_COMPARE_WITH_TIMEOUT(errors.count(), 1, 5000);
+        QCOMPARE(errors.first().at(0).value<QKnxNetIpEndpointConnection::Error>(),
+            QKnxNetIpEndpointConnection::Error::NotIPv4);
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.state(), QKnxNetIpEndpointConnection::Disconnected, 5000);
+    }
+
+    void testSendAndReceive()
+    {
+        MockServer server(1);
+        QKnxNetIpThreadedTunnelConnection tunnel;
+
+        QSignalSpy connected(&tunnel, &QKnxNetIpThreadedTunnelConnection::connected);
+        tunnel.connectToHost(server.address(), server.port());
+        QTRY_COMPARE_WITH_TIMEOUT(connected.count(), 1, 5000);
+        QCOMPARE(tunnel.state(), QKnxNetIpEndpointConnection::Connected);
+
+        const int count = 20;
+        for (int i = 0; i < count; ++i)
+            QVERIFY(tunnel.sendTunnelFrame(createFrame(quint8(i))));
+
+        QTRY_COMPARE_WITH_TIMEOUT(server.frames(1).size(), count, 5000);
+        for (int i = 0; i < count; ++i)
+            QCOMPARE(server.frames(1).at(i).bytes(), createFrame(quint8(i)).bytes());
+
+        QVector<QKnxLinkLayerFrame> received;
+        QThread *receivingThread = nullptr;
+        connect(&tunnel, &QKnxNetIpThreadedTunnelConnection::receivedTunnelFrame,
+            [&](const QKnxLinkLayerFrame &frame) {
+                received.append(frame);
+                receivingThread = QThread::currentThread();
+        });
+
+        for (int i = 0; i < 5; ++i)
+            server.sendTunnelFrame(1, createFrame(quint8(i)));
+
+        QTRY_COMPARE_WITH_TIMEOUT(received.size(), 5, 5000);
+        QCOMPARE(receivingThread, QThread::currentThread());
+        for (int i = 0; i < 5; ++i)
+            QCOMPARE(received.at(i).bytes(), createFrame(quint8(i)).bytes());
+
+        QSignalSpy disconnected(&tunnel, &QKnxNetIpThreadedTunnelConnection::disconnected);
+        tunnel.disconnectFromHost();
+        QTRY_COMPARE_WITH_TIMEOUT(disconnected.count(), 1, 5000);
+        QCOMPARE(tunnel.state(), QKnxNetIpEndpointConnection::Disconnected);
+        QCOMPARE(tunnel.droppedFrameCount(), quint32(0));
+    }
+
+    void testReconnectSettings()
+    {
+        MockServer server(1);
+        server.setMaximumChannels(0);
+
+        QKnxNetIpThreadedTunnelConnection tunnel;
+        tunnel.setAutoReconnect(true);
+        tunnel.setReconnectInterval(10);
+        tunnel.setMaximumReconnectInterval(20);
+        tunnel.setMaximumReconnectAttempts(2);
+        QCOMPARE(tunnel.maximumReconnectAttempts(), 2);
+
+        QVector<QKnxNetIpEndpointConnection::Error> errors;
+        connect(&tunnel, &QKnxNetIpThreadedTunnelConnection::errorOccurred,
+            [&errors](QKnxNetIpEndpointConnection::Error error) { errors.append(error); });
+
+        // the refused connect is retried twice on the I/O thread, then it gives up
+        tunnel.connectToHost(server.address(), server.port());
+        QTRY_VERIFY_WITH_TIMEOUT(errors.contains(QKnxNetIpEndpointConnection::Error::Reconnect),
+            5000);
+        QCOMPARE(errors.size(), 4);
+        QCOMPARE(tunnel.state(), QKnxNetIpEndpointConnection::Disconnected);
+    }
+
+    void testBlockedOwnerThread()
+    {
+        MockServer server(1);
+
+        // the tunnel is owned by a thread that can be blocked while this thread keeps
+        // running the mock server
+        QThread owner;
+        owner.start();
+
+        QKnxNetIpThreadedTunnelConnection tunnel;
+        tunnel.moveToThread(&owner);
+
+        QAtomicInt received { 0 };
+        connect(&tunnel, &QKnxNetIpThreadedTunnelConnection::receivedTunnelFrame, &tunnel,
+            [&received](const QKnxLinkLayerFrame &) { received.ref(); });
+
+        QMetaObject::invokeMethod(&tunnel, [&tunnel, &server]() {
+            tunnel.connectToHost(server.address(), server.port());
+        }, Qt::BlockingQueuedConnection);
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.state(), QKnxNetIpEndpointConnection::Connected, 5000);
+
+        QSemaphore blocked, release;
+        QMetaObject::invokeMethod(&tunnel, [&blocked, &release]() {
+            blocked.release();
+            release.acquire();
+        }, Qt::QueuedConnection);
+        blocked.acquire();
+
+        // the I/O thread acknowledges while the owning thread does not process events
+        for (int i = 0; i < 3; ++i)
+            server.sendTunnelFrame(1, createFrame(quint8(i)));
+        QTRY_COMPARE_WITH_TIMEOUT(server.acknowledgeCount(), 3, 5000);
+        QCOMPARE(received.load(), 0);
+
+        release.release();
+        QTRY_COMPARE_WITH_TIMEOUT(received.load(), 3, 5000);
+
+        // hand the tunnel back, so it is destroyed on the thread it lives in
+        QThread *current = QThread::currentThread();
+        QMetaObject::invokeMethod(&tunnel, [&tunnel, current]() {
+            tunnel.moveToThread(current);
+        }, Qt::BlockingQueuedConnection);
+        owner.quit();
+        QVERIFY(owner.wait(5000));
+    }
+};
+
+QTEST_MAIN(tst_QKnxNetIpThreadedTunnelConnection)
+
+#include "tst_qknxnetipthreadedtunnelconnection.moc"
@@ -0,0 +1,9 @@
+TARGET = tst_qknxnetiptunnelconnection
+
+QT = core network testlib knx
+CONFIG += testcase c++11
+
+CONFIG -= app_bundle
+INCLUDEPATH += ../shared
+HEADERS += ../shared/qknxnetipmockserver.h
+SOURCES += tst_qknxnetiptunnelconnection.cpp
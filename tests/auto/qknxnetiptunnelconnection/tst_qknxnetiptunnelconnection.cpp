@@ -0,0 +1,458 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+#include <QtCore/qdebug.h>
+#include <QtCore/qendian.h>
+#include <QtKnx/qknxlinklayerframe.h>
+#include <QtKnx/qknxnetiptunnelconnection.h>
+#include <QtTest/qsignalspy.h>
+#include <QtTest/qtest.h>
+
+#include "qknxnetipmockserver.h"
+
+class tst_QKnxNetIpTunnelConnection : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testSendQueue()
+    {
+        MockServer server(1);
+        QKnxNetIpTunnelConnection tunnel;
+        QCOMPARE(tunnel.sendQueueSize(), 0);
+        QCOMPARE(tunnel.maximumSendQueueSize(), 64);
+
+        tunnel.connectToHost(server.address(), server.port());
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.state(), QKnxNetIpEndpointConnection::Connected, 5000);
+
+        QVector<int> sizes;
+        connect(&tunnel, &QKnxNetIpEndpointConnection::sendQueueSizeChanged,
+            [&sizes](int size) { sizes.append(size); });
+
+        // the first frame goes out right away, the others wait for its acknowledge
+        for (quint8 value = 0; value < 3; ++value)
+            QVERIFY(tunnel.sendTunnelFrame(createFrame(value)));
+        QCOMPARE(tunnel.sendQueueSize(), 2);
+        QCOMPARE(sizes, QVector<int>({ 1, 0, 1, 2 }));
+
+        QTRY_COMPARE_WITH_TIMEOUT(server.frames(1).size(), 3, 5000);
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.sendQueueSize(), 0, 5000);
+        QCOMPARE(sizes, QVector<int>({ 1, 0, 1, 2, 1, 0 }));
+
+        const auto frames = server.frames(1);
+        for (quint8 value = 0; value < 3; ++value)
+            QCOMPARE(frames.at(value).bytes(), createFrame(value).bytes());
+        QCOMPARE(server.sequenceCounts(1), QVector<quint8>({ 0, 1, 2 }));
+        QCOMPARE(tunnel.droppedFrameCount(), quint32(0));
+    }
+
+    void testSendQueuePriority()
+    {
+        MockServer server(1);
+        QKnxNetIpTunnelConnection tunnel;
+        tunnel.connectToHost(server.address(), server.port());
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.state(), QKnxNetIpEndpointConnection::Connected, 5000);
+
+        const auto first = createFrame(1, QKnxControlField::Priority::Low);
+        const auto low = createFrame(2, QKnxControlField::Priority::Low);
+        const auto normal = createFrame(3, QKnxControlField::Priority::Normal);
+        const auto system = createFrame(4, QKnxControlField::Priority::System);
+
+        QVERIFY(tunnel.sendTunnelFrame(first));
+        QVERIFY(tunnel.sendTunnelFrame(low));
+        QVERIFY(tunnel.sendTunnelFrame(normal));
+        QVERIFY(tunnel.sendTunnelFrame(system));
+
+        QTRY_COMPARE_WITH_TIMEOUT(server.frames(1).size(), 4, 5000);
+        const auto frames = server.frames(1);
+        QCOMPARE(frames.at(0).bytes(), first.bytes());
+        QCOMPARE(frames.at(1).bytes(), system.bytes());
+        QCOMPARE(frames.at(2).bytes(), normal.bytes());
+        QCOMPARE(frames.at(3).bytes(), low.bytes());
+
+        // the sequence counter follows the order the frames left the queue
+        QCOMPARE(server.sequenceCounts(1), QVector<quint8>({ 0, 1, 2, 3 }));
+    }
+
+    void testSendQueueOverflow()
+    {
+        MockServer server(1);
+        QKnxNetIpTunnelConnection tunnel;
+        tunnel.setMaximumSendQueueSize(2);
+        QCOMPARE(tunnel.maximumSendQueueSize(), 2);
+        tunnel.setMaximumSendQueueSize(0); // every frame passes the queue, ignored
+        QCOMPARE(tunnel.maximumSendQueueSize(), 2);
+
+        tunnel.connectToHost(server.address(), server.port());
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.state(), QKnxNetIpEndpointConnection::Connected, 5000);
+
+        QSignalSpy dropped(&tunnel, &QKnxNetIpEndpointConnection::frameDropped);
+        QVERIFY(tunnel.sendTunnelFrame(createFrame(0))); // in flight
+        QVERIFY(tunnel.sendTunnelFrame(createFrame(1)));
+        QVERIFY(tunnel.sendTunnelFrame(createFrame(2)));
+        QVERIFY(!tunnel.sendTunnelFrame(createFrame(3)));
+        QCOMPARE(dropped.count(), 1);
+        QCOMPARE(tunnel.droppedFrameCount(), quint32(1));
+
+        QTRY_COMPARE_WITH_TIMEOUT(server.frames(1).size(), 3, 5000);
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.sendQueueSize(), 0, 5000);
+        QCOMPARE(server.frames(1).last().bytes(), createFrame(2).bytes());
+
+        // frames still queued on disconnect are dropped as well
+        server.dropAcknowledges(-1);
+        QVERIFY(tunnel.sendTunnelFrame(createFrame(4))); // in flight, never acknowledged
+        QVERIFY(tunnel.sendTunnelFrame(createFrame(5)));
+        QVERIFY(tunnel.sendTunnelFrame(createFrame(6)));
+        QCOMPARE(tunnel.sendQueueSize(), 2);
+
+        tunnel.disconnectFromHost();
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.state(), QKnxNetIpEndpointConnection::Disconnected, 5000);
+        QCOMPARE(tunnel.sendQueueSize(), 0);
+        QCOMPARE(dropped.count(), 3);
+        QCOMPARE(tunnel.droppedFrameCount(), quint32(3));
+    }
+
+    void testResendKeepsSequenceCount()
+    {
+        MockServer server(1);
+        QKnxNetIpTunnelConnection tunnel;
+        tunnel.connectToHost(server.address(), server.port());
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.state(), QKnxNetIpEndpointConnection::Connected, 5000);
+
+        // the first request is not acknowledged and sent again after the acknowledge timeout
+        server.dropAcknowledges(1);
+        QVERIFY(tunnel.sendTunnelFrame(createFrame(0)));
+        QVERIFY(tunnel.sendTunnelFrame(createFrame(1)));
+
+        QTRY_COMPARE_WITH_TIMEOUT(server.frames(1).size(), 3, 5000);
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.sendQueueSize(), 0, 5000);
+
+        const auto frames = server.frames(1);
+        QCOMPARE(frames.at(0).bytes(), createFrame(0).bytes());
+        QCOMPARE(frames.at(1).bytes(), createFrame(0).bytes());
+        QCOMPARE(frames.at(2).bytes(), createFrame(1).bytes());
+
+        // the resent request keeps its sequence count, the queued one is stamped afterwards
+        QCOMPARE(server.sequenceCounts(1), QVector<quint8>({ 0, 0, 1 }));
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.sequenceCount(QKnxNetIpEndpointConnection::Send), 2,
+            5000);
+        QCOMPARE(tunnel.statistics().retransmissions(), quint64(1));
+    }
+
+    void testReconnect()
+    {
+        MockServer server(1);
+        server.setMaximumChannels(0);
+
+        QKnxNetIpTunnelConnection tunnel;
+        tunnel.setAutoReconnect(true);
+        tunnel.setReconnectInterval(20);
+        tunnel.setMaximumReconnectInterval(40);
+
+        QVector<int> attempts, delays;
+        connect(&tunnel, &QKnxNetIpEndpointConnection::reconnecting,
+            [&](int attempt, int msec) { attempts.append(attempt); delays.append(msec); });
+
+        // refused with NoMoreUniqueConnections, retried with growing delay
+        tunnel.connectToHost(server.address(), server.port());
+        QTRY_VERIFY_WITH_TIMEOUT(attempts.size() >= 3, 5000);
+        QCOMPARE(attempts.mid(0, 3), QVector<int>({ 1, 2, 3 }));
+        QVERIFY(delays.at(0) >= 10 && delays.at(0) <= 20);
+        QVERIFY(delays.at(1) >= 20 && delays.at(1) <= 40);
+        QVERIFY(delays.at(2) >= 20 && delays.at(2) <= 40);
+
+        server.setMaximumChannels(1);
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.state(), QKnxNetIpEndpointConnection::Connected, 5000);
+        QCOMPARE(tunnel.individualAddress(), MockServer::individualAddress(1));
+
+        // the server drops the connection, the tunnel comes back on a new channel
+        attempts.clear();
+        server.sendDisconnectRequest(1);
+        QTRY_COMPARE_WITH_TIMEOUT(attempts.size(), 1, 5000);
+        QCOMPARE(attempts.first(), 1);
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.state(), QKnxNetIpEndpointConnection::Connected, 5000);
+        QCOMPARE(server.channels(), QList<quint8>({ 2 }));
+
+        // the server closed the connection, there is nothing left to disconnect from
+        QCOMPARE(server.disconnectRequestCount(), 0);
+
+        tunnel.disconnectFromHost();
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.state(), QKnxNetIpEndpointConnection::Disconnected, 5000);
+        QCOMPARE(server.disconnectRequestCount(), 1);
+        QTest::qWait(100);
+        QCOMPARE(attempts.size(), 1);
+    }
+
+    void testHeartbeatTimeout()
+    {
+        // a single tunnel, the reconnect only succeeds if the server released the channel
+        MockServer server(1);
+        server.setMaximumChannels(1);
+
+        QKnxNetIpTunnelConnection tunnel;
+        tunnel.setHeartbeatTimeout(100);
+        tunnel.setAutoReconnect(true);
+        tunnel.setReconnectInterval(20);
+        tunnel.connectToHost(server.address(), server.port());
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.state(), QKnxNetIpEndpointConnection::Connected, 5000);
+
+        int disconnectRequests = -1;
+        auto error = QKnxNetIpEndpointConnection::Error::None;
+        connect(&tunnel, &QKnxNetIpEndpointConnection::reconnecting, [&]() {
+            if (disconnectRequests >= 0)
+                return;
+            disconnectRequests = server.disconnectRequestCount();
+            error = tunnel.error();
+        });
+
+        // every connection state request times out after 10 seconds
+        server.ignoreConnectionStateRequests(true);
+        QTRY_VERIFY_WITH_TIMEOUT(disconnectRequests >= 0, 60000);
+        QCOMPARE(disconnectRequests, 1);
+        QCOMPARE(error, QKnxNetIpEndpointConnection::Error::Heartbeat);
+
+        server.ignoreConnectionStateRequests(false);
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.state(), QKnxNetIpEndpointConnection::Connected, 5000);
+        QCOMPARE(server.channels(), QList<quint8>({ 2 }));
+    }
+
+    void testReconnectGivesUp()
+    {
+        MockServer server(1);
+        server.setMaximumChannels(0);
+
+        QKnxNetIpTunnelConnection tunnel;
+        tunnel.setAutoReconnect(true);
+        tunnel.setReconnectInterval(10);
+        tunnel.setMaximumReconnectAttempts(2);
+
+        QVector<int> attempts;
+        connect(&tunnel, &QKnxNetIpEndpointConnection::reconnecting,
+            [&attempts](int attempt, int) { attempts.append(attempt); });
+
+        QVector<QKnxNetIpEndpointConnection::Error> errors;
+        connect(&tunnel, &QKnxNetIpEndpointConnection::errorOccurred,
+            [&errors](QKnxNetIpEndpointConnection::Error error) { errors.append(error); });
+
+        QSignalSpy disconnected(&tunnel, &QKnxNetIpEndpointConnection::disconnected);
+        tunnel.connectToHost(server.address(), server.port());
+
+        QTRY_COMPARE_WITH_TIMEOUT(disconnected.count(), 3, 5000);
+        QTest::qWait(200);
+        QCOMPARE(attempts, QVector<int>({ 1, 2 }));
+        QCOMPARE(tunnel.state(), QKnxNetIpEndpointConnection::Disconnected);
+
+        // each refused connect is reported, then giving up
+        QCOMPARE(errors.size(), 4);
+        QCOMPARE(errors.count(QKnxNetIpEndpointConnection::Error::Reconnect), 1);
+        QCOMPARE(errors.last(), QKnxNetIpEndpointConnection::Error::Reconnect);
+        QCOMPARE(tunnel.error(), QKnxNetIpEndpointConnection::Error::Reconnect);
+    }
+
+    void testSingleSocket_data()
+    {
+        QTest::addColumn<bool>("natAware");
+        QTest::newRow("single socket") << false;
+        QTest::newRow("nat aware") << true;
+    }
+
+    void testSingleSocket()
+    {
+        QFETCH(bool, natAware);
+
+        MockServer server(1);
+        QKnxNetIpTunnelConnection tunnel;
+        tunnel.setNatAware(natAware);
+        tunnel.setSingleSocket(!natAware);
+        QVERIFY(tunnel.singleSocket());
+
+        tunnel.connectToHost(server.address(), server.port());
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.state(), QKnxNetIpEndpointConnection::Connected, 5000);
+        QVERIFY(tunnel.singleSocket());
+
+        // both endpoints are served by the same socket
+        QCOMPARE(server.dataEndpoint(1).port(), server.controlEndpoint(1).port());
+        QCOMPARE(server.dataEndpoint(1).port(), tunnel.localPort());
+
+        QVector<QKnxLinkLayerFrame> received;
+        connect(&tunnel, &QKnxNetIpTunnelConnection::receivedTunnelFrame,
+            [&received](const QKnxLinkLayerFrame &frame) { received.append(frame); });
+
+        const auto frame = createFrame(4);
+        QVERIFY(tunnel.sendTunnelFrame(frame));
+        server.sendTunnelFrame(1, frame);
+
+        QTRY_COMPARE_WITH_TIMEOUT(received.size(), 1, 5000);
+        QCOMPARE(received.first().bytes(), frame.bytes());
+        QTRY_COMPARE_WITH_TIMEOUT(server.frames(1).size(), 1, 5000);
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.sendQueueSize(), 0, 5000);
+
+        tunnel.disconnectFromHost();
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.state(), QKnxNetIpEndpointConnection::Disconnected, 5000);
+    }
+
+    void testInvalidTunnelingRequest()
+    {
+        MockServer server(1);
+        QKnxNetIpTunnelConnection tunnel;
+        tunnel.connectToHost(server.address(), server.port());
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.state(), QKnxNetIpEndpointConnection::Connected, 5000);
+
+        QVector<QKnxLinkLayerFrame> received;
+        connect(&tunnel, &QKnxNetIpTunnelConnection::receivedTunnelFrame,
+            [&received](const QKnxLinkLayerFrame &frame) { received.append(frame); });
+
+        // wrong connection header size, then a request without cEMI, both must be dropped
+        // without acknowledge and without consuming the receive sequence count
+        auto bytes = QKnxNetIpTunnelingRequest(1, 0, createFrame(1)).bytes();
+        bytes[6] = 0x05;
+        server.sendDatagram(1, bytes);
+        server.sendDatagram(1, QByteArray::fromHex("06100420000a04010000"));
+
+        const auto frame = createFrame(2);
+        server.sendTunnelFrame(1, frame);
+
+        QTRY_COMPARE_WITH_TIMEOUT(received.size(), 1, 5000);
+        QCOMPARE(received.first().bytes(), frame.bytes());
+        QTRY_COMPARE_WITH_TIMEOUT(server.acknowledgeCount(), 1, 5000);
+        QTest::qWait(100);
+        QCOMPARE(server.acknowledgeCount(), 1);
+        QCOMPARE(received.size(), 1);
+    }
+
+    void testFrameTrace()
+    {
+        struct Record { qint64 time; quint8 direction; QByteArray bytes; };
+        auto parse = [](const QByteArray &trace) {
+            QVector<Record> records;
+            for (int i = 0; i + 11 <= trace.size();) {
+                const auto size = qFromLittleEndian<quint16>(trace.constData() + i + 9);
+                records.append({ qFromLittleEndian<qint64>(trace.constData() + i),
+                    quint8(trace.at(i + 8)), trace.mid(i + 11, size) });
+                i += 11 + size;
+            }
+            return records;
+        };
+
+        MockServer server(1);
+        QKnxNetIpTunnelConnection tunnel;
+        QCOMPARE(tunnel.frameTraceCapacity(), 0);
+        tunnel.setFrameTraceCapacity(4096);
+        QCOMPARE(tunnel.frameTraceCapacity(), 4096);
+
+        tunnel.connectToHost(server.address(), server.port());
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.state(), QKnxNetIpEndpointConnection::Connected, 5000);
+        QVERIFY(tunnel.sendTunnelFrame(createFrame(4)));
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.sendQueueSize(), 0, 5000);
+        QTRY_COMPARE_WITH_TIMEOUT(server.frames(1).size(), 1, 5000);
+
+        auto records = parse(tunnel.frameTrace());
+        QVERIFY(records.size() >= 4);
+
+        // connect request (0x0205) sent, connect response (0x0206) received
+        QCOMPARE(records.at(0).direction, quint8(1));
+        QCOMPARE(qFromBigEndian<quint16>(records.at(0).bytes.constData() + 2), quint16(0x0205));
+        QCOMPARE(records.at(1).direction, quint8(0));
+        QCOMPARE(qFromBigEndian<quint16>(records.at(1).bytes.constData() + 2), quint16(0x0206));
+        for (int i = 1; i < records.size(); ++i)
+            QVERIFY(records.at(i).time >= records.at(i - 1).time);
+
+        bool tunnelingRequest = false;
+        for (const auto &record : qAsConst(records)) {
+            tunnelingRequest |= record.direction == 1
+                && qFromBigEndian<quint16>(record.bytes.constData() + 2) == 0x0420;
+        }
+        QVERIFY(tunnelingRequest);
+
+        // a small buffer only keeps the most recent records
+        tunnel.setFrameTraceCapacity(64);
+        QVERIFY(tunnel.frameTrace().isEmpty());
+        for (int i = 0; i < 4; ++i)
+            QVERIFY(tunnel.sendTunnelFrame(createFrame(4)));
+        QTRY_COMPARE_WITH_TIMEOUT(server.frames(1).size(), 5, 5000);
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.sendQueueSize(), 0, 5000);
+
+        const auto trace = tunnel.frameTrace();
+        QVERIFY(!trace.isEmpty() && trace.size() <= 64);
+        records = parse(trace);
+        int size = 0;
+        for (const auto &record : qAsConst(records))
+            size += 11 + record.bytes.size();
+        QCOMPARE(size, trace.size());
+
+        tunnel.disconnectFromHost();
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.state(), QKnxNetIpEndpointConnection::Disconnected, 5000);
+    }
+
+    void testStatistics()
+    {
+        MockServer server(1);
+        QKnxNetIpTunnelConnection tunnel;
+        tunnel.setStatisticsInterval(50);
+        QCOMPARE(tunnel.statisticsInterval(), 50);
+
+        QVector<QKnxNetIpConnectionStatistics> updates;
+        connect(&tunnel, &QKnxNetIpTunnelConnection::statisticsUpdated,
+            [&updates](const QKnxNetIpConnectionStatistics &s) { updates.append(s); });
+
+        tunnel.connectToHost(server.address(), server.port());
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.state(), QKnxNetIpEndpointConnection::Connected, 5000);
+
+        const int count = 5;
+        for (int i = 0; i < count; ++i)
+            QVERIFY(tunnel.sendTunnelFrame(createFrame(4)));
+        server.sendTunnelFrame(1, createFrame(5));
+
+        QTRY_COMPARE_WITH_TIMEOUT(server.frames(1).size(), count, 5000);
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.sendQueueSize(), 0, 5000);
+        QTRY_VERIFY_WITH_TIMEOUT(tunnel.statistics().heartbeatLatency().count() > 0, 5000);
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.statistics().framesReceived(), quint64(1), 5000);
+
+        const auto statistics = tunnel.statistics();
+        QCOMPARE(statistics.framesSent(), quint64(count));
+        QCOMPARE(statistics.retransmissions(), quint64(0));
+        QCOMPARE(statistics.acknowledgeLatency().count(), quint64(count));
+        QCOMPARE(statistics.queueWaitTime().count(), quint64(count));
+        QVERIFY(statistics.acknowledgeLatency().maximum() >= statistics.acknowledgeLatency()
+            .minimum());
+
+        QTRY_VERIFY_WITH_TIMEOUT(updates.size() >= 2, 5000);
+        QVERIFY(updates.last().framesSent() >= updates.first().framesSent());
+
+        tunnel.disconnectFromHost();
+        QTRY_COMPARE_WITH_TIMEOUT(tunnel.state(), QKnxNetIpEndpointConnection::Disconnected, 5000);
+
+        // no further updates once disconnected
+        const int received = updates.size();
+        QTest::qWait(150);
+        QCOMPARE(updates.size(), received);
+    }
+};
+
+QTEST_MAIN(tst_QKnxNetIpTunnelConnection)
+
+#include "tst_qknxnetiptunnelconnection.moc"
@@ -0,0 +1,168 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+#include <QtCore/qdebug.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qset.h>
+#include <QtKnx/qknxlinklayerframe.h>
+#include <QtKnx/qknxnetiptunnelconnectionpool.h>
+#include <QtTest/qsignalspy.h>
+#include <QtTest/qtest.h>
+
+#include "qknxnetipmockserver.h"
+
+class tst_QKnxNetIpTunnelConnectionPool : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testDefaultConstructor()
+    {
+        QKnxNetIpTunnelConnectionPool pool;
+        QCOMPARE(pool.size(), 4);
+        QCOMPARE(pool.connectedCount(), 0);
+        QCOMPARE(pool.connections().size(), 0);
+        QCOMPARE(pool.localAddress(), QHostAddress(QHostAddress::LocalHost));
+        QVERIFY(!pool.connection(QKnxAddress::createGroup(1, 1, 1)));
+        QCOMPARE(pool.sendTunnelFrame(createFrame(QKnxAddress::createGroup(1, 1, 1), 0)), false);
+
+        pool.setSize(0);
+        QCOMPARE(pool.size(), 4);
+        pool.setSize(2);
+        QCOMPARE(pool.size(), 2);
+    }
+
+    void testConnect()
+    {
+        MockServer server(21);
+        QKnxNetIpTunnelConnectionPool pool(QHostAddress::LocalHost, 3);
+
+        QSignalSpy connected(&pool, &QKnxNetIpTunnelConnectionPool::connected);
+        pool.connectToHost(server.address(), server.port());
+
+        QTRY_COMPARE_WITH_TIMEOUT(pool.connectedCount(), 3, 5000);
+        QCOMPARE(connected.count(), 1);
+        QCOMPARE(pool.connections().size(), 3);
+        QCOMPARE(server.channels().size(), 3);
+
+        QSet<QKnxAddress> addresses;
+        for (auto connection : pool.connections())
+            addresses.insert(connection->individualAddress());
+        QCOMPARE(addresses.size(), 3);
+        QVERIFY(addresses.contains(MockServer::individualAddress(21)));
+        QVERIFY(addresses.contains(MockServer::individualAddress(23)));
+
+        QSignalSpy disconnected(&pool, &QKnxNetIpTunnelConnectionPool::disconnected);
+        pool.disconnectFromHost();
+        QTRY_COMPARE_WITH_TIMEOUT(disconnected.count(), 1, 5000);
+        QCOMPARE(pool.connectedCount(), 0);
+        QCOMPARE(server.channels().size(), 0);
+    }
+
+    void testRefusedConnection()
+    {
+        MockServer server(1);
+        server.setMaximumChannels(2);
+
+        QKnxNetIpTunnelConnectionPool pool(QHostAddress::LocalHost, 3);
+        QSignalSpy errors(&pool, &QKnxNetIpTunnelConnectionPool::errorOccurred);
+        pool.connectToHost(server.address(), server.port());
+
+        QTRY_COMPARE_WITH_TIMEOUT(errors.count(), 1, 5000);
+        QCOMPARE(errors.first().at(0).toInt(), 2);
+        QCOMPARE(pool.connectedCount(), 2);
+        QCOMPARE(pool.connections().at(2)->state(), QKnxNetIpEndpointConnection::Disconnected);
+        QVERIFY(pool.sendTunnelFrame(createFrame(QKnxAddress::createGroup(1, 1, 1), 0)));
+    }
+
+    void testSendByDestination()
+    {
+        MockServer server(1);
+        QKnxNetIpTunnelConnectionPool pool(QHostAddress::LocalHost, 3);
+        pool.connectToHost(server.address(), server.port());
+        QTRY_COMPARE_WITH_TIMEOUT(pool.connectedCount(), 3, 5000);
+
+        // interleave the destinations, each one must still arrive in order on a single tunnel
+        const int destinations = 16, framesPerDestination = 4;
+        for (int value = 0; value < framesPerDestination; ++value) {
+            for (int i = 0; i < destinations; ++i) {
+                QVERIFY(pool.sendTunnelFrame(createFrame(QKnxAddress::createGroup(1, 1, quint8(i)),
+                    quint8(value))));
+            }
+        }
+
+        auto received = [&server]() {
+            int count = 0;
+            for (auto channelId : server.channels())
+                count += server.frames(channelId).size();
+            return count;
+        };
+        QTRY_COMPARE_WITH_TIMEOUT(received(), destinations * framesPerDestination, 5000);
+
+        int usedChannels = 0;
+        for (auto channelId : server.channels()) {
+            const auto frames = server.frames(channelId);
+            usedChannels += frames.isEmpty() ? 0 : 1;
+
+            QHash<QKnxAddress, quint8> nextValue;
+            for (const auto &frame : frames) {
+                const auto destination = frame.destinationAddress();
+                QCOMPARE(pool.connection(destination)->individualAddress(),
+                    MockServer::individualAddress(channelId));
+                const auto expected = createFrame(destination, nextValue[destination]++);
+                QCOMPARE(frame.bytes(), expected.bytes());
+            }
+        }
+        QVERIFY(usedChannels > 1);
+    }
+
+    void testReceive()
+    {
+        MockServer server(1);
+        QKnxNetIpTunnelConnectionPool pool(QHostAddress::LocalHost, 2);
+        pool.connectToHost(server.address(), server.port());
+        QTRY_COMPARE_WITH_TIMEOUT(pool.connectedCount(), 2, 5000);
+
+        QVector<QKnxLinkLayerFrame> received;
+        connect(&pool, &QKnxNetIpTunnelConnectionPool::receivedTunnelFrame,
+            [&received](const QKnxLinkLayerFrame &frame) { received.append(frame); });
+
+        server.sendTunnelFrame(1, createFrame(QKnxAddress::createGroup(2, 2, 1), 1));
+        server.sendTunnelFrame(2, createFrame(QKnxAddress::createGroup(2, 2, 2), 2));
+
+        QTRY_COMPARE_WITH_TIMEOUT(received.size(), 2, 5000);
+        QSet<QKnxAddress> destinations;
+        for (const auto &frame : qAsConst(received))
+            destinations.insert(frame.destinationAddress());
+        QVERIFY(destinations.contains(QKnxAddress::createGroup(2, 2, 1)));
+        QVERIFY(destinations.contains(QKnxAddress::createGroup(2, 2, 2)));
+    }
+};
+
+QTEST_MAIN(tst_QKnxNetIpTunnelConnectionPool)
+
+#include "tst_qknxnetiptunnelconnectionpool.moc"
@@ -0,0 +1,195 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+#include <QtCore/qcoreevent.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qvector.h>
+#include <QtKnx/private/qknxtimerwheel_p.h>
+#include <QtTest/qtest.h>
+
+class TimerEventCounter : public QObject
+{
+public:
+    int count { 0 };
+
+protected:
+    bool eventFilter(QObject *, QEvent *event) override
+    {
+        if (event->type() == QEvent::Timer)
+            ++count;
+        return false;
+    }
+};
+
+class tst_QKnxTimerWheel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testSingleShot();
+    void testOrder();
+    void testStop();
+    void testStopFromCallback();
+    void testRestartFromCallback();
+    void testLongInterval();
+    void testIdleWakeups();
+};
+
+void tst_QKnxTimerWheel::testSingleShot()
+{
+    int fired = 0;
+    QKnxWheelTimer timer;
+    timer.setInterval(50);
+    timer.setCallback([&]() { ++fired; });
+    QCOMPARE(timer.isActive(), false);
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    timer.start();
+    QCOMPARE(timer.isActive(), true);
+    QCOMPARE(QKnxTimerWheel::instance()->activeTimerCount(), 1);
+
+    QTRY_COMPARE(fired, 1);
+    QVERIFY(elapsed.elapsed() >= 50);
+    QCOMPARE(timer.isActive(), false);
+    QCOMPARE(QKnxTimerWheel::instance()->activeTimerCount(), 0);
+
+    QTest::qWait(100);
+    QCOMPARE(fired, 1);
+}
+
+void tst_QKnxTimerWheel::testOrder()
+{
+    QVector<int> order;
+    QKnxWheelTimer timers[3];
+    const int intervals[3] = { 120, 20, 60 };
+    for (int i = 0; i < 3; ++i) {
+        timers[i].setCallback([&order, i]() { order.append(i); });
+        timers[i].start(intervals[i]);
+    }
+    QCOMPARE(QKnxTimerWheel::instance()->activeTimerCount(), 3);
+
+    QTRY_COMPARE(order.size(), 3);
+    QCOMPARE(order, QVector<int>({ 1, 2, 0 }));
+}
+
+void tst_QKnxTimerWheel::testStop()
+{
+    int fired = 0;
+    {
+        QKnxWheelTimer timer;
+        timer.setCallback([&]() { ++fired; });
+        timer.start(20);
+        QKnxWheelTimer other;
+        other.setCallback([&]() { ++fired; });
+        other.start(20);
+        QCOMPARE(QKnxTimerWheel::instance()->activeTimerCount(), 2);
+
+        timer.stop();
+        QCOMPARE(timer.isActive(), false);
+        QCOMPARE(QKnxTimerWheel::instance()->activeTimerCount(), 1);
+    } // the destructor stops the other timer
+    QCOMPARE(QKnxTimerWheel::instance()->activeTimerCount(), 0);
+
+    QTest::qWait(60);
+    QCOMPARE(fired, 0);
+}
+
+void tst_QKnxTimerWheel::testStopFromCallback()
+{
+    int first = 0, second = 0;
+    QKnxWheelTimer a, b;
+    a.setCallback([&]() { ++first; b.stop(); });
+    b.setCallback([&]() { ++second; a.stop(); });
+
+    // both expire within the same tick, only the one invoked first may fire
+    a.start(20);
+    b.start(20);
+    QTRY_COMPARE(first + second, 1);
+    QTest::qWait(60);
+    QCOMPARE(first + second, 1);
+    QCOMPARE(QKnxTimerWheel::instance()->activeTimerCount(), 0);
+}
+
+void tst_QKnxTimerWheel::testRestartFromCallback()
+{
+    int fired = 0;
+    QKnxWheelTimer timer;
+    timer.setInterval(10);
+    timer.setCallback([&]() {
+        if (++fired < 5)
+            timer.start();
+    });
+    timer.start();
+
+    QTRY_COMPARE(fired, 5);
+    QCOMPARE(timer.isActive(), false);
+}
+
+void tst_QKnxTimerWheel::testLongInterval()
+{
+    // an interval larger than one revolution of the wheel must not fire on the first pass
+    const int revolution = QKnxTimerWheel::Resolution * QKnxTimerWheel::SlotCount;
+
+    int fired = 0;
+    QKnxWheelTimer timer;
+    timer.setCallback([&]() { ++fired; });
+
+    QKnxWheelTimer passing;
+    passing.setCallback([]() {});
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    timer.start(revolution + 100);
+    passing.start(revolution / 2);
+
+    QTest::qWait(revolution);
+    QCOMPARE(fired, 0);
+    QTRY_COMPARE_WITH_TIMEOUT(fired, 1, 2 * revolution);
+    QVERIFY(elapsed.elapsed() >= revolution + 100);
+}
+
+void tst_QKnxTimerWheel::testIdleWakeups()
+{
+    // the wheel is only woken up for occupied slots, not for every tick
+    TimerEventCounter counter;
+    QKnxTimerWheel::instance()->installEventFilter(&counter);
+
+    int fired = 0;
+    QKnxWheelTimer timer;
+    timer.setCallback([&]() { ++fired; });
+    timer.start(1000);
+
+    QTRY_COMPARE_WITH_TIMEOUT(fired, 1, 5000);
+    QVERIFY2(counter.count <= 3, qPrintable(QString::number(counter.count)));
+
+    QKnxTimerWheel::instance()->removeEventFilter(&counter);
+}
+
+QTEST_MAIN(tst_QKnxTimerWheel)
+
+#include "tst_qknxtimerwheel.moc"
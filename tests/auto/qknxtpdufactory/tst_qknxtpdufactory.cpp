@@ -37,6 +37,7 @@ class tst_QKnxTpduFactory : public QObject
 
 private Q_SLOTS:
     void testTpdu();
+    void testTpduFromBytes();
     void testGroupValueRead();
     void testGroupValueWrite();
     // TODO: GroupValueResponse
@@ -193,6 +194,51 @@ void tst_QKnxTpduFactory::testTpdu()
     QCOMPARE(tmpTpdu.bytes(), tpdu.bytes());
 }
 
+void tst_QKnxTpduFactory::testTpduFromBytes()
+{
+    const auto check = [](const QVector<quint8> &bytes, QKnxTpdu::TransportControlField tpci,
+        QKnxTpdu::ApplicationControlField apci) {
+        auto tpdu = QKnxTpdu::fromBytes(bytes, 0, quint8(bytes.size()));
+        QCOMPARE(tpdu.bytes(), bytes);
+        QCOMPARE(tpdu.transportControlField(), tpci);
+        QCOMPARE(tpdu.applicationControlField(), apci);
+    };
+
+    check({ 0x00, 0x00 }, QKnxTpdu::TransportControlField::DataGroup,
+        QKnxTpdu::ApplicationControlField::GroupValueRead);
+    check({ 0x00, 0x41 }, QKnxTpdu::TransportControlField::DataGroup,
+        QKnxTpdu::ApplicationControlField::GroupValueResponse);
+    check({ 0x00, 0x80, 0x0c, 0x1a }, QKnxTpdu::TransportControlField::DataGroup,
+        QKnxTpdu::ApplicationControlField::GroupValueWrite);
+    check({ 0x04, 0xbf }, QKnxTpdu::TransportControlField::DataTagGroup,
+        QKnxTpdu::ApplicationControlField::GroupValueWrite);
+    check({ 0x01, 0x00 }, QKnxTpdu::TransportControlField::DataBroadcast,
+        QKnxTpdu::ApplicationControlField::IndividualAddressRead);
+    check({ 0x49, 0x83, 0x02 }, QKnxTpdu::TransportControlField::DataConnected,
+        QKnxTpdu::ApplicationControlField::AdcRead);
+    check({ 0x4a, 0x03 }, QKnxTpdu::TransportControlField::DataConnected,
+        QKnxTpdu::ApplicationControlField::MemoryRead);
+    check({ 0x4a, 0xc0, 0x13, 0xff, 0xff }, QKnxTpdu::TransportControlField::DataConnected,
+        QKnxTpdu::ApplicationControlField::UserMemoryRead);
+    check({ 0x43, 0xd5, 0x00, 0x01 }, QKnxTpdu::TransportControlField::DataConnected,
+        QKnxTpdu::ApplicationControlField::PropertyValueRead);
+    check({ 0x80 }, QKnxTpdu::TransportControlField::Connect,
+        QKnxTpdu::ApplicationControlField::Invalid);
+    check({ 0xca }, QKnxTpdu::TransportControlField::Acknowledge,
+        QKnxTpdu::ApplicationControlField::Invalid);
+
+    // larger than the inline buffer of a standard frame TPDU
+    QVector<quint8> extended(40, 0x55);
+    extended[0] = 0x00;
+    extended[1] = 0x80;
+    check(extended, QKnxTpdu::TransportControlField::DataGroup,
+        QKnxTpdu::ApplicationControlField::GroupValueWrite);
+
+    auto tpdu = QKnxTpdu::fromBytes(extended, 0, 41);
+    QCOMPARE(tpdu.transportControlField(), QKnxTpdu::TransportControlField::Invalid);
+    QCOMPARE(tpdu.applicationControlField(), QKnxTpdu::ApplicationControlField::Invalid);
+}
+
 void tst_QKnxTpduFactory::testGroupValueRead()
 {
     auto tpdu = QKnxTpduFactory::Multicast::createGroupValueReadTpdu();
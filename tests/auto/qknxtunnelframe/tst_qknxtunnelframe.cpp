@@ -29,6 +29,7 @@
 #include <QtCore/qdebug.h>
 #include <QtKnx/qknxlinklayerframe.h>
 #include <QtKnx/qknxtpdufactory.h>
+#include <QtKnx/private/qknxlinklayerframeview_p.h>
 #include <QtTest/qtest.h>
 
 static QString s_msg;
@@ -113,6 +114,125 @@ private slots:
         QCOMPARE(frame.tpdu().bytes(), QVector<quint8>({ 0x00, 0x80, 0xff }));
     }
 
+    void testInPlaceFields()
+    {
+        QKnxLinkLayerFrame frame(QKnx::MediumType::NetIP, QKnxLinkLayerFrame::MessageCode::DataRequest);
+        frame.setControlField(QKnxControlField(0xbc));
+        frame.setExtendedControlField(QKnxExtendedControlField(0xe0));
+        frame.setSourceAddress(QKnxAddress::createIndividual(1, 1, 10));
+        frame.setDestinationAddress(QKnxAddress::createGroup(1, 2, 3));
+        frame.setTpdu(QKnxTpduFactory::Multicast::createGroupValueWriteTpdu(QVector<quint8>(1, 1)));
+        QCOMPARE(frame.bytes(), QByteArray::fromHex("1100bce0110a0a03010081"));
+
+        // adding additional info moves all fields, they must still be found
+        frame.addAdditionalInfo({ QKnxAdditionalInfo::Type::BiBatInformation,
+            QByteArray::fromHex("1020") });
+        QCOMPARE(frame.bytes(), QByteArray::fromHex("110407021020bce0110a0a03010081"));
+        QCOMPARE(frame.additionalInfosSize(), quint8(4));
+        QCOMPARE(frame.controlField().bytes(), QKnxControlField(0xbc).bytes());
+        QCOMPARE(frame.sourceAddress(), QKnxAddress::createIndividual(1, 1, 10));
+        QCOMPARE(frame.destinationAddress(), QKnxAddress::createGroup(1, 2, 3));
+        QCOMPARE(frame.tpdu().bytes(), QVector<quint8>({ 0x00, 0x81 }));
+
+        // setters overwrite in place and keep the size
+        frame.setSourceAddress(QKnxAddress::createIndividual(2, 2, 20));
+        frame.setDestinationAddress(QKnxAddress::createGroup(4, 5, 6));
+        QCOMPARE(frame.bytes(), QByteArray::fromHex("110407021020bce022142506010081"));
+
+        frame.setTpdu(QKnxTpduFactory::Multicast::createGroupValueWriteTpdu(
+            QVector<quint8>({ 0x01, 0x02 })));
+        QCOMPARE(frame.bytes(), QByteArray::fromHex("110407021020bce0221425060300800102"));
+        QCOMPARE(frame.tpdu().bytes(), QVector<quint8>({ 0x00, 0x80, 0x01, 0x02 }));
+
+        // copies keep the medium type
+        const QKnxLinkLayerFrame copy(frame);
+        QCOMPARE(copy.mediumType(), QKnx::MediumType::NetIP);
+        QCOMPARE(copy.bytes(), frame.bytes());
+
+        // truncated frames do not read past their end
+        const auto truncated = QKnxLinkLayerFrame::fromBytes(QByteArray::fromHex("1100bce011"), 0, 5);
+        QCOMPARE(truncated.sourceAddress().isValid(), false);
+        QCOMPARE(truncated.destinationAddress().isValid(), false);
+        QCOMPARE(truncated.tpdu().isValid(), false);
+    }
+
+    void testFrameView()
+    {
+        QKnxLinkLayerFrame frame(QKnx::MediumType::NetIP, QKnxLinkLayerFrame::MessageCode::DataRequest);
+        frame.setControlField(QKnxControlField(0xbc));
+        frame.setExtendedControlField(QKnxExtendedControlField(0xe0));
+        frame.addAdditionalInfo({ QKnxAdditionalInfo::Type::BiBatInformation,
+            QByteArray::fromHex("1020") });
+        frame.setSourceAddress(QKnxAddress::Individual::Unregistered);
+        frame.setDestinationAddress(QKnxAddress::Group::Broadcast);
+        frame.setTpdu(QKnxTpduFactory::Multicast::createGroupValueWriteTpdu(
+            QVector<quint8>({ 0x01, 0x01 })));
+
+        const auto bytes = frame.bytes();
+        QKnxLinkLayerFrameView view(reinterpret_cast<const quint8 *>(bytes.constData()),
+            quint16(bytes.size()));
+
+        QCOMPARE(view.size(), frame.size());
+        QCOMPARE(view.messageCode(), frame.messageCode());
+        QCOMPARE(view.additionalInfosSize(), frame.additionalInfosSize());
+        QCOMPARE(view.controlField().bytes(), frame.controlField().bytes());
+        QCOMPARE(view.extendedControlField().bytes(), frame.extendedControlField().bytes());
+        QCOMPARE(view.sourceAddress(), frame.sourceAddress());
+        QCOMPARE(view.destinationAddress(), frame.destinationAddress());
+        const auto tpdu = frame.tpdu().bytes();
+        QCOMPARE(view.tpduSize(), quint16(tpdu.size()));
+        QVERIFY(std::equal(tpdu.cbegin(), tpdu.cend(), view.tpduData()));
+
+        const auto copy = view.toFrame();
+        QCOMPARE(copy.bytes(), bytes);
+        QCOMPARE(copy.mediumType(), QKnx::MediumType::NetIP);
+
+        QCOMPARE(QKnxLinkLayerFrameView().toFrame().size(), quint16(1));
+        QVERIFY(!QKnxLinkLayerFrameView().tpduData());
+    }
+
+    void testImplicitSharing()
+    {
+        QKnxLinkLayerFrame frame(QKnx::MediumType::NetIP, QKnxLinkLayerFrame::MessageCode::DataRequest);
+        frame.setControlField(QKnxControlField(0xbc));
+        frame.setExtendedControlField(QKnxExtendedControlField(0xe0));
+        frame.setSourceAddress(QKnxAddress::Individual::Unregistered);
+        frame.setDestinationAddress(QKnxAddress::Group::Broadcast);
+        frame.setTpdu(QKnxTpduFactory::Multicast::createGroupValueWriteTpdu(
+            QVector<quint8>({ 0x01, 0x01 })));
+        const auto bytes = frame.bytes();
+
+        // copies share the bytes and keep all fields
+        QKnxLinkLayerFrame copy = frame;
+        QCOMPARE(copy.serviceInformationRef().bytes(), frame.serviceInformationRef().bytes());
+        QCOMPARE(copy.mediumType(), QKnx::MediumType::NetIP);
+        QCOMPARE(copy.messageCode(), QKnxLinkLayerFrame::MessageCode::DataRequest);
+        QCOMPARE(copy.bytes(), bytes);
+
+        // modifying the copy detaches it from the original
+        copy.setDestinationAddress(QKnxAddress::createGroup(1, 2, 3));
+        copy.setMediumType(QKnx::MediumType::Unknown);
+        QVERIFY(copy.serviceInformationRef().bytes() != frame.serviceInformationRef().bytes());
+        QCOMPARE(copy.destinationAddress(), QKnxAddress::createGroup(1, 2, 3));
+        QCOMPARE(frame.destinationAddress(), QKnxAddress::Group::Broadcast);
+        QCOMPARE(frame.mediumType(), QKnx::MediumType::NetIP);
+        QCOMPARE(frame.bytes(), bytes);
+
+        QKnxLinkLayerFrame assigned;
+        assigned = frame;
+        QCOMPARE(assigned.bytes(), bytes);
+        QCOMPARE(assigned.mediumType(), QKnx::MediumType::NetIP);
+
+        QKnxLinkLayerFrame moved = std::move(assigned);
+        QCOMPARE(moved.bytes(), bytes);
+
+        // default constructed frames are empty and independent of each other
+        QKnxLinkLayerFrame a, b;
+        a.setMessageCode(QKnxLinkLayerFrame::MessageCode::DataIndication);
+        QCOMPARE(b.messageCode(), QKnxLinkLayerFrame::MessageCode::Unknown);
+        QCOMPARE(QKnxLinkLayerFrame().size(), quint16(1));
+    }
+
     void testDebugStream()
     {
         struct DebugHandler
@@ -0,0 +1,7 @@
+TARGET = tst_qzipreader
+
+QT = core testlib knx knx-private
+CONFIG += testcase c++11
+
+CONFIG -= app_bundle
+SOURCES += tst_qzipreader.cpp
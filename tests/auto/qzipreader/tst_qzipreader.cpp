@@ -0,0 +1,216 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+#include <QtCore/qbuffer.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qtemporaryfile.h>
+#include <QtKnx/private/qzipreader_p.h>
+#include <QtKnx/private/qzipwriter_p.h>
+#include <QtTest/qtest.h>
+
+Q_DECLARE_METATYPE(QZipWriter::CompressionPolicy)
+
+class tst_QZipReader : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testOpenEntry_data();
+    void testOpenEntry();
+    void testOpenMissingEntry();
+    void testInterleavedEntries();
+    void testFileArchive_data();
+    void testFileArchive();
+
+private:
+    static QByteArray createArchive(const QVector<QPair<QString, QByteArray>> &files,
+        QZipWriter::CompressionPolicy policy);
+    static QByteArray readInChunks(QIODevice *device);
+};
+
+static QByteArray testData(int lines)
+{
+    QByteArray data;
+    for (int i = 0; i < lines; ++i) {
+        data += "<GroupAddress Id=\"P-0001-0_GA-" + QByteArray::number(i) + "\" Address=\""
+            + QByteArray::number((i * 7919) % 65536) + "\"/>\n";
+    }
+    return data;
+}
+
+QByteArray tst_QZipReader::createArchive(const QVector<QPair<QString, QByteArray>> &files,
+    QZipWriter::CompressionPolicy policy)
+{
+    QByteArray archive;
+    QBuffer buffer(&archive);
+    buffer.open(QIODevice::WriteOnly);
+
+    QZipWriter writer(&buffer);
+    writer.setCompressionPolicy(policy);
+    for (const auto &file : files)
+        writer.addFile(file.first, file.second);
+    writer.close();
+
+    return archive;
+}
+
+QByteArray tst_QZipReader::readInChunks(QIODevice *device)
+{
+    // odd sizes to cross the boundaries of the internal chunks
+    const qint64 sizes[] = { 1, 7, 4093, 65537 };
+
+    QByteArray result;
+    QByteArray chunk(65537, Qt::Uninitialized);
+    for (int i = 0;; ++i) {
+        const qint64 read = device->read(chunk.data(), sizes[i % 4]);
+        if (read <= 0)
+            break;
+        result.append(chunk.constData(), int(read));
+    }
+    return result;
+}
+
+void tst_QZipReader::testOpenEntry_data()
+{
+    QTest::addColumn<QZipWriter::CompressionPolicy>("policy");
+    QTest::addColumn<QByteArray>("data");
+
+    QTest::newRow("deflated empty") << QZipWriter::AlwaysCompress << QByteArray();
+    QTest::newRow("deflated small") << QZipWriter::AlwaysCompress << testData(3);
+    QTest::newRow("deflated large") << QZipWriter::AlwaysCompress << testData(50000);
+    QTest::newRow("stored small") << QZipWriter::NeverCompress << testData(3);
+    QTest::newRow("stored large") << QZipWriter::NeverCompress << testData(50000);
+}
+
+void tst_QZipReader::testOpenEntry()
+{
+    QFETCH(QZipWriter::CompressionPolicy, policy);
+    QFETCH(QByteArray, data);
+
+    auto archive = createArchive({ { QStringLiteral("P-0001/0.xml"), data } }, policy);
+    QBuffer buffer(&archive);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QZipReader reader(&buffer);
+    QScopedPointer<QIODevice> entry(reader.openEntry(QStringLiteral("P-0001/0.xml")));
+    QVERIFY(entry);
+    QVERIFY(entry->isOpen());
+    QVERIFY(entry->isSequential());
+    QCOMPARE(entry->bytesAvailable(), qint64(data.size()));
+    QCOMPARE(entry->atEnd(), data.isEmpty());
+
+    QCOMPARE(readInChunks(entry.data()), data);
+    QCOMPARE(entry->atEnd(), true);
+    QCOMPARE(entry->read(1), QByteArray());
+
+    entry.reset(reader.openEntry(QStringLiteral("P-0001/0.xml")));
+    QVERIFY(entry);
+    QCOMPARE(entry->readAll(), reader.fileData(QStringLiteral("P-0001/0.xml")));
+}
+
+void tst_QZipReader::testOpenMissingEntry()
+{
+    auto archive = createArchive({ { QStringLiteral("0.xml"), testData(1) } },
+        QZipWriter::AlwaysCompress);
+    QBuffer buffer(&archive);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QZipReader reader(&buffer);
+    QScopedPointer<QIODevice> entry(reader.openEntry(QStringLiteral("project.xml")));
+    QVERIFY(!entry);
+}
+
+void tst_QZipReader::testInterleavedEntries()
+{
+    const auto first = testData(20000);
+    const auto second = testData(30000).toUpper();
+
+    auto archive = createArchive({ { QStringLiteral("0.xml"), first },
+        { QStringLiteral("project.xml"), second } }, QZipWriter::AlwaysCompress);
+    QBuffer buffer(&archive);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QZipReader reader(&buffer);
+    QScopedPointer<QIODevice> a(reader.openEntry(QStringLiteral("0.xml")));
+    QScopedPointer<QIODevice> b(reader.openEntry(QStringLiteral("project.xml")));
+    QVERIFY(a && b);
+
+    // both entries share the archive device, reading one must not disturb the other
+    QByteArray resultA, resultB;
+    while (!a->atEnd() || !b->atEnd()) {
+        resultA += a->read(1000);
+        resultB += b->read(1500);
+        QCOMPARE(reader.fileData(QStringLiteral("0.xml")).size(), first.size());
+    }
+    QCOMPARE(resultA, first);
+    QCOMPARE(resultB, second);
+}
+
+void tst_QZipReader::testFileArchive_data()
+{
+    QTest::addColumn<QZipWriter::CompressionPolicy>("policy");
+
+    QTest::newRow("deflated") << QZipWriter::AlwaysCompress;
+    QTest::newRow("stored") << QZipWriter::NeverCompress;
+}
+
+void tst_QZipReader::testFileArchive()
+{
+    QFETCH(QZipWriter::CompressionPolicy, policy);
+
+    const auto first = testData(40000);
+    const auto second = testData(100).toUpper();
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.write(createArchive({ { QStringLiteral("P-0001/0.xml"), first },
+        { QStringLiteral("P-0001/project.xml"), second },
+        { QStringLiteral("P-0001/0.xml"), QByteArray("duplicate") } }, policy));
+    file.close();
+
+    // the reader opens the file itself, so the archive gets memory mapped
+    QZipReader reader(file.fileName());
+    QCOMPARE(reader.status(), QZipReader::NoError);
+    QCOMPARE(reader.fileNames(), QStringList({ QStringLiteral("P-0001/0.xml"),
+        QStringLiteral("P-0001/project.xml"), QStringLiteral("P-0001/0.xml") }));
+    QCOMPARE(reader.count(), 3);
+
+    QCOMPARE(reader.fileData(QStringLiteral("P-0001/0.xml")), first); // first entry wins
+    QCOMPARE(reader.fileData(QStringLiteral("P-0001/project.xml")), second);
+    QCOMPARE(reader.fileData(QStringLiteral("P-0001/1.xml")), QByteArray());
+
+    QScopedPointer<QIODevice> a(reader.openEntry(QStringLiteral("P-0001/0.xml")));
+    QScopedPointer<QIODevice> b(reader.openEntry(QStringLiteral("P-0001/project.xml")));
+    QVERIFY(a && b);
+    QCOMPARE(a->bytesAvailable(), qint64(first.size()));
+    QCOMPARE(b->readAll(), second);
+    QCOMPARE(readInChunks(a.data()), first);
+}
+
+QTEST_APPLESS_MAIN(tst_QZipReader)
+
+#include "tst_qzipreader.moc"
@@ -0,0 +1,214 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+
+#ifndef QKNXNETIPMOCKSERVER_H
+#define QKNXNETIPMOCKSERVER_H
+
+#include <QtCore/qhash.h>
+#include <QtCore/qvector.h>
+#include <QtKnx/qknxlinklayerframe.h>
+#include <QtKnx/qknxnetipconnectionstaterequest.h>
+#include <QtKnx/qknxnetipconnectionstateresponse.h>
+#include <QtKnx/qknxnetipconnectrequest.h>
+#include <QtKnx/qknxnetipconnectresponse.h>
+#include <QtKnx/qknxnetipcrd.h>
+#include <QtKnx/qknxnetipdisconnectrequest.h>
+#include <QtKnx/qknxnetipdisconnectresponse.h>
+#include <QtKnx/qknxnetipframeheader.h>
+#include <QtKnx/qknxnetiphpai.h>
+#include <QtKnx/qknxnetiptunnelingacknowledge.h>
+#include <QtKnx/qknxnetiptunnelingrequest.h>
+#include <QtKnx/qknxtpdufactory.h>
+#include <QtNetwork/qudpsocket.h>
+
+// Group value write request from 0.0.0 to the given destination, carrying a single byte.
+inline QKnxLinkLayerFrame createFrame(const QKnxAddress &destination, quint8 value,
+    QKnxControlField::Priority priority = QKnxControlField::Priority::Low)
+{
+    QKnxControlField controlField(0xbc);
+    controlField.setPriority(priority);
+
+    QKnxLinkLayerFrame frame(QKnx::MediumType::NetIP,
+        QKnxLinkLayerFrame::MessageCode::DataRequest);
+    frame.setControlField(controlField);
+    frame.setExtendedControlField(QKnxExtendedControlField(0xe0));
+    frame.setSourceAddress(QKnxAddress::createIndividual(0, 0, 0));
+    frame.setDestinationAddress(destination);
+    frame.setTpdu(QKnxTpduFactory::Multicast::createGroupValueWriteTpdu(
+        QVector<quint8>({ value })));
+    return frame;
+}
+
+inline QKnxLinkLayerFrame createFrame(quint8 value,
+    QKnxControlField::Priority priority = QKnxControlField::Priority::Low)
+{
+    return createFrame(QKnxAddress::createGroup(1, 2, 3), value, priority);
+}
+
+// Minimal KNXnet/IP server that hands out a new channel for every connect request, up to the
+// maximum number of channels, and acknowledges all tunneling requests unless told otherwise.
+class MockServer
+{
+public:
+    explicit MockServer(quint8 firstChannelId)
+        : m_nextChannelId(firstChannelId)
+    {
+        m_socket.bind(QHostAddress::LocalHost, 0);
+        QObject::connect(&m_socket, &QUdpSocket::readyRead, [this]() { readDatagrams(); });
+    }
+
+    quint16 port() const { return m_socket.localPort(); }
+    QHostAddress address() const { return m_socket.localAddress(); }
+
+    void setMaximumChannels(int channels) { m_maxChannels = channels; }
+
+    QList<quint8> channels() const { return m_clients.keys(); }
+    QKnxNetIpHpai controlEndpoint(quint8 channelId) const { return m_controls.value(channelId); }
+    QKnxNetIpHpai dataEndpoint(quint8 channelId) const { return m_clients.value(channelId); }
+    QVector<QKnxLinkLayerFrame> frames(quint8 channelId) const { return m_frames.value(channelId); }
+    QVector<quint8> sequenceCounts(quint8 channelId) const { return m_sequences.value(channelId); }
+    int acknowledgeCount() const { return m_acknowledges; }
+    int disconnectRequestCount() const { return m_disconnectRequests; }
+
+    // do not acknowledge the next count tunneling requests, a negative count never acknowledges
+    void dropAcknowledges(int count) { m_dropAcknowledges = count; }
+
+    // do not answer connection state requests, as if the server was gone
+    void ignoreConnectionStateRequests(bool ignore) { m_ignoreStateRequests = ignore; }
+
+    static QKnxAddress individualAddress(quint8 channelId)
+    {
+        return QKnxAddress::createIndividual(1, 1, channelId);
+    }
+
+    void sendTunnelFrame(quint8 channelId, const QKnxLinkLayerFrame &frame)
+    {
+        const auto client = m_clients.value(channelId);
+        m_socket.writeDatagram(QKnxNetIpTunnelingRequest(channelId, m_sendCount[channelId]++,
+            frame).bytes(), client.address(), client.port());
+    }
+
+    void sendDatagram(quint8 channelId, const QByteArray &bytes)
+    {
+        const auto client = m_clients.value(channelId);
+        m_socket.writeDatagram(bytes, client.address(), client.port());
+    }
+
+    void sendDisconnectRequest(quint8 channelId)
+    {
+        const auto control = m_controls.value(channelId);
+        m_socket.writeDatagram(QKnxNetIpDisconnectRequest(channelId, { address(), port() })
+            .bytes(), control.address(), control.port());
+        m_clients.remove(channelId);
+    }
+
+private:
+    void readDatagrams()
+    {
+        while (m_socket.hasPendingDatagrams()) {
+            QHostAddress sender;
+            quint16 senderPort = 0;
+            QByteArray data(int(m_socket.pendingDatagramSize()), Qt::Uninitialized);
+            m_socket.readDatagram(data.data(), data.size(), &sender, &senderPort);
+
+            switch (QKnxNetIpFrameHeader::fromBytes(data, 0).code()) {
+            case QKnxNetIp::ServiceType::ConnectRequest: {
+                if (m_clients.size() >= m_maxChannels) {
+                    reply(QKnxNetIpConnectResponse(QKnxNetIp::Error::NoMoreUniqueConnections)
+                        .bytes(), sender, senderPort);
+                    break;
+                }
+
+                // a NAT aware client sends 0.0.0.0:0, answer to where the request came from
+                auto dataEndpoint = QKnxNetIpConnectRequest::fromBytes(data, 0).dataEndpoint();
+                if (dataEndpoint.address() == QHostAddress::AnyIPv4 || dataEndpoint.port() == 0)
+                    dataEndpoint = { sender, senderPort };
+
+                const quint8 channelId = m_nextChannelId++;
+                m_clients.insert(channelId, dataEndpoint);
+                m_controls.insert(channelId, { sender, senderPort });
+                reply(QKnxNetIpConnectResponse(channelId, QKnxNetIp::Error::None,
+                    { address(), port() }, QKnxNetIpCrd(individualAddress(channelId))).bytes(),
+                    sender, senderPort);
+            }   break;
+            case QKnxNetIp::ServiceType::ConnectionStateRequest: {
+                if (m_ignoreStateRequests)
+                    break;
+                auto request = QKnxNetIpConnectionStateRequest::fromBytes(data, 0);
+                reply(QKnxNetIpConnectionStateResponse(request.channelId(),
+                    QKnxNetIp::Error::None).bytes(), sender, senderPort);
+            }   break;
+            case QKnxNetIp::ServiceType::DisconnectRequest: {
+                auto request = QKnxNetIpDisconnectRequest::fromBytes(data, 0);
+                m_disconnectRequests++;
+                m_clients.remove(request.channelId());
+                reply(QKnxNetIpDisconnectResponse(request.channelId(),
+                    QKnxNetIp::Error::None).bytes(), sender, senderPort);
+            }   break;
+            case QKnxNetIp::ServiceType::TunnelingRequest: {
+                auto request = QKnxNetIpTunnelingRequest::fromBytes(data, 0);
+                m_frames[request.channelId()].append(request.cemi());
+                m_sequences[request.channelId()].append(request.sequenceCount());
+                if (m_dropAcknowledges != 0) {
+                    if (m_dropAcknowledges > 0)
+                        m_dropAcknowledges--;
+                    break;
+                }
+                reply(QKnxNetIpTunnelingAcknowledge(request.channelId(), request.sequenceCount(),
+                    QKnxNetIp::Error::None).bytes(), sender, senderPort);
+            }   break;
+            case QKnxNetIp::ServiceType::TunnelingAcknowledge:
+                m_acknowledges++;
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    void reply(const QByteArray &bytes, const QHostAddress &address, quint16 port)
+    {
+        m_socket.writeDatagram(bytes, address, port);
+    }
+
+private:
+    QUdpSocket m_socket;
+    quint8 m_nextChannelId;
+    int m_maxChannels { 255 };
+    QHash<quint8, QKnxNetIpHpai> m_clients;
+    QHash<quint8, QKnxNetIpHpai> m_controls;
+    QHash<quint8, quint8> m_sendCount;
+    QHash<quint8, QVector<QKnxLinkLayerFrame>> m_frames;
+    QHash<quint8, QVector<quint8>> m_sequences;
+    int m_acknowledges { 0 };
+    int m_disconnectRequests { 0 };
+    int m_dropAcknowledges { 0 };
+    bool m_ignoreStateRequests { false };
+};
+
+#endif
@@ -0,0 +1,4 @@
+TEMPLATE = subdirs
+SUBDIRS += qknx2bytefloat \
+    qknxaddress \
+    qknxtpdu
@@ -0,0 +1,168 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+#include <QtCore/qmath.h>
+#include <QtCore/qvector.h>
+#include <QtKnx/qknx2bytefloat.h>
+#include <QtKnx/qknxdatapointtypecodec.h>
+#include <QtTest/qtest.h>
+
+// The qPow based conversion QKnx2ByteFloat used before, kept to compare against.
+static float referenceDecode(quint16 raw)
+{
+    quint16 encodedM = (raw & 0x87ff);
+    if (encodedM > 2047)
+        encodedM += 0x7800;
+    return float(0.01 * qint16(encodedM) * qPow(2, qreal((raw & 0x7800) >> 11)));
+}
+
+static quint16 referenceEncode(float value)
+{
+    quint8 E = 0;
+    if (qAbs(qreal(value)) > 20.48)
+        E = quint8(qFloor(qLn(qAbs(qreal(value) * 100 / 2048.)) / qLn(2) + 1));
+    quint16 encodedM = quint16(qint32(qRound((value * float(qPow(2, -E)) * 100))));
+    if (value < 0)
+        encodedM &= 0x87ff;
+    return encodedM | quint16(E << 11);
+}
+
+class tst_bench_QKnx2ByteFloat : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void decode();
+    void decodeScalar();
+    void decodeDatapointType();
+    void decodeReference();
+
+    void encode();
+    void encodeScalar();
+    void encodeDatapointType();
+    void encodeReference();
+
+private:
+    // every encoding except 0x7fff, which is reserved for invalid data
+    QVector<quint8> m_raw;
+    QVector<float> m_values;
+};
+
+void tst_bench_QKnx2ByteFloat::initTestCase()
+{
+    m_raw.resize(2 * 0x7fff);
+    for (int i = 0; i < 0x7fff; ++i) {
+        // spread over the whole range, both signs and all exponents
+        const int raw = (i * 0x9e37) & 0xffff;
+        m_raw[2 * i] = quint8((raw == 0x7fff ? 0 : raw) >> 8);
+        m_raw[2 * i + 1] = quint8(raw == 0x7fff ? 0 : raw);
+    }
+    m_values.resize(m_raw.size() / 2);
+    QKnxDatapointTypeCodec::Dpt9::decode(m_raw.constData(), m_values.size(), m_values.data());
+}
+
+void tst_bench_QKnx2ByteFloat::decode()
+{
+    QVector<float> values(m_values.size());
+    QBENCHMARK {
+        QKnxDatapointTypeCodec::Dpt9::decode(m_raw.constData(), values.size(), values.data());
+    }
+    QCOMPARE(values, m_values);
+}
+
+void tst_bench_QKnx2ByteFloat::decodeScalar()
+{
+    QVector<float> values(m_values.size());
+    QBENCHMARK {
+        for (int i = 0; i < values.size(); ++i)
+            QKnxDatapointTypeCodec::Dpt9::decode(m_raw.constData() + 2 * i, 1, values.data() + i);
+    }
+    QCOMPARE(values, m_values);
+}
+
+void tst_bench_QKnx2ByteFloat::decodeDatapointType()
+{
+    QKnx2ByteFloat dpt;
+    float sum = 0;
+    QBENCHMARK {
+        for (int i = 0; i < m_values.size(); ++i) {
+            dpt.setBytes(m_raw.mid(2 * i, 2), 0, 2);
+            sum += dpt.value();
+        }
+    }
+    QVERIFY(sum == sum);
+}
+
+void tst_bench_QKnx2ByteFloat::decodeReference()
+{
+    QVector<float> values(m_values.size());
+    QBENCHMARK {
+        for (int i = 0; i < values.size(); ++i)
+            values[i] = referenceDecode(quint16(m_raw[2 * i] << 8 | m_raw[2 * i + 1]));
+    }
+}
+
+void tst_bench_QKnx2ByteFloat::encode()
+{
+    QVector<quint8> raw(m_raw.size());
+    QBENCHMARK {
+        QKnxDatapointTypeCodec::Dpt9::encode(m_values.constData(), m_values.size(), raw.data());
+    }
+}
+
+void tst_bench_QKnx2ByteFloat::encodeScalar()
+{
+    QVector<quint8> raw(m_raw.size());
+    QBENCHMARK {
+        for (int i = 0; i < m_values.size(); ++i)
+            QKnxDatapointTypeCodec::Dpt9::encode(m_values.constData() + i, 1, raw.data() + 2 * i);
+    }
+}
+
+void tst_bench_QKnx2ByteFloat::encodeDatapointType()
+{
+    QKnx2ByteFloat dpt;
+    QBENCHMARK {
+        for (float value : qAsConst(m_values))
+            dpt.setValue(value);
+    }
+}
+
+void tst_bench_QKnx2ByteFloat::encodeReference()
+{
+    QVector<quint16> raw(m_values.size());
+    QBENCHMARK {
+        for (int i = 0; i < m_values.size(); ++i)
+            raw[i] = referenceEncode(m_values[i]);
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_bench_QKnx2ByteFloat)
+
+#include "tst_bench_qknx2bytefloat.moc"
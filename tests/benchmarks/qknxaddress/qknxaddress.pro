@@ -0,0 +1,7 @@
+TARGET = tst_bench_qknxaddress
+
+QT = core testlib knx
+CONFIG += release c++11
+
+CONFIG -= app_bundle
+SOURCES += tst_bench_qknxaddress.cpp
@@ -0,0 +1,235 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+#include <QtCore/qvector.h>
+#include <QtKnx/qknxaddress.h>
+#include <QtKnx/qknxutils.h>
+#include <QtTest/qtest.h>
+
+Q_DECLARE_METATYPE(QKnxAddress::Type)
+Q_DECLARE_METATYPE(QKnxAddress::Notation)
+
+// The splitRef() based parser QKnxAddress used before, kept to compare against.
+static QKnxAddress referenceParse(QKnxAddress::Type type, const QString &address)
+{
+    const bool dots = address.contains(QLatin1Char('.'));
+    const bool slashes = address.contains(QLatin1Char('/'));
+    if (dots && slashes)
+        return {};
+
+    QVector<quint16> sections;
+    for (const QStringRef &section : address.splitRef(dots ? QLatin1Char('.') : QLatin1Char('/'))) {
+        bool ok = false;
+        sections.append(section.toUShort(&ok, 0));
+        if (!ok)
+            return {};
+    }
+    if (sections.size() == 1)
+        return { type, sections[0] };
+    if (slashes && type == QKnxAddress::Type::Group && sections.size() == 2)
+        return QKnxAddress::createGroup(quint8(sections[0]), sections[1]);
+    if (slashes && type == QKnxAddress::Type::Group && sections.size() == 3)
+        return QKnxAddress::createGroup(quint8(sections[0]), sections[1], quint8(sections[2]));
+    if (dots && type == QKnxAddress::Type::Individual && sections.size() == 3)
+        return QKnxAddress::createIndividual(quint8(sections[0]), sections[1], quint8(sections[2]));
+    return {};
+}
+
+// The arg() based formatting QKnxAddress used before, kept to compare against.
+static QString referenceFormat(const QKnxAddress &address, QKnxAddress::Notation notation)
+{
+    const int value = QKnxUtils::QUint16::fromBytes(address.bytes());
+    if (notation == QKnxAddress::Notation::ThreeLevel) {
+        if (address.type() == QKnxAddress::Type::Group) {
+            return QStringLiteral("%1/%2/%3").arg((value >> 11) & 0x1f).arg((value >> 8) & 0x07)
+                .arg(value & 0xff);
+        }
+        return QStringLiteral("%1.%2.%3").arg(value >> 12).arg((value >> 8) & 0x0f)
+            .arg(value & 0xff);
+    }
+    return QStringLiteral("%1/%2").arg((value >> 11) & 0x1f).arg(value & 0x07ff);
+}
+
+class tst_bench_QKnxAddress : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void parse_data();
+    void parse();
+    void parseLatin1_data() { parse_data(); }
+    void parseLatin1();
+    void parseReference_data() { parse_data(); }
+    void parseReference();
+
+    void toString_data() { parse_data(); }
+    void toString();
+    void appendTo_data() { parse_data(); }
+    void appendTo();
+    void formatReference_data() { parse_data(); }
+    void formatReference();
+
+private:
+    static QVector<QKnxAddress> addresses(QKnxAddress::Type type);
+    static QStringList strings(const QVector<QKnxAddress> &addresses,
+        QKnxAddress::Notation notation);
+};
+
+QVector<QKnxAddress> tst_bench_QKnxAddress::addresses(QKnxAddress::Type type)
+{
+    QVector<QKnxAddress> addresses;
+    addresses.reserve(0x10000);
+    for (int i = 0; i <= 0xffff; ++i)
+        addresses.append({ type, quint16(i) });
+    return addresses;
+}
+
+QStringList tst_bench_QKnxAddress::strings(const QVector<QKnxAddress> &addresses,
+    QKnxAddress::Notation notation)
+{
+    QStringList strings;
+    strings.reserve(addresses.size());
+    for (const QKnxAddress &address : addresses)
+        strings.append(address.toString(notation));
+    return strings;
+}
+
+void tst_bench_QKnxAddress::parse_data()
+{
+    QTest::addColumn<QKnxAddress::Type>("type");
+    QTest::addColumn<QKnxAddress::Notation>("notation");
+
+    QTest::newRow("Group, 2-level") << QKnxAddress::Type::Group
+        << QKnxAddress::Notation::TwoLevel;
+    QTest::newRow("Group, 3-level") << QKnxAddress::Type::Group
+        << QKnxAddress::Notation::ThreeLevel;
+    QTest::newRow("Individual, 3-level") << QKnxAddress::Type::Individual
+        << QKnxAddress::Notation::ThreeLevel;
+}
+
+void tst_bench_QKnxAddress::parse()
+{
+    QFETCH(QKnxAddress::Type, type);
+    QFETCH(QKnxAddress::Notation, notation);
+
+    const auto expected = addresses(type);
+    const auto input = strings(expected, notation);
+
+    QVector<QKnxAddress> result(input.size());
+    QBENCHMARK {
+        for (int i = 0; i < input.size(); ++i)
+            result[i] = QKnxAddress(type, QStringView(input.at(i)));
+    }
+    QCOMPARE(result, expected);
+}
+
+void tst_bench_QKnxAddress::parseLatin1()
+{
+    QFETCH(QKnxAddress::Type, type);
+    QFETCH(QKnxAddress::Notation, notation);
+
+    const auto expected = addresses(type);
+    QVector<QByteArray> input;
+    input.reserve(expected.size());
+    for (const QString &string : strings(expected, notation))
+        input.append(string.toLatin1());
+
+    QVector<QKnxAddress> result(input.size());
+    QBENCHMARK {
+        for (int i = 0; i < input.size(); ++i)
+            result[i] = QKnxAddress(type, QLatin1String(input.at(i)));
+    }
+    QCOMPARE(result, expected);
+}
+
+void tst_bench_QKnxAddress::parseReference()
+{
+    QFETCH(QKnxAddress::Type, type);
+    QFETCH(QKnxAddress::Notation, notation);
+
+    const auto expected = addresses(type);
+    const auto input = strings(expected, notation);
+
+    QVector<QKnxAddress> result(input.size());
+    QBENCHMARK {
+        for (int i = 0; i < input.size(); ++i)
+            result[i] = referenceParse(type, input.at(i));
+    }
+    QCOMPARE(result, expected);
+}
+
+void tst_bench_QKnxAddress::toString()
+{
+    QFETCH(QKnxAddress::Type, type);
+    QFETCH(QKnxAddress::Notation, notation);
+
+    const auto input = addresses(type);
+    QStringList result;
+    QBENCHMARK {
+        result.clear();
+        for (const QKnxAddress &address : input)
+            result.append(address.toString(notation));
+    }
+    QCOMPARE(result.size(), input.size());
+}
+
+void tst_bench_QKnxAddress::appendTo()
+{
+    QFETCH(QKnxAddress::Type, type);
+    QFETCH(QKnxAddress::Notation, notation);
+
+    const auto input = addresses(type);
+    QString result;
+    result.reserve(input.size() * 10);
+    QBENCHMARK {
+        result.resize(0); // keeps the reserved capacity, unlike clear()
+        for (const QKnxAddress &address : input) {
+            address.appendTo(result, notation);
+            result.append(QLatin1Char('\n'));
+        }
+    }
+    QCOMPARE(result.count(QLatin1Char('\n')), input.size());
+}
+
+void tst_bench_QKnxAddress::formatReference()
+{
+    QFETCH(QKnxAddress::Type, type);
+    QFETCH(QKnxAddress::Notation, notation);
+
+    const auto input = addresses(type);
+    QStringList result;
+    QBENCHMARK {
+        result.clear();
+        for (const QKnxAddress &address : input)
+            result.append(referenceFormat(address, notation));
+    }
+    QCOMPARE(result, strings(input, notation));
+}
+
+QTEST_APPLESS_MAIN(tst_bench_QKnxAddress)
+
+#include "tst_bench_qknxaddress.moc"
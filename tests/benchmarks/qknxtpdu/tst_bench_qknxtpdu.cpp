@@ -0,0 +1,129 @@
+/******************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtKnx module.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+******************************************************************************/
+#include <QtKnx/qknxtpdu.h>
+#include <QtKnx/qknxutils.h>
+#include <QtTest/qtest.h>
+
+#include <bitset>
+
+Q_DECLARE_METATYPE(QVector<quint8>)
+
+// The bitset based decoding QKnxTpdu used before it switched to lookup tables, kept to compare
+// against.
+static void referenceDecode(const QVector<quint8> &bytes, qint16 *tpci, qint32 *apci)
+{
+    const auto isBitSet = [](quint8 byteToTest, quint8 bit) {
+        return (byteToTest & (quint8(1) << bit)) != 0;
+    };
+
+    if (isBitSet(bytes[0], 7) && isBitSet(bytes[0], 6) && isBitSet(bytes[0], 1))
+        *tpci = qint16(bytes[0] & 0xc3);
+    else if (isBitSet(bytes[0], 7) && (!isBitSet(bytes[0], 6)))
+        *tpci = qint16(bytes[0]);
+    else if (isBitSet(bytes[0], 6) && (!isBitSet(bytes[0], 7)))
+        *tpci = qint16((bytes[0] & 0xfc) & 0xc3);
+    else
+        *tpci = qint16(bytes[0] & 0xfc);
+
+    std::bitset<8> apciHigh = bytes[0] & 0x03;
+    std::bitset<8> apciLow = bytes[1] & 0xc0;
+
+    const auto fourBitsApci = [&apciHigh, &apciLow]() {
+        QVector<quint8> apciBytes = { { quint8(apciHigh.to_ulong()), quint8(apciLow.to_ulong()) } };
+        return (QKnxUtils::QUint16::fromBytes(apciBytes));
+    };
+    const auto tenBitsApci = [apciHigh](quint8 octet7) {
+        QVector<quint8> apciBytes = { { quint8(apciHigh.to_ulong()), octet7 } };
+        return (QKnxUtils::QUint16::fromBytes(apciBytes));
+    };
+    if ((apciHigh[0] == 0 && apciHigh[1] == 0) || (apciHigh[0] == 1 && apciHigh[1] == 1)) {
+        std::bitset<8> octet7 = bytes[1];
+        if (octet7[7] == 1 && octet7[6] == 1)
+            *apci = qint32(tenBitsApci(bytes[1]));
+        else
+            *apci = qint32(fourBitsApci());
+    } else if (apciHigh[1] == 0 && apciHigh[0] == 1) {
+        *apci = qint32(*tpci > 0 ? fourBitsApci() : tenBitsApci(bytes[1]));
+    } else if (apciLow[7] == 0 || apciLow[6] == 0) {
+        *apci = qint32(fourBitsApci());
+    } else {
+        *apci = qint32(bytes[1]);
+    }
+}
+
+class tst_bench_QKnxTpdu : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void decode_data();
+    void decode();
+
+    void referenceDecode_data() { decode_data(); }
+    void referenceDecode();
+};
+
+void tst_bench_QKnxTpdu::decode_data()
+{
+    QTest::addColumn<QVector<quint8>>("bytes");
+
+    QTest::newRow("GroupValueWrite (6 bit)") << QVector<quint8>({ 0x00, 0x81 });
+    QTest::newRow("GroupValueWrite (2 byte)") << QVector<quint8>({ 0x00, 0x80, 0x0c, 0x1a });
+    QTest::newRow("GroupValueResponse") << QVector<quint8>({ 0x00, 0x40, 0x41, 0x20, 0x00, 0x00 });
+    QTest::newRow("PropertyValueRead") << QVector<quint8>({ 0x42, 0xd5, 0x00, 0x0b, 0x10, 0x01 });
+}
+
+void tst_bench_QKnxTpdu::decode()
+{
+    QFETCH(QVector<quint8>, bytes);
+
+    int sum = 0;
+    QBENCHMARK {
+        auto tpdu = QKnxTpdu::fromBytes(bytes, 0, quint8(bytes.size()));
+        sum += int(tpdu.transportControlField()) + int(tpdu.applicationControlField());
+    }
+    QVERIFY(sum != 0 || bytes[1] == 0);
+}
+
+void tst_bench_QKnxTpdu::referenceDecode()
+{
+    QFETCH(QVector<quint8>, bytes);
+
+    int sum = 0;
+    QBENCHMARK {
+        qint16 tpci = -1;
+        qint32 apci = -1;
+        ::referenceDecode(bytes, &tpci, &apci);
+        sum += tpci + apci;
+    }
+    QVERIFY(sum != 0 || bytes[1] == 0);
+}
+
+QTEST_APPLESS_MAIN(tst_bench_QKnxTpdu)
+
+#include "tst_bench_qknxtpdu.moc"